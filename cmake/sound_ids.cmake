@@ -0,0 +1,67 @@
+# soundcoe_generate_sound_ids(<output header>
+#                             DIRECTORIES <dir>...
+#                             [NAMESPACE <namespace>])
+#
+# Writes a header with one soundcoe::SoundId constant per audio file found under the given directories
+# (typically the {soundSubdir} folders of your scenes). Names are relative to their directory, '/' separated,
+# exactly what playSound() takes, and the ids are hashed at compile time with soundcoe::makeSoundId().
+# The header also defines registerAll(), to be called once after soundcoe::initialize().
+function(soundcoe_generate_sound_ids output_header)
+    cmake_parse_arguments(SOUND_IDS "" "NAMESPACE" "DIRECTORIES" ${ARGN})
+    if(NOT SOUND_IDS_DIRECTORIES)
+        message(FATAL_ERROR "soundcoe_generate_sound_ids: DIRECTORIES is required")
+    endif()
+    if(NOT SOUND_IDS_NAMESPACE)
+        set(SOUND_IDS_NAMESPACE "sound_ids")
+    endif()
+
+    set(names "")
+    foreach(directory ${SOUND_IDS_DIRECTORIES})
+        get_filename_component(directory "${directory}" ABSOLUTE)
+        file(GLOB_RECURSE files CONFIGURE_DEPENDS RELATIVE "${directory}"
+             "${directory}/*.wav" "${directory}/*.ogg" "${directory}/*.mp3")
+        list(APPEND names ${files})
+    endforeach()
+    list(REMOVE_DUPLICATES names)
+    list(SORT names)
+
+    set(constants "")
+    set(entries "")
+    set(identifiers "")
+    foreach(name ${names})
+        string(MAKE_C_IDENTIFIER "${name}" identifier)
+        string(TOUPPER "${identifier}" identifier)
+        if(identifier MATCHES "^_")
+            set(identifier "SOUND${identifier}") # Names starting with a digit
+        endif()
+        if(identifier IN_LIST identifiers)
+            message(WARNING "soundcoe_generate_sound_ids: Skipping \"${name}\", ${identifier} is already defined")
+            continue()
+        endif()
+        list(APPEND identifiers ${identifier})
+        string(APPEND constants "    inline constexpr soundcoe::SoundId ${identifier} = soundcoe::makeSoundId(\"${name}\");\n")
+        string(APPEND entries "        \"${name}\",\n")
+    endforeach()
+
+    set(content "// Generated by soundcoe_generate_sound_ids(), do not edit\n#pragma once\n\n#include <soundcoe.hpp>\n\n")
+    string(APPEND content "namespace ${SOUND_IDS_NAMESPACE}\n{\n${constants}\n")
+    if(entries)
+        string(APPEND content "    inline constexpr const char *NAMES[] = {\n${entries}    };\n\n")
+        string(APPEND content "    inline bool registerAll()\n    {\n        bool registered = true;\n")
+        string(APPEND content "        for (const char *name : NAMES)\n")
+        string(APPEND content "            registered = soundcoe::registerSound(name).isValid() && registered;\n")
+        string(APPEND content "        return registered;\n    }\n")
+    else()
+        message(WARNING "soundcoe_generate_sound_ids: No audio files found for ${output_header}")
+        string(APPEND content "    inline bool registerAll() { return true; }\n")
+    endif()
+    string(APPEND content "} // namespace ${SOUND_IDS_NAMESPACE}\n")
+
+    # Rewriting an unchanged header would rebuild everything that includes it
+    if(EXISTS "${output_header}")
+        file(READ "${output_header}" existing)
+    endif()
+    if(NOT "${existing}" STREQUAL "${content}")
+        file(WRITE "${output_header}" "${content}")
+    endif()
+endfunction()
\ No newline at end of file
@@ -3,5 +3,6 @@
 
 include(${CMAKE_CURRENT_LIST_DIR}/utils.cmake)
 include(${CMAKE_CURRENT_LIST_DIR}/openal_config.cmake)
+include(${CMAKE_CURRENT_LIST_DIR}/sound_ids.cmake)
 
 # Future modules can be added here
\ No newline at end of file
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <soundcoe/utils/math.hpp>
+#include <soundcoe/resources/preload_ticket.hpp>
 #include <string>
+#include <vector>
+#include <utility>
 
 namespace soundcoe
 {
@@ -88,6 +91,27 @@ namespace soundcoe
      */
     bool preloadScene(const std::string &sceneName);
 
+    /**
+     * @brief Preloads a scene directory in the background.
+     * 
+     * Files are decoded on worker threads while gameplay audio keeps playing. The decoded audio is
+     * uploaded to OpenAL by update(), so the ticket only makes progress while update() is being called.
+     * Calling unloadScene() before it finishes cancels the preload. Files that cannot be decoded
+     * (including non-audio files in the directory) are counted in the ticket's failed files.
+     * 
+     * @param sceneName Name of the scene directory to preload.
+     * @return Ticket to poll for progress (files and bytes done) and completion. If the scene is already
+     *         loading, the ticket of that load is returned.
+     * 
+     * @example
+     * soundcoe::PreloadTicket ticket = soundcoe::preloadSceneAsync("level2");
+     * while (!ticket.isDone()) {
+     *     soundcoe::update();
+     *     drawLoadingBar(ticket.getProgress());
+     * }
+     */
+    PreloadTicket preloadSceneAsync(const std::string &sceneName);
+
     /**
      * @brief Unloads a previously loaded scene and frees its audio resources.
      * 
@@ -104,6 +128,302 @@ namespace soundcoe
      */
     bool isSceneLoaded(const std::string &sceneName);
 
+    /**
+     * @brief Sets the default policy deciding which audio files are streamed instead of fully decoded.
+     * 
+     * A streamed file keeps only its decoder state in the cache and is decoded chunk by chunk while playing,
+     * so long music tracks do not consume the buffer cache budget. The policy applies to files loaded after
+     * this call, so set it before initialize() to cover the "general" directory.
+     * 
+     * @param policy Size and duration thresholds, see StreamingPolicy. Default streams files of 2MB and more.
+     * @return true if successfully set, false on error.
+     * 
+     * @example
+     * // Stream every track longer than 30 seconds
+     * soundcoe::setStreamingPolicy(soundcoe::StreamingPolicy::byDuration(30.0f));
+     */
+    bool setStreamingPolicy(const StreamingPolicy &policy);
+
+    /**
+     * @brief Overrides the streaming policy for files inside a given subdirectory.
+     * 
+     * The subdirectory is matched against the file's path relative to the audio root, wherever it appears:
+     * "music" covers both general/music/ and scene1/music/, while "scene1/music" covers only the latter.
+     * When several overrides match, the most specific one wins.
+     * 
+     * @param subdirectory Subdirectory the override applies to (e.g. the musicSubdir passed to initialize()).
+     * @param policy Size and duration thresholds for files in that subdirectory.
+     * @return true if successfully set, false if the subdirectory is empty.
+     * 
+     * @example
+     * // Always stream music, never stream sound effects
+     * soundcoe::setStreamingPolicy("music", soundcoe::StreamingPolicy::always());
+     * soundcoe::setStreamingPolicy("sfx", soundcoe::StreamingPolicy::never());
+     */
+    bool setStreamingPolicy(const std::string &subdirectory, const StreamingPolicy &policy);
+
+    /**
+     * @brief Gets the streaming policy of a subdirectory, or the default policy if it has no override.
+     * 
+     * @param subdirectory Subdirectory to query. Default is "" for the default policy.
+     * @return The streaming policy in effect for that subdirectory.
+     */
+    StreamingPolicy getStreamingPolicy(const std::string &subdirectory = "");
+
+    /**
+     * @brief Sets whether stereo files are downmixed to mono when they are loaded.
+     * 
+     * OpenAL only spatializes mono buffers, so stereo files played with playSound3D() ignore their position.
+     * Downmixing averages both channels at load time, which makes them positional and halves their cache
+     * memory. Streamed files are not affected. Applies to files loaded after this call.
+     * 
+     * @param enabled true to downmix stereo files. Default is false.
+     * @return true if successfully set, false on error.
+     */
+    bool setMonoDownmix(bool enabled);
+
+    /**
+     * @brief Overrides the mono downmix setting for files inside a given subdirectory.
+     * 
+     * The subdirectory is matched the same way as setStreamingPolicy(), the most specific override wins.
+     * 
+     * @param subdirectory Subdirectory the override applies to (e.g. the soundSubdir passed to initialize()).
+     * @param enabled true to downmix stereo files in that subdirectory, false to keep them stereo.
+     * @return true if successfully set, false if the subdirectory is empty.
+     * 
+     * @example
+     * // Positional sound effects, stereo music
+     * soundcoe::setMonoDownmix("sfx", true);
+     */
+    bool setMonoDownmix(const std::string &subdirectory, bool enabled);
+
+    /**
+     * @brief Gets the mono downmix setting of a subdirectory, or the default setting if it has no override.
+     * 
+     * @param subdirectory Subdirectory to query. Default is "" for the default setting.
+     * @return true if stereo files in that subdirectory are downmixed.
+     */
+    bool isMonoDownmixEnabled(const std::string &subdirectory = "");
+
+    /**
+     * @brief Sets whether audio files are resampled to the output device rate when they are loaded.
+     * 
+     * OpenAL resamples every playing voice whose buffer rate differs from the device rate, on every mix.
+     * Resampling once at load time with a high quality polyphase filter removes that per-voice cost, which
+     * adds up with many simultaneous voices. Loading gets slower, streamed files are not affected.
+     * Applies to files loaded after this call.
+     * 
+     * @param enabled true to resample loaded files. Default is false.
+     * @return true if successfully set, false on error.
+     */
+    bool setResampleOnLoad(bool enabled);
+
+    /**
+     * @brief Gets whether audio files are resampled to the output device rate when they are loaded.
+     * 
+     * @return true if load-time resampling is enabled.
+     */
+    bool isResampleOnLoadEnabled();
+
+    /**
+     * @brief Sets how resident (not streamed) buffers are stored once loaded.
+     * 
+     * BufferCompression::Ima4 and BufferCompression::MsAdpcm encode 16-bit files to 4-bit ADPCM at load time,
+     * so about 4x more sounds fit in the same cache budget at a small quality cost (MS-ADPCM sounds better,
+     * IMA4 is more widely supported). Files stay PCM when the device lacks AL_EXT_IMA4 / AL_SOFT_MSADPCM.
+     * Applies to files loaded after this call.
+     * 
+     * @param compression Encoding of resident buffers. Default is BufferCompression::None.
+     * @return true if successfully set, false on error.
+     */
+    bool setBufferCompression(BufferCompression compression);
+
+    /**
+     * @brief Overrides the buffer compression for files inside a given subdirectory.
+     * 
+     * The subdirectory is matched the same way as setStreamingPolicy(), the most specific override wins.
+     * 
+     * @param subdirectory Subdirectory the override applies to (e.g. the soundSubdir passed to initialize()).
+     * @param compression Encoding of resident buffers in that subdirectory.
+     * @return true if successfully set, false if the subdirectory is empty.
+     * 
+     * @example
+     * // Compress the many short effects, keep music and dialogue at full quality
+     * soundcoe::setBufferCompression("sfx", soundcoe::BufferCompression::MsAdpcm);
+     */
+    bool setBufferCompression(const std::string &subdirectory, BufferCompression compression);
+
+    /**
+     * @brief Gets the buffer compression of a subdirectory, or the default setting if it has no override.
+     * 
+     * @param subdirectory Subdirectory to query. Default is "" for the default setting.
+     * @return Encoding of resident buffers loaded from that subdirectory.
+     */
+    BufferCompression getBufferCompression(const std::string &subdirectory = "");
+
+    /**
+     * @brief Keeps Ogg/MP3 files compressed in memory and decodes them when they are played.
+     * 
+     * Medium-length sounds that are too long to keep as PCM but too short to stream keep their original
+     * bytes in a separate compressed cache. The first play decodes them from memory, the decoded PCM is kept
+     * in its own budget and the least recently used sounds drop back to their compressed form. WAV files are
+     * not affected. Applies to files loaded after this call.
+     * 
+     * @param enabled true to keep Ogg/MP3 files compressed. Default is false.
+     * @return true if successfully set, false on error.
+     */
+    bool setCompressedCaching(bool enabled);
+
+    /**
+     * @brief Overrides compressed caching for files inside a given subdirectory.
+     * 
+     * The subdirectory is matched the same way as setStreamingPolicy(), the most specific override wins.
+     * 
+     * @param subdirectory Subdirectory the override applies to.
+     * @param enabled true to keep Ogg/MP3 files in that subdirectory compressed.
+     * @return true if successfully set, false if the subdirectory is empty.
+     * 
+     * @example
+     * // Ambience loops are a few seconds long, keep them as Ogg until they play
+     * soundcoe::setCompressedCaching("ambience", true);
+     */
+    bool setCompressedCaching(const std::string &subdirectory, bool enabled);
+
+    /**
+     * @brief Checks whether compressed caching is enabled for a subdirectory, or by default.
+     * 
+     * @param subdirectory Subdirectory to query. Default is "" for the default setting.
+     * @return true if Ogg/MP3 files loaded from that subdirectory stay compressed.
+     */
+    bool isCompressedCachingEnabled(const std::string &subdirectory = "");
+
+    /**
+     * @brief Sets the memory budgets of compressed caching.
+     * 
+     * @param compressedMB Megabytes of Ogg/MP3 bytes kept in memory. Default is 16.
+     * @param decodedMB Megabytes of PCM decoded from them that stays resident. Default is 8.
+     * @return true if successfully set, false on error.
+     */
+    bool setCompressedCacheLimits(size_t compressedMB, size_t decodedMB);
+
+    /**
+     * @brief Sets how many decoded chunks each stream keeps ready ahead of playback.
+     * 
+     * Streams are decoded on a background thread, update() only uploads chunks that are already decoded.
+     * A deeper read-ahead absorbs longer game thread stalls at the cost of memory (64KB per chunk).
+     * Applies to streams started after this call.
+     * 
+     * @param chunks Number of chunks, rounded up to a power of two. Default is 4.
+     * @return true if successfully set, false if chunks is 0.
+     */
+    bool setStreamReadAhead(size_t chunks);
+
+    /**
+     * @brief Gets the read-ahead depth used for new streams.
+     * 
+     * @return Number of decoded chunks kept ahead of playback.
+     */
+    size_t getStreamReadAhead();
+
+    /**
+     * @brief Gets how many times a stream ran out of decoded audio since initialize().
+     * 
+     * Each underrun is an audible gap, a growing count means update() is called too rarely
+     * or the read-ahead is too shallow.
+     * 
+     * @return Number of stream underruns.
+     */
+    size_t getStreamUnderrunCount();
+
+    /**
+     * @brief Sets how many threads decode audio files when preloading scenes.
+     * 
+     * preloadScene() decodes the files of a scene concurrently on these threads plus the calling thread,
+     * then uploads them to OpenAL one by one. preloadSceneAsync() decodes on these threads only.
+     * 
+     * @param threadCount Number of decode threads, 0 uses one per core minus one. 1 decodes on the calling thread.
+     * @return true if successfully set, false while an asynchronous preload is running.
+     */
+    bool setDecodeThreadCount(size_t threadCount);
+
+    /**
+     * @brief Gets the number of threads used to decode audio files when preloading scenes.
+     * 
+     * @return Number of decode threads.
+     */
+    size_t getDecodeThreadCount();
+
+    /**
+     * @brief Sets how many sounds may stay alive as virtual voices.
+     * 
+     * When every source is busy with something at least as important, a new sound, or one whose source is
+     * taken by a higher priority sound, becomes a virtual voice: its handle stays valid and its playback
+     * position, volume and 3D position keep updating without a source. update() moves the most important
+     * and audible virtual voices back onto free sources at the right offset. Streamed files are never virtual.
+     * 
+     * @param count Maximum number of virtual voices, 0 disables them. Default is 1024.
+     * @return true if successfully set.
+     */
+    bool setMaxVirtualVoices(size_t count);
+
+    /**
+     * @brief Gets the maximum number of virtual voices.
+     * 
+     * @return Maximum number of virtual voices.
+     */
+    size_t getMaxVirtualVoices();
+
+    /**
+     * @brief Gets how many sounds are currently virtual voices.
+     * 
+     * @return Number of sounds playing without a source.
+     */
+    size_t getVirtualVoiceCount();
+
+    /**
+     * @brief Sets the gain below which a 3D sound is considered out of hearing range.
+     * 
+     * playSound3D() estimates the gain of a sound at the listener from its volume, its distance and OpenAL's
+     * default inverse distance model before loading it or taking a source. Inaudible one-shots are dropped,
+     * inaudible loops start as virtual voices and only get a source once they come into range. update()
+     * applies the same estimate to playing sounds: one that moves out of range gives its source back and
+     * carries on as a virtual voice. Streamed music cannot be virtual and keeps playing.
+     * 
+     * @param gain Minimum audible gain, 0 disables culling. Default is 0.001 (-60dB).
+     * @return true if successfully set, false if gain is negative.
+     */
+    bool setAudibilityThreshold(float gain);
+
+    /**
+     * @brief Gets the gain below which 3D sounds are culled.
+     * 
+     * @return Minimum audible gain.
+     */
+    float getAudibilityThreshold();
+
+    /**
+     * @brief Enables or disables the command queue.
+     * 
+     * While enabled, play, pause, resume, stop and per-handle property calls are pushed to a lock-free queue
+     * instead of locking the sound manager, so any number of game threads can issue them without contending
+     * with each other or with update(). They return immediately, play calls with a handle reserved for the
+     * sound, and take effect in order at the next update(). Other calls that change state, such as stopAll(),
+     * fades or the master volumes, apply the queued commands before their own. Queries still lock and read the
+     * current state. Disabling applies the commands still queued, after waiting for calls that were already
+     * queueing, and later calls take the locked path. shutdown() disables the queue the same way.
+     * 
+     * @param enabled true to queue commands, false to apply them immediately (default).
+     * @return true if successfully set, false when enabling before initialize().
+     */
+    bool setCommandQueueEnabled(bool enabled);
+
+    /**
+     * @brief Checks whether calls go through the command queue.
+     * 
+     * @return true if the command queue is enabled.
+     */
+    bool isCommandQueueEnabled();
+
     // in the future: bool preloadScene/unloadScene/isSceneLoaded(const Scene &scene); with gamecoe::Scene object!
 
     /**
@@ -137,11 +457,61 @@ namespace soundcoe
      * @param pitch Pitch multiplier. Default is 1.0.
      * @param loop Whether to loop the sound. Default is false.
      * @param priority Sound priority for resource allocation. Default is Medium.
-     * @return SoundHandle to control the playing sound, or INVALID_SOUND_HANDLE (equal to 0) if playback failed.
+     * @param maxDistance Distance from the listener beyond which the sound is inaudible. Default is 0 (no limit).
+     * @return SoundHandle to control the playing sound, or INVALID_SOUND_HANDLE (equal to 0) if playback failed
+     *         or a one-shot was culled for being out of hearing range (see setAudibilityThreshold()).
      */
     SoundHandle playSound3D(const std::string &filename, const Vec3 &position, const Vec3 &velocity = Vec3::zero(),
                                    float volume = 1.0f, float pitch = 1.0f, bool loop = false,
-                                   SoundPriority priority = SoundPriority::Medium);
+                                   SoundPriority priority = SoundPriority::Medium, float maxDistance = 0.0f);
+
+    /**
+     * @brief Interns a sound file name so it can be played by SoundId.
+     * 
+     * Playing by SoundId skips building and resolving the file path on every call, the cache entry is
+     * looked up once and reused until the directories or the cache change. The returned id equals
+     * makeSoundId(filename) for a normalized name, so constants generated at build time by
+     * soundcoe_generate_sound_ids() only need to be registered once after initialize().
+     * 
+     * @param filename Name of the sound file, as passed to playSound().
+     * @return SoundId of the file, or INVALID_SOUND_ID if soundcoe is not initialized or the name collides.
+     * 
+     * @example
+     * SoundId shot = soundcoe::registerSound("weapons/shot.wav");
+     * soundcoe::playSound(shot);
+     */
+    SoundId registerSound(const std::string &filename);
+
+    /**
+     * @brief Plays a registered sound with specified properties.
+     *
+     * @param id SoundId returned by registerSound().
+     * @param volume Volume level. Default is 1.0.
+     * @param pitch Pitch multiplier. Default is 1.0.
+     * @param loop Whether to loop the sound. Default is false.
+     * @param priority Sound priority for resource allocation. Default is Medium.
+     * @return SoundHandle to control the playing sound, or INVALID_SOUND_HANDLE (equal to 0) if playback failed.
+     */
+    SoundHandle playSound(SoundId id, float volume = 1.0f, float pitch = 1.0f, bool loop = false,
+                                 SoundPriority priority = SoundPriority::Medium);
+
+    /**
+     * @brief Plays a registered sound as a 3D positioned sound.
+     *
+     * @param id SoundId returned by registerSound().
+     * @param position 3D world position of the sound source.
+     * @param velocity 3D velocity vector for doppler effect. Default is zero.
+     * @param volume Volume level. Default is 1.0.
+     * @param pitch Pitch multiplier. Default is 1.0.
+     * @param loop Whether to loop the sound. Default is false.
+     * @param priority Sound priority for resource allocation. Default is Medium.
+     * @param maxDistance Distance from the listener beyond which the sound is inaudible. Default is 0 (no limit).
+     * @return SoundHandle to control the playing sound, or INVALID_SOUND_HANDLE (equal to 0) if playback failed
+     *         or a one-shot was culled for being out of hearing range.
+     */
+    SoundHandle playSound3D(SoundId id, const Vec3 &position, const Vec3 &velocity = Vec3::zero(),
+                                   float volume = 1.0f, float pitch = 1.0f, bool loop = false,
+                                   SoundPriority priority = SoundPriority::Medium, float maxDistance = 0.0f);
 
     /**
      * @brief Plays a music file with specified properties.
@@ -351,6 +721,36 @@ namespace soundcoe
      */
     bool isMusicStopped(MusicHandle handle);
 
+    /**
+     * @brief Plays several sounds at once.
+     * 
+     * Locks the sound manager once and defers the OpenAL updates until every sound is started, so the mixer
+     * starts them together. Each request plays its id when it is valid, otherwise its filename.
+     * 
+     * @param requests Sounds to play, see PlayRequest.
+     * @return One handle per request in the same order, INVALID_SOUND_HANDLE for each sound that failed to play.
+     */
+    std::vector<SoundHandle> playSounds(const std::vector<PlayRequest> &requests);
+
+    /**
+     * @brief Moves several 3D sounds at once.
+     * 
+     * Locks the sound manager once, checks for OpenAL errors once and applies all positions in the same mixer
+     * update. Invalid handles are skipped without stopping the batch.
+     * 
+     * @param positions Pairs of sound handle and new world position.
+     * @return true if every position was applied, false if a handle was invalid or OpenAL reported an error.
+     */
+    bool setSoundPositions(const std::vector<std::pair<SoundHandle, Vec3>> &positions);
+
+    /**
+     * @brief Gets the state of several sounds at once.
+     * 
+     * @param handles Sound handles to query.
+     * @return One state per handle in the same order. Handles of finished sounds report SoundState::Stopped.
+     */
+    std::vector<SoundState> getSoundStates(const std::vector<SoundHandle> &handles);
+
     /**
      * @brief Gets the number of currently active sound sources.
      * 
@@ -6,6 +6,7 @@
 #include <utility>
 #include <AL/al.h>
 #include <AL/alc.h>
+#include <AL/alext.h>
 
 namespace soundcoe
 {
@@ -16,6 +17,13 @@ namespace soundcoe
             ALCdevice *m_device     = nullptr;
             ALCcontext *m_context   = nullptr;
             bool m_initialized      = false;
+            bool m_float32Supported = false;
+            bool m_ima4Supported    = false;
+            bool m_msAdpcmSupported = false;
+            ALCint m_deviceFrequency = 0;
+            LPALDEFERUPDATESSOFT m_alDeferUpdates = nullptr;     // AL_SOFT_deferred_updates, null when missing
+            LPALPROCESSUPDATESSOFT m_alProcessUpdates = nullptr;
+            size_t m_suspendDepth = 0;
             mutable std::mutex m_mutex;
 
             AudioContext(const AudioContext &) = delete;
@@ -33,6 +41,15 @@ namespace soundcoe
             bool isInitialized() const;
             ALCdevice *getDevice() const;
             ALCcontext *getContext() const;
+            bool isFloat32Supported() const;
+            bool isIma4Supported() const;
+            bool isMsAdpcmSupported() const;
+            ALCint getDeviceFrequency() const;
+            bool isDeferredUpdatesSupported() const;
+
+            void suspendUpdates();
+            void processUpdates();
+            bool isUpdatesSuspended() const;
         };
     } // namespace detail
 } // namespace soundcoe
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include <logcoe.hpp>
 #include <cmath>
+#include <cstdint>
+#include <string>
 #include <string_view>
 #include <sstream>
 #include <limits>
@@ -15,6 +17,33 @@ namespace soundcoe
     using SoundHandle = size_t;
     using MusicHandle = size_t;
 
+    // A sound file name interned as its 64-bit FNV-1a hash, see registerSound()
+    struct SoundId
+    {
+        uint64_t value = 0;
+
+        constexpr SoundId() = default;
+        constexpr explicit SoundId(uint64_t hash) : value(hash) {}
+
+        constexpr bool isValid() const { return value != 0; }
+        constexpr bool operator==(const SoundId &other) const { return value == other.value; }
+        constexpr bool operator!=(const SoundId &other) const { return value != other.value; }
+    };
+
+    constexpr SoundId INVALID_SOUND_ID = SoundId();
+
+    // Hashes a normalized, '/' separated name relative to the sound subdirectory (e.g. "weapons/shot.wav")
+    constexpr SoundId makeSoundId(std::string_view name)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for (char c : name)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return SoundId(hash);
+    }
+
     enum class SoundState
     {
         Initial,
@@ -87,6 +116,49 @@ namespace soundcoe
         float angle(const Vec3 &other) const { return acosf(this->normalized().dot(other.normalized())); }
     };
 
+    struct StreamingPolicy
+    {
+        size_t minFileSize = 2 * 1024 * 1024; // bytes, 0 disables the size rule
+        float minDuration = 0.0f;             // seconds, 0 disables the duration rule
+
+        StreamingPolicy() = default;
+        StreamingPolicy(size_t _minFileSize, float _minDuration) : minFileSize(_minFileSize), minDuration(_minDuration) {}
+
+        static StreamingPolicy never() { return StreamingPolicy(0, 0.0f); }
+        static StreamingPolicy always() { return StreamingPolicy(1, 0.0f); }
+        static StreamingPolicy bySize(size_t bytes) { return StreamingPolicy(bytes, 0.0f); }
+        static StreamingPolicy byDuration(float seconds) { return StreamingPolicy(0, seconds); }
+
+        bool isEnabled() const { return minFileSize > 0 || minDuration > 0.0f; }
+        bool operator==(const StreamingPolicy &other) const { return (minFileSize == other.minFileSize && minDuration == other.minDuration); }
+        bool operator!=(const StreamingPolicy &other) const { return !(*this == other); }
+    };
+
+    // Encoding of resident (not streamed) buffers. ADPCM keeps about 4x more sounds in the same cache budget at a
+    // small quality cost, it needs AL_EXT_IMA4 or AL_SOFT_MSADPCM on the device and falls back to PCM otherwise.
+    enum class BufferCompression
+    {
+        None,
+        Ima4,
+        MsAdpcm
+    };
+
+    // One sound of a playSounds() batch. A valid id is played instead of the filename, position, velocity and
+    // maxDistance only apply when is3D is set.
+    struct PlayRequest
+    {
+        std::string filename;
+        SoundId id;
+        float volume = 1.0f;
+        float pitch = 1.0f;
+        bool loop = false;
+        SoundPriority priority = SoundPriority::Medium;
+        bool is3D = false;
+        Vec3 position;
+        Vec3 velocity;
+        float maxDistance = 0.0f;
+    };
+
     namespace detail
     {
         enum class AudioFormat
@@ -1,11 +1,18 @@
 #pragma once
 
 #include <soundcoe/resources/resource_manager.hpp>
+#include <soundcoe/resources/sound_stream.hpp>
+#include <soundcoe/resources/stream_worker.hpp>
+#include <soundcoe/utils/mpsc_queue.hpp>
+#include <soundcoe/utils/slot_map.hpp>
 #include <soundcoe/core/types.hpp>
 #include <string>
+#include <memory>
 #include <mutex>
 #include <atomic>
-#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include <utility>
 #include <chrono>
 
 namespace soundcoe
@@ -15,40 +22,119 @@ namespace soundcoe
 
     namespace detail
     {
+        constexpr size_t NO_FADE = SIZE_MAX;
+
         struct ActiveAudio
         {
             size_t m_sourceIndex;
             std::string m_filename;
+            SoundId m_soundId; // Set instead of m_filename when played through a registered SoundId
+            SoundPriority m_priority = SoundPriority::Medium;
             float m_baseVolume;
             float m_basePitch;
             bool m_loop;
+            bool m_paused = false;
+            bool m_is3D = false;
+            Vec3 m_position;
+            Vec3 m_velocity;
+            float m_maxDistance = 0.0f;
+
+            // A virtual voice has no source, it keeps its clock running and update() moves it back onto one
+            bool m_virtual = false;
+            float m_playbackOffset = 0.0f;
+            float m_duration = 0.0f;
 
             bool m_stream = false;
             size_t m_streamBufferSize = 0;
             float m_streamPosition = 0.0f;
             bool m_streamNeedsRefill = false;
+            bool m_streamStarved = false;
+            std::unique_ptr<SoundStream> m_soundStream;
+            std::chrono::steady_clock::time_point m_sourceAllocatedTime;
 
-            bool m_isFading = false;
-            float m_fadeDuration = 0.0f;
-            float m_fadeElapsed = 0.0f;
-            float m_fadeStartVolume = 0.0f;
-            float m_fadeTargetVolume = 0.0f;
+            size_t m_fadeIndex = NO_FADE; // Entry in the category's FadeTable while fading
+        };
+
+        // The fading voices of one category as parallel arrays: advance() computes every fade and final gain in one
+        // branch-free pass the compiler can vectorize, the AL calls happen afterwards and only for changed gains.
+        // Entries of voices that were erased stay until handleFadeEffects finds their handle stale.
+        struct FadeTable
+        {
+            std::vector<size_t> m_handles;
+            std::vector<float> m_elapsed;
+            std::vector<float> m_duration;
+            std::vector<float> m_startVolume;
+            std::vector<float> m_targetVolume;
+            std::vector<float> m_volume;      // Fade volume of the current frame
+            std::vector<float> m_gain;        // m_volume with master, category and mute applied
+            std::vector<float> m_appliedGain; // Last gain given to the source, negative forces the next update
+            std::vector<uint8_t> m_finished;
+
+            size_t add(size_t handle);
+            void restart(size_t index, float startVolume, float targetVolume, float duration);
+            size_t remove(size_t index);
+            void advance(float deltaTime, float gainScale);
+            void invalidate();
+            void clear();
+            size_t size() const { return m_handles.size(); }
+        };
+
+        enum class CommandType : uint8_t
+        {
+            Play,
+            Pause,
+            Resume,
+            Stop,
+            SetProperty
+        };
+
+        // An API call recorded by a producer thread while the command queue is enabled, applied by update()
+        struct AudioCommand
+        {
+            CommandType m_type = CommandType::Play;
+            PropertyType m_property = PropertyType::Volume;
+            bool m_music = false;
+            bool m_is3D = false;
+            bool m_loop = false;
+            SoundPriority m_priority = SoundPriority::Medium;
+            size_t m_handle = 0;
+            SoundId m_soundId = INVALID_SOUND_ID;
+            std::string m_filename;
+            float m_volume = 1.0f; // Also the value of a volume or pitch property
+            float m_pitch = 1.0f;
+            float m_maxDistance = 0.0f;
+            Vec3 m_position; // Also the value of a position or velocity property
+            Vec3 m_velocity;
         };
 
         class SoundManager
         {
+            static constexpr size_t COMMAND_QUEUE_CAPACITY = 1024;
+
             bool m_initialized = false;
 
             ResourceManager m_resourceManager;
+            StreamWorker m_streamWorker;
+            size_t m_streamReadAhead = SoundStream::DEFAULT_READ_AHEAD;
+            std::atomic<size_t> m_streamUnderruns{0};
+            size_t m_maxVirtualVoices = 1024;
+            size_t m_virtualVoiceCount = 0;
+            float m_audibilityThreshold = 0.001f; // -60dB
             std::string m_soundSubdir;
             std::string m_musicSubdir;
 
-            std::atomic<size_t> m_nextSoundHandle;
-            std::atomic<size_t> m_nextMusicHandle;
+            // Producers push without locking m_mutex, update() is the only consumer
+            std::atomic<bool> m_commandQueueEnabled{false};
+            // Producers between seeing the queue enabled and finishing their push, disabling waits for them
+            std::atomic<size_t> m_queueProducers{0};
+            MpscQueue<AudioCommand> m_commands{COMMAND_QUEUE_CAPACITY};
 
             mutable std::mutex m_mutex;
-            std::unordered_map<SoundHandle, ActiveAudio> m_activeSounds;
-            std::unordered_map<MusicHandle, ActiveAudio> m_activeMusic;
+            // Handles are slot map keys: O(1) lookups, stale handles fail instead of reaching a newer sound
+            SlotMap<ActiveAudio> m_activeSounds;
+            SlotMap<ActiveAudio> m_activeMusic;
+            FadeTable m_soundFades;
+            FadeTable m_musicFades;
 
             float m_masterVolume = 1.0f;
             float m_masterSoundsVolume = 1.0f;
@@ -73,18 +159,31 @@ namespace soundcoe
             bool m_hasError = false;
 
             template <typename Setter, typename Getter>
-            void updateAllAudioProperty(std::unordered_map<size_t, ActiveAudio> &activeAudio,
+            void updateAllAudioProperty(SlotMap<ActiveAudio> &activeAudio,
                                         Setter setProperty, Getter getBaseProperty,
                                         float masterMultiplier, float categoryMultiplier)
             {
                 for (auto it = activeAudio.begin(); it != activeAudio.end();)
                 {
+                    // Virtual voices pick the new values up when they get a source again
+                    if (it->second.m_virtual)
+                    {
+                        ++it;
+                        continue;
+                    }
+
                     auto sourceAllocation = m_resourceManager.getSourceAllocation(it->second.m_sourceIndex);
                     if (!(sourceAllocation.has_value()) || !(sourceAllocation.value().get().m_active))
                     {
                         it = activeAudio.erase(it);
                         continue;
                     }
+                    // A stolen source belongs to the more important sound now, update() makes this one virtual
+                    if (sourceAllocation.value().get().m_allocatedTime != it->second.m_sourceAllocatedTime)
+                    {
+                        ++it;
+                        continue;
+                    }
 
                     float finalValue = getBaseProperty(it->second) * masterMultiplier * categoryMultiplier;
                     setProperty(sourceAllocation.value().get().m_source, finalValue);
@@ -104,34 +203,63 @@ namespace soundcoe
             bool setListenerOrientationImpl(const Vec3 &forward, const Vec3 &up);
 
             bool setError(const std::string &error);
+            bool virtualizeIfStolen(ActiveAudio &audio);
 
-            bool fadeToVolume(std::unordered_map<size_t, ActiveAudio> &activeAudio, size_t handle,
+            bool fadeToVolume(SlotMap<ActiveAudio> &activeAudio, size_t handle,
                             float targetVolume, float duration, const std::string &method);
-            bool fade(std::unordered_map<size_t, ActiveAudio> &activeAudio, size_t handle,
+            bool fade(SlotMap<ActiveAudio> &activeAudio, size_t handle,
                     bool fadeIn, float duration, const std::string &method);
 
-            bool checkAudioState(std::unordered_map<size_t, ActiveAudio> &activeAudio, size_t handle,
+            bool checkAudioState(SlotMap<ActiveAudio> &activeAudio, size_t handle,
                                 SoundState state, const std::string &method);
 
-            bool setAudioProperty(std::unordered_map<size_t, ActiveAudio> &activeAudio, size_t handle,
+            bool setAudioProperty(SlotMap<ActiveAudio> &activeAudio, size_t handle,
                                 PropertyType type, const std::string &method,
                                 float value, float y = 0.0f, float z = 0.0f);
 
-            bool audioOperation(std::unordered_map<size_t, ActiveAudio> &activeAudio, size_t handle,
+            bool audioOperation(SlotMap<ActiveAudio> &activeAudio, size_t handle,
                                 SoundState operation, const std::string &method);
-            bool audioOperationAll(std::unordered_map<size_t, ActiveAudio> &activeAudio, SoundState operation,
+            bool audioOperationAll(SlotMap<ActiveAudio> &activeAudio, SoundState operation,
                                 const std::string &method);
 
-            size_t play(std::unordered_map<size_t, ActiveAudio> &activeAudio, const std::string &filename,
-                        float volume, float pitch, bool loop, SoundPriority priority,
-                        std::atomic<size_t> &nextHandle, const std::string &method,
+            size_t play(SlotMap<ActiveAudio> &activeAudio, const std::string &filename, SoundId id,
+                        float volume, float pitch, bool loop, SoundPriority priority, const std::string &method,
                         float masterCategoryVolume, float masterCategoryPitch,
-                        bool is3D = false, const Vec3 &position = Vec3::zero(), const Vec3 &velocity = Vec3::zero());
-
-            void handleStreamingAudio();
-            void handleFadeEffects(std::unordered_map<size_t, ActiveAudio> &activeAudio, 
-                                float categoryMultiplier, float deltaTime);
-            void handleInactiveAudio(std::unordered_map<size_t, ActiveAudio> &activeAudio);
+                        bool is3D = false, const Vec3 &position = Vec3::zero(), const Vec3 &velocity = Vec3::zero(),
+                        float maxDistance = 0.0f, size_t reservedHandle = INVALID_SOUND_HANDLE);
+
+            void reserveHandleCapacity();
+            size_t queuePlay(AudioCommand &&command, SlotMap<ActiveAudio> &activeAudio);
+            bool queueOperation(bool music, size_t handle, CommandType type,
+                                PropertyType property = PropertyType::Volume, float value = 0.0f,
+                                const Vec3 &vector = Vec3::zero());
+            bool queueCommand(AudioCommand &&command);
+            bool enterQueue();
+            void leaveQueue();
+            void stopQueueing();
+            size_t applyPlay(AudioCommand &command);
+            bool applyCommand(AudioCommand &command);
+            size_t processCommands();
+            void discardCommands();
+
+            void releaseAudioBuffer(const ActiveAudio &audio);
+            void handleStreamingAudio(SlotMap<ActiveAudio> &activeAudio);
+            void releaseStreams(SlotMap<ActiveAudio> &activeAudio);
+            FadeTable &getFades(const SlotMap<ActiveAudio> &activeAudio);
+            void startFade(SlotMap<ActiveAudio> &activeAudio, size_t handle, ActiveAudio &audio,
+                           float startVolume, float targetVolume, float duration);
+            void removeFade(SlotMap<ActiveAudio> &activeAudio, size_t index);
+            float getFadeVolume(const SlotMap<ActiveAudio> &activeAudio, const ActiveAudio &audio);
+            void handleFadeEffects(SlotMap<ActiveAudio> &activeAudio, float categoryMultiplier, bool mute,
+                                   float deltaTime);
+            void handleInactiveAudio(SlotMap<ActiveAudio> &activeAudio);
+            void handleOutOfRangeAudio(SlotMap<ActiveAudio> &activeAudio);
+            void advancePlaybackClocks(SlotMap<ActiveAudio> &activeAudio, float categoryPitch,
+                                       float deltaTime);
+            float estimateGain(float volume, const Vec3 &position, float maxDistance) const;
+            float getAudibility(const ActiveAudio &audio) const;
+            bool realizeAudio(ActiveAudio &audio, size_t poolIndex, SoundSource &source, float volume, float pitch);
+            void handleVirtualAudio();
 
         public:
             SoundManager();
@@ -144,16 +272,51 @@ namespace soundcoe
             bool isInitialized() const;
 
             bool preloadScene(const std::string &sceneName);
+            PreloadTicket preloadSceneAsync(const std::string &sceneName);
             bool unloadScene(const std::string &sceneName);
             bool isSceneLoaded(const std::string &sceneName) const;
 
+            bool setStreamingPolicy(const StreamingPolicy &policy);
+            bool setStreamingPolicy(const std::string &subdirectory, const StreamingPolicy &policy);
+            StreamingPolicy getStreamingPolicy(const std::string &subdirectory = "") const;
+            bool setMonoDownmix(bool enabled);
+            bool setMonoDownmix(const std::string &subdirectory, bool enabled);
+            bool isMonoDownmixEnabled(const std::string &subdirectory = "") const;
+            bool setResampleOnLoad(bool enabled);
+            bool isResampleOnLoadEnabled() const;
+            bool setBufferCompression(BufferCompression compression);
+            bool setBufferCompression(const std::string &subdirectory, BufferCompression compression);
+            BufferCompression getBufferCompression(const std::string &subdirectory = "") const;
+            bool setCompressedCaching(bool enabled);
+            bool setCompressedCaching(const std::string &subdirectory, bool enabled);
+            bool isCompressedCachingEnabled(const std::string &subdirectory = "") const;
+            bool setCompressedCacheLimits(size_t compressedMB, size_t decodedMB);
+            bool setStreamReadAhead(size_t chunks);
+            size_t getStreamReadAhead() const;
+            size_t getStreamUnderrunCount() const;
+            bool setDecodeThreadCount(size_t threadCount);
+            size_t getDecodeThreadCount() const;
+            bool setMaxVirtualVoices(size_t count);
+            size_t getMaxVirtualVoices() const;
+            size_t getVirtualVoiceCount() const;
+            bool setAudibilityThreshold(float gain);
+            float getAudibilityThreshold() const;
+            bool setCommandQueueEnabled(bool enabled);
+            bool isCommandQueueEnabled() const;
+
             void update();
 
             SoundHandle playSound(const std::string &filename, float volume = 1.0f, float pitch = 1.0f, bool loop = false,
                                 SoundPriority priority = SoundPriority::Medium);
             SoundHandle playSound3D(const std::string &filename, const Vec3 &position, const Vec3 &velocity = Vec3::zero(),
                                     float volume = 1.0f, float pitch = 1.0f, bool loop = false,
-                                    SoundPriority priority = SoundPriority::Medium);
+                                    SoundPriority priority = SoundPriority::Medium, float maxDistance = 0.0f);
+            SoundId registerSound(const std::string &filename);
+            SoundHandle playSound(SoundId id, float volume = 1.0f, float pitch = 1.0f, bool loop = false,
+                                SoundPriority priority = SoundPriority::Medium);
+            SoundHandle playSound3D(SoundId id, const Vec3 &position, const Vec3 &velocity = Vec3::zero(),
+                                    float volume = 1.0f, float pitch = 1.0f, bool loop = false,
+                                    SoundPriority priority = SoundPriority::Medium, float maxDistance = 0.0f);
             MusicHandle playMusic(const std::string &filename, float volume = 1.0f, float pitch = 1.0f, bool loop = true,
                                 SoundPriority priority = SoundPriority::Critical);
 
@@ -186,6 +349,10 @@ namespace soundcoe
             bool isSoundStopped(SoundHandle handle);
             bool isMusicStopped(MusicHandle handle);
 
+            std::vector<SoundHandle> playSounds(const std::vector<PlayRequest> &requests);
+            bool setSoundPositions(const std::vector<std::pair<SoundHandle, Vec3>> &positions);
+            std::vector<SoundState> getSoundStates(const std::vector<SoundHandle> &handles);
+
             size_t getActiveSoundsCount() const;
             size_t getActiveMusicCount() const;
 
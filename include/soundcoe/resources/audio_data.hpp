@@ -1,13 +1,28 @@
 #pragma once
 
 #include <soundcoe/core/types.hpp>
+#include <soundcoe/utils/mapped_file.hpp>
 #include <AL/al.h>
+#include <cstddef>
 #include <string>
 
 namespace soundcoe
 {
     namespace detail
     {
+        struct DecodeOptions
+        {
+            // Keep high bit depth and float WAVs as 32-bit float, needs AL_EXT_FLOAT32 on the playing device
+            bool floatOutput = false;
+            // Average stereo into mono so OpenAL can spatialize it, which also halves its memory
+            bool downmixToMono = false;
+            // Resample to this rate (usually the device mixing rate) so OpenAL does not resample per voice, 0 keeps
+            // the file's rate
+            ALsizei targetSampleRate = 0;
+            // Keep 16-bit audio as 4-bit ADPCM blocks, needs AL_EXT_IMA4 or AL_SOFT_MSADPCM on the playing device
+            BufferCompression compression = BufferCompression::None;
+        };
+
         class AudioData
         {
             ALvoid *m_pcmData;
@@ -21,16 +36,24 @@ namespace soundcoe
             ALenum m_openALFormat;
             AudioFormat m_sourceFormat;
 
+            // Owns the file when m_pcmData points straight into it
+            MappedFile m_mappedFile;
+
             AudioData(ALvoid *pcmData, ALsizei pcmDataSize, ALsizei channels, ALsizei bitsPerSample, ALsizei sampleRate, 
                 AudioFormat sourceFormat);
 
             void cleanup();
 
             ALenum calculateOpenALFormat(ALsizei channels, ALsizei bitsPerSample);
+            void applyDecodeOptions(const DecodeOptions &options);
+            void downmixToMono();
+            void resampleTo(ALsizei sampleRate);
+            void compress(BufferCompression compression);
+
+            static AudioData loadFromMappedFile(MappedFile &&file, const DecodeOptions &options);
+            static bool findPcm16WavData(const uint8_t *data, size_t size, ALsizei &channels, ALsizei &sampleRate,
+                                         size_t &pcmOffset, size_t &pcmSize);
 
-            static bool isValidWav(const std::string &filename);
-            static bool isValidMp3(const std::string &filename);
-            static bool isValidOgg(const std::string &filename);
 
         public:
             AudioData();
@@ -40,10 +63,23 @@ namespace soundcoe
             AudioData &operator=(AudioData &&other) noexcept;
             ~AudioData();
 
-            static AudioData loadFromWav(const std::string &filename);
-            static AudioData loadFromOgg(const std::string &filename);
-            static AudioData loadFromMp3(const std::string &filename);
+            static AudioData loadFromFile(const std::string &filename, const DecodeOptions &options = DecodeOptions());
+            static AudioData loadFromFile(MappedFile &&file, const DecodeOptions &options = DecodeOptions());
+            static AudioData loadFromWav(const std::string &filename, const DecodeOptions &options = DecodeOptions());
+            static AudioData loadFromOgg(const std::string &filename, const DecodeOptions &options = DecodeOptions());
+            static AudioData loadFromMp3(const std::string &filename, const DecodeOptions &options = DecodeOptions());
+
+            static AudioData loadFromMemory(const void *data, size_t size, const std::string &name,
+                                            const DecodeOptions &options = DecodeOptions());
+            static AudioData loadFromWavMemory(const void *data, size_t size, const std::string &name,
+                                               const DecodeOptions &options = DecodeOptions());
+            static AudioData loadFromOggMemory(const void *data, size_t size, const std::string &name,
+                                               const DecodeOptions &options = DecodeOptions());
+            static AudioData loadFromMp3Memory(const void *data, size_t size, const std::string &name,
+                                               const DecodeOptions &options = DecodeOptions());
+
             static AudioFormat detectFormat(const std::string &filename);
+            static AudioFormat detectFormat(const void *data, size_t size);
 
             ALvoid *getPcmData() const;
             ALsizei getPcmDataSize() const;
@@ -54,6 +90,7 @@ namespace soundcoe
             ALenum getOpenALFormat() const;
             AudioFormat getSourceFormat() const;
 
+            bool isMapped() const;
             ALboolean isValid() const;
         };
     } // namespace detail
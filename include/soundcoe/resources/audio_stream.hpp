@@ -0,0 +1,65 @@
+#pragma once
+
+#include <soundcoe/core/types.hpp>
+#include <soundcoe/utils/mapped_file.hpp>
+#include <AL/al.h>
+#include <cstdint>
+#include <string>
+
+namespace soundcoe
+{
+    namespace detail
+    {
+        class AudioStream
+        {
+            void *m_decoder;
+            AudioFormat m_sourceFormat;
+            std::string m_filename;
+
+            ALsizei m_channels;
+            ALsizei m_sampleRate;
+            ALenum m_openALFormat;
+            uint64_t m_totalFrames;
+            uint64_t m_framePosition;
+
+            // Owns the bytes when the stream decodes from a file mapping
+            MappedFile m_mappedFile;
+
+            void openWav(const std::string &filename, const void *data, size_t size);
+            void openMp3(const std::string &filename, const void *data, size_t size);
+            void openOgg(const std::string &filename, const void *data, size_t size);
+            void openDecoder(const std::string &filename, AudioFormat format, const void *data, size_t size);
+
+        public:
+            AudioStream();
+            AudioStream(const std::string &filename);
+            AudioStream(const AudioStream &) = delete;
+            AudioStream &operator=(const AudioStream &) = delete;
+            AudioStream(AudioStream &&other) noexcept;
+            AudioStream &operator=(AudioStream &&other) noexcept;
+            ~AudioStream();
+
+            void open(const std::string &filename);
+            // Decodes from the mapping, which the stream keeps until it is closed
+            void open(MappedFile &&file);
+            // Decodes from memory owned by the caller, the data must outlive the stream
+            void open(const void *data, size_t size, const std::string &name);
+            void close();
+
+            size_t readFrames(int16_t *output, size_t frameCount);
+            bool rewind();
+
+            bool isOpen() const;
+            bool isAtEnd() const;
+            ALsizei getChannels() const;
+            ALsizei getSampleRate() const;
+            ALenum getOpenALFormat() const;
+            ALsizei getFrameSize() const;
+            uint64_t getTotalFrames() const;
+            uint64_t getFramePosition() const;
+            ALfloat getDuration() const;
+            AudioFormat getSourceFormat() const;
+            const std::string &getFileName() const;
+        };
+    } // namespace detail
+} // namespace soundcoe
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace soundcoe
+{
+    namespace detail
+    {
+        struct PreloadState
+        {
+            std::atomic<size_t> m_filesTotal{0};
+            std::atomic<size_t> m_filesDone{0};
+            std::atomic<size_t> m_filesFailed{0};
+            std::atomic<size_t> m_bytesTotal{0};
+            std::atomic<size_t> m_bytesDone{0};
+            std::atomic<bool> m_done{false};
+            std::atomic<bool> m_succeeded{false};
+            std::atomic<bool> m_cancelled{false};
+        };
+    } // namespace detail
+
+    // Progress of an asynchronous preload. Copies share the same progress, a default constructed ticket is invalid.
+    class PreloadTicket
+    {
+        std::shared_ptr<detail::PreloadState> m_state;
+
+    public:
+        PreloadTicket() = default;
+        explicit PreloadTicket(std::shared_ptr<detail::PreloadState> state) : m_state(std::move(state)) {}
+
+        bool isValid() const { return m_state != nullptr; }
+        bool isDone() const { return !m_state || m_state->m_done.load(); }
+        bool succeeded() const { return m_state && m_state->m_done.load() && m_state->m_succeeded.load(); }
+        bool isCancelled() const { return m_state && m_state->m_cancelled.load(); }
+
+        size_t getFilesDone() const { return m_state ? m_state->m_filesDone.load() : 0; }
+        size_t getFilesFailed() const { return m_state ? m_state->m_filesFailed.load() : 0; }
+        size_t getFilesTotal() const { return m_state ? m_state->m_filesTotal.load() : 0; }
+        size_t getBytesDone() const { return m_state ? m_state->m_bytesDone.load() : 0; }
+        size_t getBytesTotal() const { return m_state ? m_state->m_bytesTotal.load() : 0; }
+
+        float getProgress() const
+        {
+            if (!m_state)
+                return 0.0f;
+            if (m_state->m_done.load())
+                return 1.0f;
+
+            size_t bytesTotal = m_state->m_bytesTotal.load();
+            if (bytesTotal > 0)
+                return static_cast<float>(m_state->m_bytesDone.load()) / static_cast<float>(bytesTotal);
+
+            size_t filesTotal = m_state->m_filesTotal.load();
+            size_t filesDone = m_state->m_filesDone.load() + m_state->m_filesFailed.load();
+            return filesTotal > 0 ? static_cast<float>(filesDone) / static_cast<float>(filesTotal) : 0.0f;
+        }
+    };
+} // namespace soundcoe
\ No newline at end of file
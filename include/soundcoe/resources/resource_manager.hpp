@@ -4,6 +4,12 @@
 #include <soundcoe/core/types.hpp>
 #include <soundcoe/resources/sound_buffer.hpp>
 #include <soundcoe/resources/sound_source.hpp>
+#include <soundcoe/resources/preload_ticket.hpp>
+#include <soundcoe/resources/sound_bank.hpp>
+#include <soundcoe/utils/mapped_file.hpp>
+#include <soundcoe/utils/task_pool.hpp>
+#include <array>
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <unordered_map>
@@ -24,13 +30,73 @@ namespace soundcoe
             SoundPriority m_priority;
             std::chrono::steady_clock::time_point m_allocatedTime;
             bool m_active;
+            ALuint m_attachedBuffer = 0; // Cache buffer attached through ResourceManager::attachBuffer
+            size_t m_heapIndex = SIZE_MAX; // Position in the voice stealing heap while active
+        };
+
+        // Eviction buckets, each an LRU list running from least to most recently used: unreferenced entries first
+        // (compressed entries without PCM before decoded ones), then referenced entries by the highest priority
+        // they are playing at. Regular and compressed tier entries have separate sets.
+        constexpr size_t LRU_PRIORITY_COUNT = 4;
+        constexpr size_t LRU_BUCKET_COUNT = 2 + LRU_PRIORITY_COUNT;
+
+        struct BufferCacheEntry;
+
+        struct LruList
+        {
+            BufferCacheEntry *m_head = nullptr;
+            BufferCacheEntry *m_tail = nullptr;
         };
 
         struct BufferCacheEntry
         {
             std::unique_ptr<SoundBuffer> m_buffer;
             size_t m_referenceCount;
-            std::chrono::steady_clock::time_point m_lastAccessed;
+            std::array<size_t, LRU_PRIORITY_COUNT> m_priorityReferences{};
+            // Compressed tier: the original Ogg/MP3 bytes stay in memory and m_buffer only holds PCM while it is
+            // recently played
+            std::vector<uint8_t> m_compressedData;
+
+            // Intrusive LRU links, set once the entry is in m_bufferCache
+            const std::string *m_cacheKey = nullptr;
+            LruList *m_lruList = nullptr;
+            BufferCacheEntry *m_lruPrev = nullptr;
+            BufferCacheEntry *m_lruNext = nullptr;
+        };
+
+        struct DecodedFile
+        {
+            std::filesystem::path m_filePath;
+            size_t m_fileSize = 0;
+            bool m_stream = false;
+            bool m_failed = false;
+            bool m_compressed = false;
+            std::vector<uint8_t> m_compressedData;
+            AudioData m_audioData;
+            AudioStream m_audioStream;
+        };
+
+        struct AsyncLoad
+        {
+            std::string m_subdirectory;
+            std::shared_ptr<PreloadState> m_state;
+            std::mutex m_mutex;
+            std::vector<DecodedFile> m_decodedFiles;
+            std::vector<std::filesystem::path> m_insertedFiles;
+            std::vector<std::filesystem::path> m_files;
+        };
+
+        struct RegisteredSound
+        {
+            std::string m_filename;
+            std::string m_cacheKey;
+            BufferCacheEntry *m_entry = nullptr; // Resolved on first use, reset when the cache or the index changes
+        };
+
+        struct IndexedFile
+        {
+            std::string m_subdirectory;
+            std::string m_cacheKey;
         };
 
         class ResourceManager
@@ -43,23 +109,94 @@ namespace soundcoe
 
             std::vector<SourceAllocation> m_sourcePool;
             std::deque<size_t> m_freeSourceIndices;
+            // Reverse indices into the pool, keyed by object since pool sources get their AL name on first use
+            std::unordered_map<const SoundSource *, size_t> m_sourceSlots;
+            std::unordered_map<ALuint, std::vector<size_t>> m_bufferSources;
+            // Min-heap of active slots by (priority, allocation time), its top is the next voice to steal
+            std::vector<size_t> m_voiceHeap;
 
             std::unordered_map<std::string, BufferCacheEntry> m_bufferCache;
+            std::array<LruList, LRU_BUCKET_COUNT> m_lruLists;
+            std::array<LruList, LRU_BUCKET_COUNT> m_compressedLruLists;
             size_t m_maxCacheSize = 64 * 1024 * 1024; // 64MB
             size_t m_currentCacheSize = 0;
+            size_t m_maxCompressedCacheSize = 16 * 1024 * 1024; // 16MB of Ogg/MP3 bytes
+            size_t m_currentCompressedCacheSize = 0;
+            size_t m_maxDecodedCacheSize = 8 * 1024 * 1024; // 8MB of PCM decoded from them
+            size_t m_currentDecodedCacheSize = 0;
+            bool m_compressedCaching = false;
+            std::unordered_map<std::string, bool> m_subdirCompressedCaching;
+            StreamingPolicy m_streamingPolicy;
+            std::unordered_map<std::string, StreamingPolicy> m_subdirStreamingPolicies;
+            bool m_monoDownmix = false;
+            std::unordered_map<std::string, bool> m_subdirMonoDownmix;
+            bool m_resampleOnLoad = false;
+            BufferCompression m_bufferCompression = BufferCompression::None;
+            std::unordered_map<std::string, BufferCompression> m_subdirBufferCompression;
 
             std::vector<std::filesystem::path> m_loadedDirectories;
+            std::unordered_map<std::string, SoundBank> m_loadedBanks;
+            // Name relative to a loaded directory -> the files it resolves to, in directory load order
+            std::unordered_map<std::string, std::vector<IndexedFile>> m_fileIndex;
+            std::unordered_map<uint64_t, RegisteredSound> m_registeredSounds;
+
+            DecodeOptions m_decodeOptions;
+            TaskPool m_decodePool;
+            size_t m_decodeThreadCount = 0; // 0 picks one thread per core, minus the calling thread
+            std::vector<std::shared_ptr<AsyncLoad>> m_asyncLoads;
 
             void createSourcePool();
-            bool findSourceToReplace(SoundPriority newPriority, size_t &replaceIndex);
+            bool findSourceToReplace(SoundPriority newPriority, bool stealEqualPriority, size_t &replaceIndex);
+            bool stealsBefore(size_t a, size_t b) const;
+            void siftVoice(size_t position);
+            void pushVoice(size_t index);
+            void removeVoice(size_t index);
             void freeBuffers();
+            void detachBufferFromSources(ALuint bufferId);
+            void detachSource(size_t index, const std::string &method);
+            void eraseCacheEntry(std::unordered_map<std::string, BufferCacheEntry>::iterator it);
+            BufferCacheEntry &emplaceCacheEntry(const std::string &cacheKey, BufferCacheEntry &&entry);
+            void linkLruEntry(BufferCacheEntry &entry);
+            void unlinkLruEntry(BufferCacheEntry &entry);
+            void dereferenceEntry(BufferCacheEntry &entry, SoundPriority priority);
+            bool reserveCompressedCache(size_t size);
+            void freeDecodedBuffers();
             std::filesystem::path normalizePath(const std::string &path) const;
             bool scanDirectoryForFiles(const std::filesystem::path &subdirectory, std::vector<std::filesystem::path> &files);
+            std::string normalizeSubdirectory(const std::string &subdirectory) const;
+            template <typename T>
+            const T *findSubdirectoryOverride(const std::unordered_map<std::string, T> &overrides,
+                                              const std::filesystem::path &filePath) const;
+            const StreamingPolicy &getStreamingPolicyForFile(const std::filesystem::path &filePath) const;
+            DecodeOptions getDecodeOptionsForFile(const std::filesystem::path &filePath) const;
+            bool isCompressionSupported(BufferCompression compression) const;
+            static bool shouldStreamFile(const MappedFile &file, const StreamingPolicy &policy);
+            bool shouldKeepCompressed(const std::filesystem::path &filePath) const;
+            static DecodedFile decodeFileImpl(const std::filesystem::path &filePath, const StreamingPolicy &policy,
+                                              const DecodeOptions &options, bool keepCompressed);
+            static void decodeFile(const std::shared_ptr<AsyncLoad> &load, const std::filesystem::path &filePath,
+                                   const StreamingPolicy &policy, const DecodeOptions &options, bool keepCompressed);
+            std::vector<DecodedFile> decodeFiles(const std::vector<std::filesystem::path> &files);
+            bool insertBuffer(const std::string &cacheKey, std::unique_ptr<SoundBuffer> buffer);
+            bool insertDecodedFile(DecodedFile &decoded);
+            bool insertCompressedFile(const std::filesystem::path &filePath, std::vector<uint8_t> &&data);
+            bool decodeCompressedEntry(const std::string &cacheKey, BufferCacheEntry &entry);
             bool preloadFileImpl(const std::filesystem::path &filePath);
+            std::filesystem::path findBankFile(const std::string &subdirectory) const;
+            bool preloadBankImpl(const std::string &subdirectory, const std::filesystem::path &bankFile);
+            bool findBankEntry(const std::filesystem::path &filePath, const SoundBank *&bank, size_t &index) const;
+            bool insertBankEntry(const SoundBank &bank, size_t index, const std::filesystem::path &filePath);
+            std::vector<std::shared_ptr<AsyncLoad>>::iterator findAsyncLoad(const std::string &subdirectory);
+            void finishAsyncLoad(AsyncLoad &load, bool succeeded);
+            void cancelAsyncLoads();
             bool unloadFileImpl(const std::filesystem::path &filePath);
             bool isDirectoryLoadedImpl(const std::string &subdirectory) const;
-            SoundPriority getHighestPriorityForBuffer(ALuint bufferId) const;
-            bool releaseBufferImpl(const std::string &filename);
+            bool releaseBufferImpl(const std::string &filename, SoundPriority priority);
+            std::optional<std::reference_wrapper<SoundBuffer>> referenceBuffer(const std::string &cacheKey,
+                                                                                BufferCacheEntry &entry, SoundPriority priority);
+            void resetRegisteredSounds(const BufferCacheEntry *entry = nullptr);
+            void indexDirectoryFiles(const std::string &subdirectory, const std::vector<std::filesystem::path> &files);
+            void unindexDirectoryFiles(const std::string &subdirectory);
             std::filesystem::path findFileInLoadedDirectories(const std::string &filename) const;
 
         public:
@@ -73,12 +210,23 @@ namespace soundcoe
 
             bool preloadDirectory(const std::string &subdirectory);
             bool unloadDirectory(const std::string &subdirectory);
+            PreloadTicket preloadDirectoryAsync(const std::string &subdirectory);
+            size_t processAsyncLoads();
+            bool isDirectoryLoading(const std::string &subdirectory) const;
+            bool setDecodeThreadCount(size_t threadCount);
+            size_t getDecodeThreadCount() const;
 
-            std::optional<std::reference_wrapper<SoundSource>> acquireSource(size_t &poolIndex, SoundPriority priority = SoundPriority::Medium);
-            std::optional<std::reference_wrapper<SoundBuffer>> getBuffer(const std::string &filename);
+            std::optional<std::reference_wrapper<SoundSource>> acquireSource(size_t &poolIndex, SoundPriority priority = SoundPriority::Medium,
+                                                                             bool stealEqualPriority = true);
+            std::optional<std::reference_wrapper<SoundBuffer>> getBuffer(const std::string &filename,
+                                                                         SoundPriority priority = SoundPriority::Low);
+            std::optional<std::reference_wrapper<SoundBuffer>> getBuffer(SoundId id, SoundPriority priority = SoundPriority::Low);
+            void attachBuffer(size_t poolIndex, std::reference_wrapper<SoundBuffer> buffer);
             bool releaseSource(std::reference_wrapper<SoundSource> source);
-            bool releaseBuffer(std::reference_wrapper<SoundBuffer> buffer);
-            bool releaseBuffer(const std::string &filename);
+            bool releaseBuffer(std::reference_wrapper<SoundBuffer> buffer, SoundPriority priority = SoundPriority::Low);
+            bool releaseBuffer(const std::string &filename, SoundPriority priority = SoundPriority::Low);
+            bool releaseBuffer(SoundId id, SoundPriority priority = SoundPriority::Low);
+            bool registerSound(SoundId id, const std::string &filename);
 
             size_t getActiveSourceCount() const;
             size_t getTotalSourceCount() const;
@@ -88,7 +236,56 @@ namespace soundcoe
             bool isDirectoryLoaded(const std::string &subdirectory) const;
             size_t cleanupUnusedBuffers();
 
+            void setStreamingPolicy(const StreamingPolicy &policy);
+            bool setStreamingPolicy(const std::string &subdirectory, const StreamingPolicy &policy);
+            bool clearStreamingPolicy(const std::string &subdirectory);
+            StreamingPolicy getStreamingPolicy(const std::string &subdirectory = "") const;
+
+            void setMonoDownmix(bool enabled);
+            bool setMonoDownmix(const std::string &subdirectory, bool enabled);
+            bool clearMonoDownmix(const std::string &subdirectory);
+            bool isMonoDownmixEnabled(const std::string &subdirectory = "") const;
+
+            void setBufferCompression(BufferCompression compression);
+            bool setBufferCompression(const std::string &subdirectory, BufferCompression compression);
+            bool clearBufferCompression(const std::string &subdirectory);
+            BufferCompression getBufferCompression(const std::string &subdirectory = "") const;
+
+            void setCompressedCaching(bool enabled);
+            bool setCompressedCaching(const std::string &subdirectory, bool enabled);
+            bool clearCompressedCaching(const std::string &subdirectory);
+            bool isCompressedCachingEnabled(const std::string &subdirectory = "") const;
+            void setCompressedCacheLimits(size_t compressedMB, size_t decodedMB);
+            size_t getCompressedCacheSizeBytes() const;
+            size_t getDecodedCacheSizeBytes() const;
+
+            void setResampleOnLoad(bool enabled);
+            bool isResampleOnLoadEnabled() const;
+            ALCint getDeviceFrequency() const;
+            void suspendUpdates();
+            void processUpdates();
+            bool isUpdatesSuspended() const;
+
             std::optional<std::reference_wrapper<SourceAllocation>> getSourceAllocation(size_t index);
+            std::vector<SourceAllocation> &getSourceAllocations();
+        };
+
+        // Keeps AL changes deferred while it lives, even when the scope is left by an exception. Nested scopes reach
+        // the mixer together when the outermost one ends.
+        class DeferredUpdates
+        {
+        private:
+            ResourceManager &m_resourceManager;
+
+        public:
+            explicit DeferredUpdates(ResourceManager &resourceManager) : m_resourceManager(resourceManager)
+            {
+                m_resourceManager.suspendUpdates();
+            }
+            ~DeferredUpdates() { m_resourceManager.processUpdates(); }
+
+            DeferredUpdates(const DeferredUpdates &) = delete;
+            DeferredUpdates &operator=(const DeferredUpdates &) = delete;
         };
     } // namespace detail
 } // namespace soundcoe
\ No newline at end of file
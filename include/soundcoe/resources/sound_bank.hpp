@@ -0,0 +1,77 @@
+#pragma once
+
+#include <soundcoe/resources/audio_data.hpp>
+#include <soundcoe/utils/mapped_file.hpp>
+#include <AL/al.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace soundcoe
+{
+    namespace detail
+    {
+        enum class BankEncoding : uint16_t
+        {
+            Pcm16 = 0,
+            Ima4 = 1,   // AL_EXT_IMA4 blocks of 65 frames
+            MsAdpcm = 2 // AL_SOFT_MSADPCM blocks of 64 frames
+        };
+
+        struct BankEntry
+        {
+            uint64_t m_nameHash = 0;
+            uint64_t m_dataOffset = 0;
+            uint64_t m_dataSize = 0;
+            uint32_t m_nameOffset = 0;
+            uint32_t m_nameLength = 0;
+            uint32_t m_sampleRate = 0;
+            uint16_t m_channels = 0;
+            uint16_t m_bitsPerSample = 0;
+            BankEncoding m_encoding = BankEncoding::Pcm16;
+            uint16_t m_blockAlign = 0;
+        };
+
+        // A whole directory packed into one file: a header, an index sorted by name hash, the names and
+        // pre-decoded payloads. The bank is memory mapped once and payloads are read straight from the mapping.
+        //
+        // Layout, all integers little endian:
+        //   header   "SCBK", u32 version, u32 entry count, u32 reserved, u64 names offset, u64 names size
+        //   entries  u64 name hash, u64 data offset, u64 data size, u32 name offset, u32 name length,
+        //            u32 sample rate, u16 channels, u16 bits per sample, u16 encoding, u16 block align, u32 reserved
+        //   names    file paths relative to the packed directory, '/' separated, not terminated
+        //   payloads 16-byte aligned, block align is the byte size of one frame (PCM) or one block (ADPCM)
+        class SoundBank
+        {
+            MappedFile m_file;
+            std::vector<BankEntry> m_entries;
+
+        public:
+            static constexpr uint32_t VERSION = 1;
+            static constexpr const char *FILE_EXTENSION = ".scbank";
+
+            SoundBank() = default;
+            SoundBank(const SoundBank &) = delete;
+            SoundBank &operator=(const SoundBank &) = delete;
+            SoundBank(SoundBank &&) noexcept = default;
+            SoundBank &operator=(SoundBank &&) noexcept = default;
+
+            static uint64_t hashName(const std::string &name);
+            static bool pack(const std::string &directory, const std::string &bankFile,
+                             const DecodeOptions &options = DecodeOptions());
+
+            bool open(const std::string &filename);
+            void close();
+            bool isOpen() const;
+
+            size_t getEntryCount() const;
+            const BankEntry &getEntry(size_t index) const;
+            std::string getName(size_t index) const;
+            bool find(const std::string &name, size_t &index) const;
+            const uint8_t *getData(size_t index) const;
+            ALenum getOpenALFormat(size_t index) const;
+            const std::string &getFileName() const;
+        };
+    } // namespace detail
+} // namespace soundcoe
\ No newline at end of file
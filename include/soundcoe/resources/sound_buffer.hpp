@@ -1,6 +1,7 @@
 #pragma once
 
 #include <soundcoe/resources/audio_data.hpp>
+#include <soundcoe/resources/audio_stream.hpp>
 #include <string>
 #include <AL/al.h>
 #include <AL/alc.h>
@@ -20,13 +21,14 @@ namespace soundcoe
             bool m_stream           = false;
             std::string m_filename = "";
 
-            void loadFromAudioData(AudioData &&audioData);
             void generateBuffer(const void* data);
 
         public:
             SoundBuffer();
-            SoundBuffer(const std::string &filename);
-            SoundBuffer(const void *data, ALenum format, ALsizei size, ALsizei sampleRate);
+            SoundBuffer(const std::string &filename, bool stream = false, const DecodeOptions &options = DecodeOptions());
+            SoundBuffer(const void *data, ALenum format, ALsizei size, ALsizei sampleRate, const std::string &filename = "");
+            SoundBuffer(AudioData &&audioData, const std::string &filename);
+            SoundBuffer(const AudioStream &stream, const std::string &filename);
             ~SoundBuffer();
 
             SoundBuffer(const SoundBuffer &) = delete;
@@ -34,8 +36,10 @@ namespace soundcoe
             SoundBuffer(SoundBuffer &&other) noexcept;
             SoundBuffer &operator=(SoundBuffer &&other) noexcept;
 
-            void loadFromFile(const std::string &filename);
-            void loadFromMemory(const void *data, ALenum format, ALsizei size, ALsizei sampleRate);
+            void loadFromFile(const std::string &filename, bool stream = false, const DecodeOptions &options = DecodeOptions());
+            void loadFromMemory(const void *data, ALenum format, ALsizei size, ALsizei sampleRate, const std::string &filename = "");
+            void loadFromAudioData(AudioData &&audioData, const std::string &filename);
+            void loadStreamInfo(const AudioStream &stream, const std::string &filename);
             void unload();
 
             ALuint getBufferId() const;
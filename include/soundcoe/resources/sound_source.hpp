@@ -34,6 +34,10 @@ namespace soundcoe
 
             void attachBuffer(const SoundBuffer &buffer);
             void detachBuffer();
+            bool queueBuffers(const ALuint *bufferIds, ALsizei count);
+            bool unqueueBuffers(ALuint *bufferIds, ALsizei count);
+            ALint getBuffersQueued() const;
+            ALint getBuffersProcessed() const;
 
             bool play();
             bool pause();
@@ -41,9 +45,10 @@ namespace soundcoe
 
             bool setVolume(float volume);
             bool setPitch(float pitch);
-            bool setPosition(const Vec3 &position);
+            bool setPosition(const Vec3 &position, bool checkError = true);
             bool setVelocity(const Vec3 &velocity);
             bool setLooping(bool looping);
+            bool setPlaybackOffset(float seconds);
             float getVolume() const;
             float getPitch() const;
             const Vec3 &getPosition() const;
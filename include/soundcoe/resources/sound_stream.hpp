@@ -0,0 +1,99 @@
+#pragma once
+
+#include <soundcoe/resources/audio_stream.hpp>
+#include <soundcoe/resources/sound_source.hpp>
+#include <soundcoe/utils/spsc_queue.hpp>
+#include <AL/al.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace soundcoe
+{
+    namespace detail
+    {
+        class StreamWorker;
+
+        struct StreamChunk
+        {
+            std::vector<int16_t> m_samples;
+            size_t m_frames = 0;
+            bool m_endOfStream = false;
+        };
+
+        // Decoding half of a stream. Chunks circulate between two SPSC queues: the decoding thread takes
+        // empty chunks from m_freeChunks and publishes decoded ones on m_readyChunks, the playing thread
+        // uploads them to OpenAL and hands them back. The number of chunks is the read-ahead depth.
+        class StreamDecoder
+        {
+            AudioStream m_audioStream;
+            bool m_loop;
+            size_t m_chunkFrames;
+            SpscQueue<std::unique_ptr<StreamChunk>> m_freeChunks;
+            SpscQueue<std::unique_ptr<StreamChunk>> m_readyChunks;
+            std::atomic<bool> m_finished;
+
+            void decodeChunk(StreamChunk &chunk);
+
+        public:
+            StreamDecoder(const std::string &filename, bool loop, size_t chunkSize, size_t readAhead);
+            StreamDecoder(const StreamDecoder &) = delete;
+            StreamDecoder &operator=(const StreamDecoder &) = delete;
+
+            size_t decodeAhead();
+            std::unique_ptr<StreamChunk> popChunk();
+            void recycleChunk(std::unique_ptr<StreamChunk> chunk);
+
+            bool isFinished() const;
+            bool isLooping() const;
+            size_t getReadyChunkCount() const;
+            size_t getChunkFrames() const;
+            size_t getReadAhead() const;
+            const AudioStream &getAudioStream() const;
+        };
+
+        class SoundStream
+        {
+            std::shared_ptr<StreamDecoder> m_decoder;
+            StreamWorker *m_worker;
+            bool m_backgroundDecode = false;
+            std::vector<ALuint> m_bufferIds;
+            std::vector<ALuint> m_idleBufferIds;
+            std::unordered_map<ALuint, size_t> m_bufferFrames;
+            bool m_endOfStream      = false;
+            uint64_t m_playedFrames = 0;
+            size_t m_bufferSize     = 0;
+
+            std::unique_ptr<StreamChunk> nextChunk();
+            size_t fillBuffer(ALuint bufferId);
+
+        public:
+            static constexpr size_t DEFAULT_BUFFER_COUNT = 4;
+            static constexpr size_t DEFAULT_BUFFER_SIZE = 64 * 1024; // 64KB per queued buffer
+            static constexpr size_t DEFAULT_READ_AHEAD = 4;          // decoded chunks waiting for a free buffer
+
+            SoundStream(const std::string &filename, bool loop, StreamWorker *worker = nullptr,
+                        size_t readAhead = DEFAULT_READ_AHEAD, size_t bufferCount = DEFAULT_BUFFER_COUNT,
+                        size_t bufferSize = DEFAULT_BUFFER_SIZE);
+            SoundStream(const SoundStream &) = delete;
+            SoundStream &operator=(const SoundStream &) = delete;
+            SoundStream(SoundStream &&) = delete;
+            SoundStream &operator=(SoundStream &&) = delete;
+            ~SoundStream();
+
+            bool start(SoundSource &source);
+            size_t refill(SoundSource &source);
+
+            bool isFinished() const;
+            bool isLooping() const;
+            float getPosition() const;
+            size_t getBufferSize() const;
+            size_t getBufferCount() const;
+            size_t getReadAhead() const;
+            const AudioStream &getAudioStream() const;
+        };
+    } // namespace detail
+} // namespace soundcoe
\ No newline at end of file
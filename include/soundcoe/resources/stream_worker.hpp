@@ -0,0 +1,47 @@
+#pragma once
+
+#include <soundcoe/resources/sound_stream.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace soundcoe
+{
+    namespace detail
+    {
+        // Background thread that keeps every registered StreamDecoder decoded ahead of playback,
+        // so refilling a stream on the game thread only uploads ready PCM to OpenAL.
+        class StreamWorker
+        {
+            std::thread m_thread;
+            std::mutex m_mutex;
+            std::condition_variable m_condition;
+            std::vector<std::weak_ptr<StreamDecoder>> m_decoders;
+            std::atomic<bool> m_running;
+            std::atomic<bool> m_wakeUp;
+            std::chrono::milliseconds m_pollInterval;
+
+            void run();
+
+        public:
+            static constexpr std::chrono::milliseconds DEFAULT_POLL_INTERVAL{5};
+
+            StreamWorker();
+            StreamWorker(const StreamWorker &) = delete;
+            StreamWorker &operator=(const StreamWorker &) = delete;
+            ~StreamWorker();
+
+            void start(std::chrono::milliseconds pollInterval = DEFAULT_POLL_INTERVAL);
+            void stop();
+            bool isRunning() const;
+
+            void addDecoder(const std::shared_ptr<StreamDecoder> &decoder);
+            void wakeUp();
+            size_t getDecoderCount();
+        };
+    } // namespace detail
+} // namespace soundcoe
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace soundcoe
+{
+    namespace detail
+    {
+        // 4-bit ADPCM block codecs producing the layouts OpenAL takes for AL_FORMAT_*_IMA4 and
+        // AL_FORMAT_*_MSADPCM_SOFT at their default block alignment. Audio is interleaved 16-bit, the last block is
+        // padded with silence.
+        namespace adpcm
+        {
+            constexpr size_t IMA4_FRAMES_PER_BLOCK = 65;
+            constexpr size_t MSADPCM_FRAMES_PER_BLOCK = 64;
+
+            size_t getBlockCount(size_t frameCount, size_t framesPerBlock);
+            size_t getIma4BlockSize(size_t channels);
+            size_t getMsAdpcmBlockSize(size_t channels);
+
+            // Output must hold getBlockCount() blocks of the format's block size
+            void encodeIma4(const int16_t *input, uint8_t *output, size_t frameCount, size_t channels);
+            void encodeMsAdpcm(const int16_t *input, uint8_t *output, size_t frameCount, size_t channels);
+
+            // Output must hold blockCount * frames per block frames
+            void decodeIma4(const uint8_t *input, int16_t *output, size_t blockCount, size_t channels);
+            void decodeMsAdpcm(const uint8_t *input, int16_t *output, size_t blockCount, size_t channels);
+        } // namespace adpcm
+    } // namespace detail
+} // namespace soundcoe
\ No newline at end of file
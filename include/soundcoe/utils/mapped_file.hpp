@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace soundcoe
+{
+    namespace detail
+    {
+        // Read-only view of a whole file. The file is memory mapped where the platform allows it,
+        // otherwise it is read once into memory.
+        class MappedFile
+        {
+            const uint8_t *m_data = nullptr;
+            size_t m_size = 0;
+            bool m_mapped = false;
+            std::vector<uint8_t> m_fallbackData;
+            std::string m_filename;
+#ifdef _WIN32
+            void *m_fileHandle = nullptr;
+            void *m_mappingHandle = nullptr;
+#endif
+
+            bool map(const std::string &filename);
+            bool read(const std::string &filename);
+
+        public:
+            MappedFile() = default;
+            MappedFile(const std::string &filename);
+            MappedFile(const MappedFile &) = delete;
+            MappedFile &operator=(const MappedFile &) = delete;
+            MappedFile(MappedFile &&other) noexcept;
+            MappedFile &operator=(MappedFile &&other) noexcept;
+            ~MappedFile();
+
+            bool open(const std::string &filename);
+            void close();
+
+            bool isOpen() const;
+            bool isMapped() const;
+            const uint8_t *data() const;
+            size_t size() const;
+            const std::string &getFileName() const;
+        };
+    } // namespace detail
+} // namespace soundcoe
\ No newline at end of file
@@ -28,6 +28,7 @@ namespace soundcoe
         float exponentialFade(float t, float curve = 2.0f);
 
         float calculateVolumeByDistance(float distance, float maxDistance, float rolloffFactor = 1.0f);
+        float calculateInverseDistanceGain(float distance, float referenceDistance = 1.0f, float rolloffFactor = 1.0f);
         float calculatePan(const Vec3 &listenerPosition, const Vec3 &sourcePosition, const Vec3 &listenerForward);
 
         float semitonesToRatio(float semitones);
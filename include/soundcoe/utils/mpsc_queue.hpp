@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace soundcoe
+{
+    namespace detail
+    {
+        // Bounded lock-free queue for any number of producer threads and exactly one consumer thread.
+        // Every slot carries a sequence number telling producers and the consumer whose turn it is, so
+        // producers only contend on the tail index and never wait for each other to finish writing.
+        template <typename T>
+        class MpscQueue
+        {
+            static constexpr size_t CACHE_LINE_SIZE = 64;
+
+            struct Slot
+            {
+                std::atomic<size_t> m_sequence;
+                T m_value;
+            };
+
+            std::unique_ptr<Slot[]> m_slots;
+            size_t m_mask;
+            alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_tail; // next slot to claim, shared by producers
+            alignas(CACHE_LINE_SIZE) size_t m_head;              // next slot to pop, owned by the consumer
+
+            static size_t roundUpToPowerOfTwo(size_t value)
+            {
+                size_t result = 1;
+                while (result < value)
+                    result <<= 1;
+                return result;
+            }
+
+        public:
+            explicit MpscQueue(size_t capacity)
+                : m_slots(new Slot[roundUpToPowerOfTwo(capacity < 1 ? 1 : capacity)]),
+                  m_mask(roundUpToPowerOfTwo(capacity < 1 ? 1 : capacity) - 1), m_tail(0), m_head(0)
+            {
+                for (size_t i = 0; i <= m_mask; ++i)
+                    m_slots[i].m_sequence.store(i, std::memory_order_relaxed);
+            }
+            MpscQueue(const MpscQueue &) = delete;
+            MpscQueue &operator=(const MpscQueue &) = delete;
+
+            bool tryPush(T &&value)
+            {
+                size_t tail = m_tail.load(std::memory_order_relaxed);
+                Slot *slot;
+                while (true)
+                {
+                    slot = &m_slots[tail & m_mask];
+                    size_t sequence = slot->m_sequence.load(std::memory_order_acquire);
+                    if (sequence == tail)
+                    {
+                        if (m_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed))
+                            break;
+                    }
+                    else if (sequence < tail)
+                        return false; // The consumer has not freed this slot yet, the queue is full
+                    else
+                        tail = m_tail.load(std::memory_order_relaxed);
+                }
+
+                slot->m_value = std::move(value);
+                slot->m_sequence.store(tail + 1, std::memory_order_release);
+                return true;
+            }
+
+            bool tryPop(T &value)
+            {
+                Slot &slot = m_slots[m_head & m_mask];
+                // A claimed slot whose producer is still writing ends the pop until the next call
+                if (slot.m_sequence.load(std::memory_order_acquire) != m_head + 1)
+                    return false;
+
+                value = std::move(slot.m_value);
+                slot.m_sequence.store(m_head + m_mask + 1, std::memory_order_release);
+                ++m_head;
+                return true;
+            }
+
+            size_t capacity() const { return m_mask + 1; }
+        };
+    } // namespace detail
+} // namespace soundcoe
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace soundcoe
+{
+    namespace detail
+    {
+        // Sample conversion kernels. They run with SSE2/AVX2/NEON when the target has them and fall back to
+        // scalar code otherwise. Input and output may alias as long as output starts at the same address.
+        namespace pcm
+        {
+            // [-1, 1] floats to 16-bit, rounded to nearest and saturated
+            void convertFloatToS16(const float *input, int16_t *output, size_t sampleCount);
+            // Full scale 32-bit integers to 16-bit, keeping the top 16 bits
+            void convertS32ToS16(const int32_t *input, int16_t *output, size_t sampleCount);
+
+            // Interleaved stereo to mono by averaging both channels
+            void downmixStereoToMono(const int16_t *input, int16_t *output, size_t frameCount);
+            void downmixStereoToMono(const float *input, float *output, size_t frameCount);
+
+            // Polyphase windowed-sinc resampling of interleaved audio. Output must hold
+            // getResampledFrameCount() frames and must not alias the input.
+            size_t getResampledFrameCount(size_t frameCount, int inputRate, int outputRate);
+            void resample(const int16_t *input, int16_t *output, size_t frameCount, size_t channels, int inputRate, int outputRate);
+            void resample(const float *input, float *output, size_t frameCount, size_t channels, int inputRate, int outputRate);
+        } // namespace pcm
+    } // namespace detail
+} // namespace soundcoe
\ No newline at end of file
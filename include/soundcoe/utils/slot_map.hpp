@@ -0,0 +1,314 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace soundcoe
+{
+    namespace detail
+    {
+        // Dense handle map: values live contiguously and a handle packs a slot index with the generation the slot had
+        // when the value was inserted. Erasing bumps the generation, so stale handles fail to resolve instead of
+        // aliasing whatever reuses the slot. Handle 0 is never produced.
+        //
+        // Not thread-safe, except reserve() and reserveCapacity() which any thread may call while the owner uses the
+        // map. Free slots form a lock-free stack whose head carries a tag against ABA, and slots live in blocks that
+        // never move, so growing does not disturb lookups. Only growing takes a lock.
+        template <typename T>
+        class SlotMap
+        {
+        public:
+            using value_type = std::pair<size_t, T>;
+
+        private:
+            static constexpr size_t INDEX_BITS = sizeof(size_t) * 4;
+            static constexpr size_t INDEX_MASK = (size_t(1) << INDEX_BITS) - 1;
+            static constexpr size_t GENERATION_MASK = ~size_t(0) >> INDEX_BITS;
+            static constexpr size_t NONE = INDEX_MASK;
+            static constexpr size_t FIRST_BLOCK_SIZE = 16;
+            static constexpr size_t MAX_BLOCKS = INDEX_BITS - 4; // block b holds FIRST_BLOCK_SIZE << b slots
+
+            struct Slot
+            {
+                size_t m_generation = 1;              // written by the owner only while the slot is off the free list
+                size_t m_entry = NONE;                // position in m_entries, NONE while the slot is free or reserved
+                std::atomic<size_t> m_nextFree{NONE}; // read by any thread popping the free list
+                std::atomic<bool> m_reserved{false};
+            };
+
+            std::atomic<Slot *> m_blocks[MAX_BLOCKS];
+            std::atomic<size_t> m_capacity{0};
+            std::atomic<size_t> m_freeHead{NONE}; // push/pop count above the index bits, top slot below
+            std::mutex m_growMutex;
+            std::vector<value_type> m_entries;
+
+            static size_t makeHandle(size_t index, size_t generation) { return (generation << INDEX_BITS) | index; }
+            static size_t indexOf(size_t handle) { return handle & INDEX_MASK; }
+            static size_t generationOf(size_t handle) { return handle >> INDEX_BITS; }
+            static size_t retag(size_t head, size_t index) { return (((head >> INDEX_BITS) + 1) << INDEX_BITS) | index; }
+
+            static size_t blockOf(size_t index)
+            {
+                size_t group = index / FIRST_BLOCK_SIZE + 1;
+                size_t block = 0;
+                while (group >>= 1)
+                    ++block;
+                return block;
+            }
+
+            Slot &slotAt(size_t index) const
+            {
+                size_t block = blockOf(index);
+                size_t first = FIRST_BLOCK_SIZE * ((size_t(1) << block) - 1);
+                return m_blocks[block].load(std::memory_order_acquire)[index - first];
+            }
+
+            Slot *resolve(size_t handle) const
+            {
+                size_t index = indexOf(handle);
+                if (index >= m_capacity.load(std::memory_order_acquire))
+                    return nullptr;
+                Slot &slot = slotAt(index);
+                if (slot.m_generation != generationOf(handle))
+                    return nullptr;
+                return &slot;
+            }
+
+            // Links first..last onto the free list, the slots in between must already point at each other
+            void pushFree(size_t first, size_t last)
+            {
+                size_t head = m_freeHead.load(std::memory_order_relaxed);
+                do
+                    slotAt(last).m_nextFree.store(indexOf(head), std::memory_order_relaxed);
+                while (!(m_freeHead.compare_exchange_weak(head, retag(head, first), std::memory_order_release,
+                                                          std::memory_order_relaxed)));
+            }
+
+            void release(size_t index)
+            {
+                Slot &slot = slotAt(index);
+                slot.m_generation = (slot.m_generation + 1) & GENERATION_MASK;
+                if (slot.m_generation == 0)
+                    slot.m_generation = 1;
+                slot.m_entry = NONE;
+                slot.m_reserved.store(false, std::memory_order_relaxed);
+                pushFree(index, index);
+            }
+
+            size_t popFree()
+            {
+                size_t head = m_freeHead.load(std::memory_order_acquire);
+                while (indexOf(head) != NONE)
+                {
+                    // The slot may be popped by another thread meanwhile, the tag then fails the exchange
+                    size_t next = slotAt(indexOf(head)).m_nextFree.load(std::memory_order_relaxed);
+                    if (m_freeHead.compare_exchange_weak(head, retag(head, next), std::memory_order_acquire))
+                        return indexOf(head);
+                }
+                return NONE;
+            }
+
+            // Caller holds m_growMutex
+            void growTo(size_t minimum)
+            {
+                size_t capacity = m_capacity.load(std::memory_order_relaxed);
+                while (capacity < minimum)
+                {
+                    size_t block = blockOf(capacity);
+                    if (block >= MAX_BLOCKS)
+                        return;
+
+                    size_t size = FIRST_BLOCK_SIZE << block;
+                    Slot *slots = new Slot[size];
+                    for (size_t i = 0; i + 1 < size; ++i)
+                        slots[i].m_nextFree.store(capacity + i + 1, std::memory_order_relaxed);
+                    m_blocks[block].store(slots, std::memory_order_release);
+                    m_capacity.store(capacity + size, std::memory_order_release);
+                    pushFree(capacity, capacity + size - 1);
+                    capacity += size;
+                }
+            }
+
+            size_t popOrGrow()
+            {
+                size_t index = popFree();
+                if (index != NONE)
+                    return index;
+
+                {
+                    std::lock_guard<std::mutex> lock(m_growMutex);
+                    if (indexOf(m_freeHead.load(std::memory_order_acquire)) == NONE)
+                        growTo(m_capacity.load(std::memory_order_relaxed) + 1);
+                }
+                return popFree();
+            }
+
+            template <typename Map, typename Value>
+            class BasicIterator
+            {
+                Map *m_map;
+                size_t m_position;
+
+            public:
+                BasicIterator(Map *map, size_t position) : m_map(map), m_position(position) {}
+
+                Value &operator*() const { return m_map->m_entries[m_position]; }
+                Value *operator->() const { return &m_map->m_entries[m_position]; }
+                BasicIterator &operator++()
+                {
+                    ++m_position;
+                    return *this;
+                }
+                bool operator==(const BasicIterator &other) const { return m_position == other.m_position; }
+                bool operator!=(const BasicIterator &other) const { return m_position != other.m_position; }
+
+                size_t position() const { return m_position; }
+            };
+
+        public:
+            using iterator = BasicIterator<SlotMap, value_type>;
+            using const_iterator = BasicIterator<const SlotMap, const value_type>;
+
+            SlotMap()
+            {
+                for (auto &block : m_blocks)
+                    block.store(nullptr, std::memory_order_relaxed);
+            }
+            ~SlotMap()
+            {
+                for (auto &block : m_blocks)
+                    delete[] block.load(std::memory_order_relaxed);
+            }
+            SlotMap(const SlotMap &) = delete;
+            SlotMap &operator=(const SlotMap &) = delete;
+
+            size_t insert(T &&value)
+            {
+                size_t index = popOrGrow();
+                if (index == NONE)
+                    throw std::length_error("SlotMap::insert: Every slot index is in use");
+                Slot &slot = slotAt(index);
+                size_t handle = makeHandle(index, slot.m_generation);
+                slot.m_entry = m_entries.size();
+                m_entries.emplace_back(handle, std::move(value));
+                return handle;
+            }
+
+            // Hands out a handle before its value exists, 0 when no slot is free and growing is not allowed. Lock-free
+            // unless it has to grow.
+            size_t reserve(bool allowGrowth)
+            {
+                size_t index = allowGrowth ? popOrGrow() : popFree();
+                if (index == NONE)
+                    return 0;
+
+                Slot &slot = slotAt(index);
+                slot.m_reserved.store(true, std::memory_order_relaxed);
+                return makeHandle(index, slot.m_generation);
+            }
+
+            // Makes room for at least count values, so later inserts and reservations do not have to grow
+            void reserveCapacity(size_t count)
+            {
+                std::lock_guard<std::mutex> lock(m_growMutex);
+                growTo(count);
+            }
+
+            size_t capacity() const { return m_capacity.load(std::memory_order_acquire); }
+
+            bool isReserved(size_t handle) const
+            {
+                const Slot *slot = resolve(handle);
+                return slot && slot->m_reserved.load(std::memory_order_relaxed);
+            }
+
+            // Fills a slot handed out by reserve(), false when the reservation was cancelled or cleared
+            bool insert(size_t handle, T &&value)
+            {
+                Slot *slot = resolve(handle);
+                if (!slot || !(slot->m_reserved.load(std::memory_order_relaxed)))
+                    return false;
+                slot->m_reserved.store(false, std::memory_order_relaxed);
+                slot->m_entry = m_entries.size();
+                m_entries.emplace_back(handle, std::move(value));
+                return true;
+            }
+
+            void cancel(size_t handle)
+            {
+                const Slot *slot = resolve(handle);
+                if (slot && slot->m_reserved.load(std::memory_order_relaxed))
+                    release(indexOf(handle));
+            }
+
+            iterator find(size_t handle)
+            {
+                const Slot *slot = resolve(handle);
+                if (!slot || slot->m_entry == NONE)
+                    return end();
+                return iterator(this, slot->m_entry);
+            }
+
+            const_iterator find(size_t handle) const
+            {
+                const Slot *slot = resolve(handle);
+                if (!slot || slot->m_entry == NONE)
+                    return end();
+                return const_iterator(this, slot->m_entry);
+            }
+
+            bool contains(size_t handle) const { return find(handle) != end(); }
+
+            // The last value moves into the erased position, the returned iterator points at it so loops that erase
+            // while iterating still visit every value once
+            iterator erase(iterator it)
+            {
+                size_t position = it.position();
+                size_t index = indexOf(m_entries[position].first);
+                if (position + 1 != m_entries.size())
+                {
+                    m_entries[position] = std::move(m_entries.back());
+                    slotAt(indexOf(m_entries[position].first)).m_entry = position;
+                }
+                m_entries.pop_back();
+
+                release(index);
+                return iterator(this, position);
+            }
+
+            size_t erase(size_t handle)
+            {
+                auto it = find(handle);
+                if (it == end())
+                    return 0;
+                erase(it);
+                return 1;
+            }
+
+            // Every live and reserved handle goes stale, slots are kept for reuse
+            void clear()
+            {
+                for (const auto &entry : m_entries)
+                    release(indexOf(entry.first));
+                m_entries.clear();
+
+                size_t capacity = m_capacity.load(std::memory_order_acquire);
+                for (size_t i = 0; i < capacity; ++i)
+                    if (slotAt(i).m_reserved.load(std::memory_order_relaxed))
+                        release(i);
+            }
+
+            iterator begin() { return iterator(this, 0); }
+            iterator end() { return iterator(this, m_entries.size()); }
+            const_iterator begin() const { return const_iterator(this, 0); }
+            const_iterator end() const { return const_iterator(this, m_entries.size()); }
+
+            size_t size() const { return m_entries.size(); }
+            bool empty() const { return m_entries.empty(); }
+        };
+    } // namespace detail
+} // namespace soundcoe
\ No newline at end of file
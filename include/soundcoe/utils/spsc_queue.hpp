@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace soundcoe
+{
+    namespace detail
+    {
+        // Bounded lock-free queue for exactly one producer thread and one consumer thread.
+        // The capacity is rounded up to a power of two so indices wrap with a mask.
+        template <typename T>
+        class SpscQueue
+        {
+            static constexpr size_t CACHE_LINE_SIZE = 64;
+
+            std::vector<T> m_slots;
+            size_t m_mask;
+            alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_head; // next slot to pop, written by the consumer
+            alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_tail; // next slot to push, written by the producer
+
+            static size_t roundUpToPowerOfTwo(size_t value)
+            {
+                size_t result = 1;
+                while (result < value)
+                    result <<= 1;
+                return result;
+            }
+
+        public:
+            explicit SpscQueue(size_t capacity)
+                : m_slots(roundUpToPowerOfTwo(capacity < 1 ? 1 : capacity)), m_mask(m_slots.size() - 1),
+                  m_head(0), m_tail(0) { }
+            SpscQueue(const SpscQueue &) = delete;
+            SpscQueue &operator=(const SpscQueue &) = delete;
+
+            bool tryPush(T &&value)
+            {
+                size_t tail = m_tail.load(std::memory_order_relaxed);
+                if (tail - m_head.load(std::memory_order_acquire) == m_slots.size())
+                    return false;
+
+                m_slots[tail & m_mask] = std::move(value);
+                m_tail.store(tail + 1, std::memory_order_release);
+                return true;
+            }
+
+            bool tryPop(T &value)
+            {
+                size_t head = m_head.load(std::memory_order_relaxed);
+                if (head == m_tail.load(std::memory_order_acquire))
+                    return false;
+
+                value = std::move(m_slots[head & m_mask]);
+                m_head.store(head + 1, std::memory_order_release);
+                return true;
+            }
+
+            size_t size() const
+            {
+                return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+            }
+
+            bool empty() const { return size() == 0; }
+
+            size_t capacity() const { return m_slots.size(); }
+        };
+    } // namespace detail
+} // namespace soundcoe
\ No newline at end of file
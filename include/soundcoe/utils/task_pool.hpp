@@ -0,0 +1,42 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace soundcoe
+{
+    namespace detail
+    {
+        // Fixed set of worker threads running submitted tasks in FIFO order.
+        class TaskPool
+        {
+            std::vector<std::thread> m_threads;
+            std::deque<std::function<void()>> m_tasks;
+            std::mutex m_mutex;
+            std::condition_variable m_condition;
+            bool m_running = false;
+
+            void run();
+
+        public:
+            TaskPool() = default;
+            TaskPool(const TaskPool &) = delete;
+            TaskPool &operator=(const TaskPool &) = delete;
+            ~TaskPool();
+
+            static size_t defaultThreadCount();
+
+            void start(size_t threadCount = defaultThreadCount());
+            void stop();
+            bool isRunning();
+            size_t getThreadCount() const;
+            size_t getPendingTaskCount();
+
+            bool submit(std::function<void()> task);
+        };
+    } // namespace detail
+} // namespace soundcoe
\ No newline at end of file
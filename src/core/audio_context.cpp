@@ -74,6 +74,29 @@ namespace soundcoe
                 }
             }
 
+            m_float32Supported = alIsExtensionPresent("AL_EXT_FLOAT32") == AL_TRUE;
+            logcoe::debug(std::string("AudioContext::initialize: AL_EXT_FLOAT32 ") + (m_float32Supported ? "available" : "not available"));
+            m_ima4Supported = alIsExtensionPresent("AL_EXT_IMA4") == AL_TRUE;
+            m_msAdpcmSupported = alIsExtensionPresent("AL_SOFT_MSADPCM") == AL_TRUE;
+            logcoe::debug(std::string("AudioContext::initialize: AL_EXT_IMA4 ") + (m_ima4Supported ? "available" : "not available") +
+                          ", AL_SOFT_MSADPCM " + (m_msAdpcmSupported ? "available" : "not available"));
+            if (alIsExtensionPresent("AL_SOFT_deferred_updates") == AL_TRUE)
+            {
+                m_alDeferUpdates = reinterpret_cast<LPALDEFERUPDATESSOFT>(alGetProcAddress("alDeferUpdatesSOFT"));
+                m_alProcessUpdates = reinterpret_cast<LPALPROCESSUPDATESSOFT>(alGetProcAddress("alProcessUpdatesSOFT"));
+                if (!m_alDeferUpdates || !m_alProcessUpdates)
+                {
+                    m_alDeferUpdates = nullptr;
+                    m_alProcessUpdates = nullptr;
+                }
+            }
+            logcoe::debug(std::string("AudioContext::initialize: AL_SOFT_deferred_updates ") +
+                          (m_alDeferUpdates ? "available" : "not available"));
+            alcGetIntegerv(m_device, ALC_FREQUENCY, 1, &m_deviceFrequency);
+            if (ErrorHandler::checkALCError(m_device, "Get Device Frequency"))
+                m_deviceFrequency = 0;
+            logcoe::debug("AudioContext::initialize: Device mixes at " + std::to_string(m_deviceFrequency) + " Hz");
+
             m_initialized = true;
             logcoe::info("AudioContext::initialize: AudioContext initialized successfully");
             ErrorHandler::clearALCError(m_device);
@@ -103,6 +126,13 @@ namespace soundcoe
                 ErrorHandler::throwOnALCError(m_device, "Close Device");
             logcoe::debug("AudioContext::shutdown: Close Device succeed");
             m_device = nullptr;
+            m_float32Supported = false;
+            m_ima4Supported = false;
+            m_alDeferUpdates = nullptr;
+            m_alProcessUpdates = nullptr;
+            m_suspendDepth = 0;
+            m_msAdpcmSupported = false;
+            m_deviceFrequency = 0;
             m_initialized = false;
             logcoe::info("AudioContext::shutdown: AudioContext shutdown complete successfully");
         }
@@ -124,5 +154,70 @@ namespace soundcoe
             std::lock_guard<std::mutex> lock(m_mutex);
             return m_context;
         }
+
+        bool AudioContext::isFloat32Supported() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_float32Supported;
+        }
+
+        bool AudioContext::isIma4Supported() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_ima4Supported;
+        }
+
+        bool AudioContext::isMsAdpcmSupported() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_msAdpcmSupported;
+        }
+
+        ALCint AudioContext::getDeviceFrequency() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_deviceFrequency;
+        }
+
+        bool AudioContext::isDeferredUpdatesSupported() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_alDeferUpdates != nullptr;
+        }
+
+        void AudioContext::suspendUpdates()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_initialized)
+                return;
+
+            // Source and listener changes made until the outermost processUpdates() reach the mixer together
+            if (m_suspendDepth++ > 0)
+                return;
+            if (m_alDeferUpdates)
+                m_alDeferUpdates();
+            else
+                alcSuspendContext(m_context);
+        }
+
+        void AudioContext::processUpdates()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_initialized || m_suspendDepth == 0)
+                return;
+
+            if (--m_suspendDepth > 0)
+                return;
+            if (m_alProcessUpdates)
+                m_alProcessUpdates();
+            else
+                alcProcessContext(m_context);
+        }
+
+        bool AudioContext::isUpdatesSuspended() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_suspendDepth > 0;
+        }
     } // namespace detail
 } // namespace soundcoe
\ No newline at end of file
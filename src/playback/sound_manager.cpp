@@ -1,17 +1,120 @@
 #include <soundcoe/playback/sound_manager.hpp>
 #include <soundcoe/core/error_handler.hpp>
+#include <soundcoe/utils/math.hpp>
 #include <AL/al.h>
+#include <AL/alext.h>
 #include <logcoe.hpp>
 #include <functional>
 #include <filesystem>
 #include <algorithm>
+#include <cmath>
+#include <thread>
 
 namespace soundcoe
 {
     namespace detail
     {
+        // The arrays never overlap, saying so lets the compiler vectorize without runtime alias checks. There is
+        // no branch in the body, the finished fades are sorted out afterwards by the caller.
+        static void advanceFades(size_t count, float deltaTime, float gainScale, float *__restrict elapsed,
+                                 const float *__restrict duration, const float *__restrict startVolume,
+                                 const float *__restrict targetVolume, float *__restrict volume,
+                                 float *__restrict gain, uint8_t *__restrict finished)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                float time = elapsed[i] + deltaTime;
+                float progress = std::min(time / duration[i], 1.0f);
+                float current = startVolume[i] + (targetVolume[i] - startVolume[i]) * progress;
+                elapsed[i] = time;
+                volume[i] = current;
+                gain[i] = current * gainScale;
+                finished[i] = time >= duration[i];
+            }
+        }
+
+        size_t FadeTable::add(size_t handle)
+        {
+            m_handles.push_back(handle);
+            m_elapsed.push_back(0.0f);
+            m_duration.push_back(0.0f);
+            m_startVolume.push_back(0.0f);
+            m_targetVolume.push_back(0.0f);
+            m_volume.push_back(0.0f);
+            m_gain.push_back(0.0f);
+            m_appliedGain.push_back(-1.0f);
+            m_finished.push_back(0);
+            return m_handles.size() - 1;
+        }
+
+        void FadeTable::restart(size_t index, float startVolume, float targetVolume, float duration)
+        {
+            m_elapsed[index] = 0.0f;
+            m_duration[index] = duration;
+            m_startVolume[index] = startVolume;
+            m_targetVolume[index] = targetVolume;
+            m_volume[index] = startVolume;
+            m_appliedGain[index] = -1.0f;
+            m_finished[index] = 0;
+        }
+
+        size_t FadeTable::remove(size_t index)
+        {
+            size_t last = m_handles.size() - 1;
+            size_t moved = 0;
+            if (index != last)
+            {
+                moved = m_handles[last];
+                m_handles[index] = m_handles[last];
+                m_elapsed[index] = m_elapsed[last];
+                m_duration[index] = m_duration[last];
+                m_startVolume[index] = m_startVolume[last];
+                m_targetVolume[index] = m_targetVolume[last];
+                m_volume[index] = m_volume[last];
+                m_gain[index] = m_gain[last];
+                m_appliedGain[index] = m_appliedGain[last];
+                m_finished[index] = m_finished[last];
+            }
+            m_handles.pop_back();
+            m_elapsed.pop_back();
+            m_duration.pop_back();
+            m_startVolume.pop_back();
+            m_targetVolume.pop_back();
+            m_volume.pop_back();
+            m_gain.pop_back();
+            m_appliedGain.pop_back();
+            m_finished.pop_back();
+            return moved;
+        }
+
+        void FadeTable::advance(float deltaTime, float gainScale)
+        {
+            advanceFades(m_handles.size(), deltaTime, gainScale, m_elapsed.data(), m_duration.data(),
+                         m_startVolume.data(), m_targetVolume.data(), m_volume.data(), m_gain.data(), m_finished.data());
+        }
+
+        void FadeTable::invalidate()
+        {
+            std::fill(m_appliedGain.begin(), m_appliedGain.end(), -1.0f);
+        }
+
+        void FadeTable::clear()
+        {
+            m_handles.clear();
+            m_elapsed.clear();
+            m_duration.clear();
+            m_startVolume.clear();
+            m_targetVolume.clear();
+            m_volume.clear();
+            m_gain.clear();
+            m_appliedGain.clear();
+            m_finished.clear();
+        }
+
         void SoundManager::updateAllSoundsVolume()
         {
+            // Fading voices were just set to their base volume, the next fade pass has to overwrite it
+            m_soundFades.invalidate();
             updateAllAudioProperty(m_activeSounds, [](std::unique_ptr<SoundSource> &audio, float value)
                                    { audio->setVolume(value); }, [&](const ActiveAudio &audio)
                                    { return (m_soundsMute || m_mute) ? 0.0f : audio.m_baseVolume; }, m_masterVolume, m_masterSoundsVolume);
@@ -19,6 +122,7 @@ namespace soundcoe
 
         void SoundManager::updateAllMusicVolume()
         {
+            m_musicFades.invalidate();
             updateAllAudioProperty(m_activeMusic, [](std::unique_ptr<SoundSource> &audio, float value)
                                    { audio->setVolume(value); }, [&](const ActiveAudio &audio)
                                    { return (m_musicMute || m_mute) ? 0.0f : audio.m_baseVolume; }, m_masterVolume, m_masterMusicVolume);
@@ -90,7 +194,25 @@ namespace soundcoe
             return false;
         }
 
-        bool SoundManager::fadeToVolume(std::unordered_map<size_t, ActiveAudio> &activeAudio, size_t handle,
+        bool SoundManager::virtualizeIfStolen(ActiveAudio &audio)
+        {
+            if (audio.m_virtual)
+                return false;
+
+            auto sourceAllocation = m_resourceManager.getSourceAllocation(audio.m_sourceIndex);
+            if (!(sourceAllocation.has_value()) || !(sourceAllocation.value().get().m_active) ||
+                sourceAllocation.value().get().m_allocatedTime == audio.m_sourceAllocatedTime)
+                return false;
+
+            // The source plays a more important sound now, the handle must not reach it
+            if (audio.m_stream || m_virtualVoiceCount >= m_maxVirtualVoices)
+                return false;
+            audio.m_virtual = true;
+            ++m_virtualVoiceCount;
+            return true;
+        }
+
+        bool SoundManager::fadeToVolume(SlotMap<ActiveAudio> &activeAudio, size_t handle,
                                         float targetVolume, float duration, const std::string &method)
         {
             auto it = activeAudio.find(handle);
@@ -104,27 +226,33 @@ namespace soundcoe
                 return setError("SoundManager::" + method + ": Fade target volume must be non-negative");
 
             ActiveAudio &audio = it->second;
-
-            auto sourceAllocation = m_resourceManager.getSourceAllocation(audio.m_sourceIndex);
-            if (!(sourceAllocation.has_value()) || !(sourceAllocation.value().get().m_active))
+            virtualizeIfStolen(audio);
+            if (audio.m_virtual)
             {
-                activeAudio.erase(it);
-                return setError("SoundManager::" + method + ": Audio source is no longer active");
+                if (audio.m_paused)
+                    return setError("SoundManager::" + method + ": Cannot fadeToVolume audio that is not playing.");
             }
+            else
+            {
+                auto sourceAllocation = m_resourceManager.getSourceAllocation(audio.m_sourceIndex);
+                if (!(sourceAllocation.has_value()) || !(sourceAllocation.value().get().m_active))
+                {
+                    activeAudio.erase(it);
+                    return setError("SoundManager::" + method + ": Audio source is no longer active");
+                }
+                if (sourceAllocation.value().get().m_allocatedTime != audio.m_sourceAllocatedTime)
+                    return setError("SoundManager::" + method + ": Audio source was taken by a higher priority sound");
 
-            auto &source = sourceAllocation.value().get().m_source;
-            if (!(source->isPlaying()))
-                return setError("SoundManager::" + method + ": Cannot fadeToVolume audio that is not playing.");
-
-            audio.m_isFading = true;
-            audio.m_fadeStartVolume = audio.m_baseVolume;
-            audio.m_fadeTargetVolume = targetVolume;
-            audio.m_fadeDuration = duration;
-            audio.m_fadeElapsed = 0.0f;
+                auto &source = sourceAllocation.value().get().m_source;
+                if (!(source->isPlaying()))
+                    return setError("SoundManager::" + method + ": Cannot fadeToVolume audio that is not playing.");
+            }
+
+            startFade(activeAudio, handle, audio, audio.m_baseVolume, targetVolume, duration);
             return true;
         }
 
-        bool SoundManager::fade(std::unordered_map<size_t, ActiveAudio> &activeAudio, size_t handle,
+        bool SoundManager::fade(SlotMap<ActiveAudio> &activeAudio, size_t handle,
                                 bool fadeIn, float duration, const std::string &method)
         {
             auto it = activeAudio.find(handle);
@@ -135,27 +263,34 @@ namespace soundcoe
                 return setError("SoundManager::" + method + ": Fade duration must be positive");
 
             ActiveAudio &audio = it->second;
-
-            auto sourceAllocation = m_resourceManager.getSourceAllocation(audio.m_sourceIndex);
-            if (!(sourceAllocation.has_value()) || !(sourceAllocation.value().get().m_active))
+            virtualizeIfStolen(audio);
+            if (audio.m_virtual)
             {
-                activeAudio.erase(it);
-                return setError("SoundManager::" + method + ": Audio source is no longer active");
+                if (!fadeIn && audio.m_paused)
+                    return setError("SoundManager::" + method + ": Cannot fade out audio that is not playing.");
             }
+            else
+            {
+                auto sourceAllocation = m_resourceManager.getSourceAllocation(audio.m_sourceIndex);
+                if (!(sourceAllocation.has_value()) || !(sourceAllocation.value().get().m_active))
+                {
+                    activeAudio.erase(it);
+                    return setError("SoundManager::" + method + ": Audio source is no longer active");
+                }
+                if (sourceAllocation.value().get().m_allocatedTime != audio.m_sourceAllocatedTime)
+                    return setError("SoundManager::" + method + ": Audio source was taken by a higher priority sound");
 
-            auto &source = sourceAllocation.value().get().m_source;
-            if (!fadeIn && !(source->isPlaying()))
-                return setError("SoundManager::" + method + ": Cannot fade out audio that is not playing.");
-
-            audio.m_isFading = true;
-            audio.m_fadeStartVolume = fadeIn ? 0.0f : audio.m_baseVolume;
-            audio.m_fadeTargetVolume = fadeIn ? audio.m_baseVolume : 0.0f;
-            audio.m_fadeDuration = duration;
-            audio.m_fadeElapsed = 0.0f;
+                auto &source = sourceAllocation.value().get().m_source;
+                if (!fadeIn && !(source->isPlaying()))
+                    return setError("SoundManager::" + method + ": Cannot fade out audio that is not playing.");
+            }
+
+            startFade(activeAudio, handle, audio, fadeIn ? 0.0f : audio.m_baseVolume, fadeIn ? audio.m_baseVolume : 0.0f,
+                      duration);
             return true;
         }
 
-        bool SoundManager::checkAudioState(std::unordered_map<size_t, ActiveAudio> &activeAudio, size_t handle,
+        bool SoundManager::checkAudioState(SlotMap<ActiveAudio> &activeAudio, size_t handle,
                                            SoundState state, const std::string &method)
         {
             m_lastError = "";
@@ -166,12 +301,18 @@ namespace soundcoe
                 return setError("SoundManager::" + method + ": Invalid handle");
 
             ActiveAudio &audio = it->second;
+            virtualizeIfStolen(audio);
+            if (audio.m_virtual)
+                return state == SoundState::Paused ? audio.m_paused : state == SoundState::Playing && !audio.m_paused;
+
             auto sourceAllocation = m_resourceManager.getSourceAllocation(audio.m_sourceIndex);
             if (!(sourceAllocation.has_value()) || !(sourceAllocation.value().get().m_active))
             {
                 activeAudio.erase(it);
                 return setError("SoundManager::" + method + ": Audio source is no longer active");
             }
+            if (sourceAllocation.value().get().m_allocatedTime != audio.m_sourceAllocatedTime)
+                return setError("SoundManager::" + method + ": Audio source was taken by a higher priority sound");
 
             auto &source = sourceAllocation.value().get().m_source;
             if (state == SoundState::Playing)
@@ -184,7 +325,7 @@ namespace soundcoe
             return setError("SoundManager::" + method + ": Internal error - Invalid operation type");
         }
 
-        bool SoundManager::setAudioProperty(std::unordered_map<size_t, ActiveAudio> &activeAudio, size_t handle,
+        bool SoundManager::setAudioProperty(SlotMap<ActiveAudio> &activeAudio, size_t handle,
                                             PropertyType type, const std::string &method,
                                             float value, float y, float z)
         {
@@ -193,17 +334,37 @@ namespace soundcoe
                 return setError("SoundManager::" + method + ": Invalid handle");
 
             ActiveAudio &audio = it->second;
+            virtualizeIfStolen(audio);
+            Vec3 vec;
+            if (type == PropertyType::Position || type == PropertyType::Velocity)
+                vec = {value, y, z};
+
+            // Kept on the handle so the voice sounds the same after it moves to another source
+            if (type == PropertyType::Volume)
+            {
+                audio.m_baseVolume = value;
+                if (audio.m_fadeIndex != NO_FADE)
+                    getFades(activeAudio).m_appliedGain[audio.m_fadeIndex] = -1.0f;
+            }
+            else if (type == PropertyType::Pitch)
+                audio.m_basePitch = value;
+            else if (type == PropertyType::Position)
+                audio.m_position = vec;
+            else if (type == PropertyType::Velocity)
+                audio.m_velocity = vec;
+            if (audio.m_virtual)
+                return true;
+
             auto sourceAllocation = m_resourceManager.getSourceAllocation(audio.m_sourceIndex);
             if (!(sourceAllocation.has_value()) || !(sourceAllocation.value().get().m_active))
             {
                 activeAudio.erase(it);
                 return setError("SoundManager::" + method + ": Audio source is no longer active");
             }
+            if (sourceAllocation.value().get().m_allocatedTime != audio.m_sourceAllocatedTime)
+                return setError("SoundManager::" + method + ": Audio source was taken by a higher priority sound");
 
             auto &source = sourceAllocation.value().get().m_source;
-            Vec3 vec;
-            if (type == PropertyType::Position || type == PropertyType::Velocity)
-                vec = {value, y, z};
 
             if (type == PropertyType::Volume)
                 return source->setVolume(value);
@@ -217,7 +378,7 @@ namespace soundcoe
             return setError("SoundManager::" + method + ": Internal error - Invalid PropertyType");
         }
 
-        bool SoundManager::audioOperation(std::unordered_map<size_t, ActiveAudio> &activeAudio, size_t handle,
+        bool SoundManager::audioOperation(SlotMap<ActiveAudio> &activeAudio, size_t handle,
                                           SoundState operation, const std::string &method)
         {
             auto it = activeAudio.find(handle);
@@ -225,25 +386,47 @@ namespace soundcoe
                 return setError("SoundManager::" + method + ": Invalid handle");
 
             ActiveAudio &audio = it->second;
+            virtualizeIfStolen(audio);
+            if (audio.m_virtual)
+            {
+                if (operation == SoundState::Stopped)
+                {
+                    releaseAudioBuffer(audio);
+                    activeAudio.erase(it);
+                    --m_virtualVoiceCount;
+                }
+                else
+                    audio.m_paused = operation == SoundState::Paused;
+                return true;
+            }
+
             auto sourceAllocation = m_resourceManager.getSourceAllocation(audio.m_sourceIndex);
             if (!(sourceAllocation.has_value()) || !(sourceAllocation.value().get().m_active))
             {
                 activeAudio.erase(it);
                 return setError("SoundManager::" + method + ": Audio source is no longer active");
             }
+            if (sourceAllocation.value().get().m_allocatedTime != audio.m_sourceAllocatedTime)
+                return setError("SoundManager::" + method + ": Audio source was taken by a higher priority sound");
 
             auto &source = sourceAllocation.value().get().m_source;
             if (operation == SoundState::Playing)
+            {
+                audio.m_paused = false;
                 return source->play();
+            }
             if (operation == SoundState::Paused)
+            {
+                audio.m_paused = true;
                 return source->pause();
+            }
             if (operation == SoundState::Stopped)
             {
                 bool succeed = source->stop();
                 if (succeed)
                 {
                     m_resourceManager.releaseSource(*source);
-                    m_resourceManager.releaseBuffer(audio.m_filename);
+                    releaseAudioBuffer(audio);
                     activeAudio.erase(it);
                 }
                 return succeed;
@@ -252,12 +435,29 @@ namespace soundcoe
             return setError("SoundManager::" + method + ": Internal error - Invalid operation type");
         }
 
-        bool SoundManager::audioOperationAll(std::unordered_map<size_t, ActiveAudio> &activeAudio, SoundState operation,
+        bool SoundManager::audioOperationAll(SlotMap<ActiveAudio> &activeAudio, SoundState operation,
                                              const std::string &method)
         {
+            DeferredUpdates deferred(m_resourceManager);
             for (auto it = activeAudio.begin(); it != activeAudio.end();)
             {
                 ActiveAudio &audio = it->second;
+                virtualizeIfStolen(audio);
+                if (audio.m_virtual)
+                {
+                    if (operation == SoundState::Stopped)
+                    {
+                        releaseAudioBuffer(audio);
+                        it = activeAudio.erase(it);
+                        --m_virtualVoiceCount;
+                        continue;
+                    }
+                    if (operation == SoundState::Playing || operation == SoundState::Paused)
+                        audio.m_paused = operation == SoundState::Paused;
+                    ++it;
+                    continue;
+                }
+
                 auto sourceAllocation = m_resourceManager.getSourceAllocation(audio.m_sourceIndex);
                 if (!(sourceAllocation.has_value()) || !(sourceAllocation.value().get().m_active))
                 {
@@ -265,6 +465,12 @@ namespace soundcoe
                     it = activeAudio.erase(it);
                     continue;
                 }
+                if (sourceAllocation.value().get().m_allocatedTime != audio.m_sourceAllocatedTime)
+                {
+                    logcoe::warning("SoundManager::" + method + ": handle " + std::to_string(it->first) + " lost its source");
+                    ++it;
+                    continue;
+                }
 
                 auto &source = sourceAllocation.value().get().m_source;
                 bool success = false;
@@ -274,22 +480,28 @@ namespace soundcoe
                         success = source->play();
                     else
                         logcoe::warning("SoundManager::" + method + ": handle " + std::to_string(it->first) + " is not paused");
+                    audio.m_paused = false;
                 }
                 else if (operation == SoundState::Paused)
+                {
                     success = source->pause();
+                    audio.m_paused = true;
+                }
                 else if (operation == SoundState::Stopped)
                 {
                     success = source->stop();
                     if (success)
                     {
                         m_resourceManager.releaseSource(*source);
-                        m_resourceManager.releaseBuffer(audio.m_filename);
+                        releaseAudioBuffer(audio);
                         it = activeAudio.erase(it);
                         continue;
                     }
                 }
                 else
+                {
                     return setError("SoundManager::" + method + ": Internal error - Invalid operation type");
+                }
 
                 if (!success)
                     logcoe::warning("SoundManager::" + method + ": Failed to operate on handle - " + std::to_string(it->first));
@@ -300,308 +512,1137 @@ namespace soundcoe
             return true;
         }
 
-        size_t SoundManager::play(std::unordered_map<size_t, ActiveAudio> &activeAudio, const std::string &filename,
-                                  float volume, float pitch, bool loop, SoundPriority priority,
-                                  std::atomic<size_t> &nextHandle, const std::string &method,
+        size_t SoundManager::play(SlotMap<ActiveAudio> &activeAudio, const std::string &filename, SoundId id,
+                                  float volume, float pitch, bool loop, SoundPriority priority, const std::string &method,
                                   float masterCategoryVolume, float masterCategoryPitch,
-                                  bool is3D, const Vec3 &position, const Vec3 &velocity)
+                                  bool is3D, const Vec3 &position, const Vec3 &velocity, float maxDistance,
+                                  size_t reservedHandle)
         {
-            auto buffer = m_resourceManager.getBuffer(filename);
+            // A queued play whose reservation was dropped by shutdown() has nothing left to fill
+            if (reservedHandle != INVALID_SOUND_HANDLE && !(activeAudio.isReserved(reservedHandle)))
+                return INVALID_SOUND_HANDLE;
+
+            // Sounds out of hearing range never reach OpenAL: one-shots are dropped, loops wait as virtual voices
+            bool inaudible = is3D && estimateGain(volume, position, maxDistance) < m_audibilityThreshold;
+            if (inaudible && !loop)
+            {
+                logcoe::debug("SoundManager::" + method + ": Culled a one-shot out of hearing range");
+                return INVALID_SOUND_HANDLE;
+            }
+
+            // A registered SoundId goes straight to its cache entry, without building or resolving a path
+            auto buffer = id.isValid() ? m_resourceManager.getBuffer(id, priority) : m_resourceManager.getBuffer(filename, priority);
             if (!(buffer.has_value()))
             {
                 logcoe::error("SoundManager::" + method + ": Failed to load the sound file");
                 return INVALID_SOUND_HANDLE;
             }
+            const std::string &name = id.isValid() ? buffer->get().getFileName() : filename;
 
+            ActiveAudio audio;
+            audio.m_filename = filename;
+            audio.m_soundId = id;
+            audio.m_priority = priority;
+            audio.m_baseVolume = volume;
+            audio.m_basePitch = pitch;
+            audio.m_loop = loop;
+            audio.m_is3D = is3D;
+            audio.m_position = position;
+            audio.m_velocity = velocity;
+            audio.m_maxDistance = maxDistance;
+            audio.m_duration = buffer->get().getDuration();
+
+            bool stream = buffer->get().isStreaming();
             size_t poolIndex;
-            auto source = m_resourceManager.acquireSource(poolIndex, priority);
+            std::optional<std::reference_wrapper<SoundSource>> source;
+            if (!inaudible)
+                source = m_resourceManager.acquireSource(poolIndex, priority);
             if (!(source.has_value()))
             {
-                logcoe::error("SoundManager::" + method + ": Failed to acquire source");
-                m_resourceManager.releaseBuffer(buffer.value());
+                // Every source plays something at least as important, or the sound cannot be heard yet: it starts as
+                // a virtual voice and keeps its buffer reference until it gets a source or finishes
+                if (!stream && m_virtualVoiceCount < m_maxVirtualVoices)
+                {
+                    audio.m_virtual = true;
+                    ++m_virtualVoiceCount;
+                    if (reservedHandle == INVALID_SOUND_HANDLE)
+                        return activeAudio.insert(std::move(audio));
+                    activeAudio.insert(reservedHandle, std::move(audio));
+                    return reservedHandle;
+                }
+
+                if (inaudible)
+                    logcoe::debug("SoundManager::" + method + ": Culled a sound out of hearing range");
+                else
+                    logcoe::error("SoundManager::" + method + ": Failed to acquire source");
+                m_resourceManager.releaseBuffer(buffer.value(), priority);
                 return INVALID_SOUND_HANDLE;
             }
 
+            std::unique_ptr<SoundStream> soundStream;
             try
             {
-                source->get().attachBuffer(buffer->get());
+                if (stream)
+                {
+                    soundStream = std::make_unique<SoundStream>(buffer->get().getFileName(), loop, &m_streamWorker,
+                                                                m_streamReadAhead);
+                    if (!(soundStream->start(source->get())))
+                        throw std::runtime_error("Failed to queue the stream buffers");
+                }
+                else
+                    m_resourceManager.attachBuffer(poolIndex, buffer.value());
             }
             catch (const std::exception &e)
             {
                 logcoe::error("SoundManager::" + method + ": Failed to attach buffer: " + std::string(e.what()));
                 m_resourceManager.releaseSource(source.value());
-                m_resourceManager.releaseBuffer(buffer.value());
+                m_resourceManager.releaseBuffer(buffer.value(), priority);
                 return INVALID_SOUND_HANDLE;
             }
 
             if (!(source->get().setVolume(volume * m_masterVolume * masterCategoryVolume)))
-                logcoe::warning("SoundManager::" + method + ": Failed to set volume for " + filename);
+                logcoe::warning("SoundManager::" + method + ": Failed to set volume for " + name);
             if (!(source->get().setPitch(pitch * m_masterPitch * masterCategoryPitch)))
-                logcoe::warning("SoundManager::" + method + ": Failed to set pitch for " + filename);
-            if (!(source->get().setLooping(loop)))
-                logcoe::warning("SoundManager::" + method + ": Failed to set looping for " + filename);
+                logcoe::warning("SoundManager::" + method + ": Failed to set pitch for " + name);
+            // A streamed source loops through its decoder, looping the AL queue would replay stale buffers
+            if (!(source->get().setLooping(loop && !stream)))
+                logcoe::warning("SoundManager::" + method + ": Failed to set looping for " + name);
             if (is3D)
             {
+                ALenum format = buffer->get().getFormat();
+                if (format == AL_FORMAT_STEREO8 || format == AL_FORMAT_STEREO16 || format == AL_FORMAT_STEREO_FLOAT32 ||
+                    format == AL_FORMAT_STEREO_IMA4 || format == AL_FORMAT_STEREO_MSADPCM_SOFT)
+                    logcoe::debug("SoundManager::" + method + ": " + name + " is stereo and plays without spatialization - "
+                                  "enable setMonoDownmix for its directory");
                 if (!(source->get().setPosition(position)))
-                    logcoe::warning("SoundManager::" + method + ": Failed to set position for " + filename);
+                    logcoe::warning("SoundManager::" + method + ": Failed to set position for " + name);
                 if (!(source->get().setVelocity(velocity)))
-                    logcoe::warning("SoundManager::" + method + ": Failed to set velocity for " + filename);
+                    logcoe::warning("SoundManager::" + method + ": Failed to set velocity for " + name);
             }
             if (!(source->get().play()))
             {
-                logcoe::error("SoundManager::" + method + ": Failed to play the sound " + filename);
+                logcoe::error("SoundManager::" + method + ": Failed to play the sound " + name);
                 m_resourceManager.releaseSource(source.value());
-                m_resourceManager.releaseBuffer(buffer.value());
+                m_resourceManager.releaseBuffer(buffer.value(), priority);
                 return INVALID_SOUND_HANDLE;
             }
 
-            ActiveAudio audio;
             audio.m_sourceIndex = poolIndex;
-            audio.m_filename = filename;
-            audio.m_baseVolume = volume;
-            audio.m_basePitch = pitch;
-            audio.m_loop = loop;
-            audio.m_stream = buffer->get().isStreaming();
+            audio.m_stream = stream;
+            auto sourceAllocation = m_resourceManager.getSourceAllocation(poolIndex);
+            if (sourceAllocation.has_value())
+                audio.m_sourceAllocatedTime = sourceAllocation.value().get().m_allocatedTime;
+            if (stream)
+            {
+                audio.m_streamBufferSize = soundStream->getBufferSize();
+                audio.m_streamNeedsRefill = !(soundStream->isFinished());
+                audio.m_soundStream = std::move(soundStream);
+            }
 
-            activeAudio[nextHandle] = std::move(audio);
+            // A queued play already handed its handle out when the command was recorded
+            if (reservedHandle == INVALID_SOUND_HANDLE)
+                return activeAudio.insert(std::move(audio));
+            activeAudio.insert(reservedHandle, std::move(audio));
+            return reservedHandle;
+        }
 
-            return nextHandle++;
+        void SoundManager::releaseAudioBuffer(const ActiveAudio &audio)
+        {
+            if (audio.m_soundId.isValid())
+                m_resourceManager.releaseBuffer(audio.m_soundId, audio.m_priority);
+            else
+                m_resourceManager.releaseBuffer(audio.m_filename, audio.m_priority);
         }
 
-        void SoundManager::handleStreamingAudio()
+        void SoundManager::handleStreamingAudio(SlotMap<ActiveAudio> &activeAudio)
         {
-            // In the roadmap, not yet implemented
+            for (auto &[handle, audio] : activeAudio)
+            {
+                if (!audio.m_stream || !audio.m_soundStream)
+                    continue;
+
+                auto sourceAllocation = m_resourceManager.getSourceAllocation(audio.m_sourceIndex);
+                if (!(sourceAllocation.has_value()) || !(sourceAllocation.value().get().m_active))
+                    continue;
+
+                // The source was replaced by a higher priority sound, its new owner already cleared our queue
+                if (sourceAllocation.value().get().m_allocatedTime != audio.m_sourceAllocatedTime)
+                {
+                    logcoe::debug("SoundManager::handleStreamingAudio: handle " + std::to_string(handle) + " lost its source");
+                    audio.m_soundStream.reset();
+                    audio.m_streamNeedsRefill = false;
+                    continue;
+                }
+
+                auto &source = sourceAllocation.value().get().m_source;
+                SoundState state = source->getState();
+                if (state == SoundState::Initial || state == SoundState::Paused)
+                    continue;
+
+                bool finishedBeforeRefill = audio.m_soundStream->isFinished();
+                audio.m_soundStream->refill(*source);
+                audio.m_streamPosition = audio.m_soundStream->getPosition();
+                audio.m_streamNeedsRefill = !(audio.m_soundStream->isFinished());
+
+                if (state != SoundState::Stopped || finishedBeforeRefill)
+                    continue;
+
+                // The source ran dry before the decode thread caught up, count it once and restart as soon as
+                // fresh buffers are queued
+                if (!audio.m_streamStarved)
+                {
+                    audio.m_streamStarved = true;
+                    ++m_streamUnderruns;
+                    logcoe::debug("SoundManager::handleStreamingAudio: Stream underrun on handle " + std::to_string(handle));
+                }
+
+                if (source->getBuffersQueued() > 0)
+                {
+                    audio.m_streamStarved = false;
+                    if (!(source->play()))
+                        logcoe::warning("SoundManager::handleStreamingAudio: Failed to restart handle " + std::to_string(handle));
+                }
+            }
         }
 
-        void SoundManager::handleFadeEffects(std::unordered_map<size_t, ActiveAudio> &activeAudio,
-                                             float categoryMultiplier, float deltaTime)
+        void SoundManager::releaseStreams(SlotMap<ActiveAudio> &activeAudio)
         {
-            for (auto it = activeAudio.begin(); it != activeAudio.end();)
+            for (auto &[handle, audio] : activeAudio)
+            {
+                if (!audio.m_soundStream)
+                    continue;
+
+                auto sourceAllocation = m_resourceManager.getSourceAllocation(audio.m_sourceIndex);
+                if (sourceAllocation.has_value() && sourceAllocation.value().get().m_active &&
+                    sourceAllocation.value().get().m_allocatedTime == audio.m_sourceAllocatedTime)
+                {
+                    try { sourceAllocation.value().get().m_source->detachBuffer(); }
+                    catch (const std::exception &e)
+                    {
+                        logcoe::warning("SoundManager::releaseStreams: Failed to detach stream of handle " +
+                                        std::to_string(handle) + ": " + std::string(e.what()));
+                    }
+                }
+                audio.m_soundStream.reset();
+            }
+        }
+
+        FadeTable &SoundManager::getFades(const SlotMap<ActiveAudio> &activeAudio)
+        {
+            return &activeAudio == &m_activeMusic ? m_musicFades : m_soundFades;
+        }
+
+        void SoundManager::startFade(SlotMap<ActiveAudio> &activeAudio, size_t handle, ActiveAudio &audio,
+                                     float startVolume, float targetVolume, float duration)
+        {
+            FadeTable &fades = getFades(activeAudio);
+            if (audio.m_fadeIndex == NO_FADE)
+                audio.m_fadeIndex = fades.add(handle);
+            fades.restart(audio.m_fadeIndex, startVolume, targetVolume, duration);
+        }
+
+        void SoundManager::removeFade(SlotMap<ActiveAudio> &activeAudio, size_t index)
+        {
+            size_t moved = getFades(activeAudio).remove(index);
+            auto it = activeAudio.find(moved);
+            if (it != activeAudio.end())
+                it->second.m_fadeIndex = index;
+        }
+
+        float SoundManager::getFadeVolume(const SlotMap<ActiveAudio> &activeAudio, const ActiveAudio &audio)
+        {
+            if (audio.m_fadeIndex == NO_FADE)
+                return audio.m_baseVolume;
+            return getFades(activeAudio).m_volume[audio.m_fadeIndex];
+        }
+
+        void SoundManager::handleFadeEffects(SlotMap<ActiveAudio> &activeAudio, float categoryMultiplier, bool mute,
+                                             float deltaTime)
+        {
+            FadeTable &fades = getFades(activeAudio);
+            if (fades.size() == 0)
+                return;
+
+            fades.advance(deltaTime, mute ? 0.0f : m_masterVolume * categoryMultiplier);
+
+            // Only voices whose gain changed reach OpenAL, the pool is looked up once for the whole pass
+            auto &sourcePool = m_resourceManager.getSourceAllocations();
+            for (size_t i = 0; i < fades.size();)
             {
-                auto &audio = it->second;
-                if (!audio.m_isFading)
+                size_t handle = fades.m_handles[i];
+                auto it = activeAudio.find(handle);
+                if (it == activeAudio.end())
                 {
-                    ++it;
+                    removeFade(activeAudio, i);
+                    continue;
+                }
+
+                ActiveAudio &audio = it->second;
+                bool finished = fades.m_finished[i] != 0;
+                float volume = finished ? fades.m_targetVolume[i] : fades.m_volume[i];
+                if (!(audio.m_virtual))
+                {
+                    if (audio.m_sourceIndex >= sourcePool.size() || !(sourcePool[audio.m_sourceIndex].m_active))
+                    {
+                        logcoe::warning("SoundManager::handleFadeEffects: handle " + std::to_string(handle) + " is no longer active");
+                        removeFade(activeAudio, i);
+                        activeAudio.erase(it);
+                        continue;
+                    }
+                    // handleInactiveAudio cleans up a voice that lost its source and could not become virtual
+                    if (sourcePool[audio.m_sourceIndex].m_allocatedTime != audio.m_sourceAllocatedTime &&
+                        !virtualizeIfStolen(audio))
+                    {
+                        ++i;
+                        continue;
+                    }
+                }
+
+                if (audio.m_virtual)
+                {
+                    if (!finished)
+                    {
+                        ++i;
+                        continue;
+                    }
+
+                    removeFade(activeAudio, i);
+                    if (volume == 0.0f)
+                    {
+                        releaseAudioBuffer(audio);
+                        activeAudio.erase(it);
+                        --m_virtualVoiceCount;
+                        continue;
+                    }
+                    audio.m_baseVolume = volume;
+                    audio.m_fadeIndex = NO_FADE;
                     continue;
                 }
 
-                audio.m_fadeElapsed += deltaTime;
-                bool finished = false;
-                float currentVolume;
-                float diff = audio.m_fadeTargetVolume - audio.m_fadeStartVolume;
-                if (audio.m_fadeElapsed >= audio.m_fadeDuration)
+                auto &source = sourcePool[audio.m_sourceIndex].m_source;
+                if (fades.m_gain[i] != fades.m_appliedGain[i])
                 {
-                    currentVolume = audio.m_fadeTargetVolume;
-                    finished = true;
+                    if (source->setVolume(fades.m_gain[i]))
+                        fades.m_appliedGain[i] = fades.m_gain[i];
+                    else
+                        logcoe::warning("SoundManager::handleFadeEffects: Failed to update the volume of handle " + std::to_string(handle));
                 }
-                else
-                    currentVolume = audio.m_fadeStartVolume + ((audio.m_fadeElapsed / audio.m_fadeDuration) * diff);
 
-                float minVolume = std::min(audio.m_fadeStartVolume, audio.m_fadeTargetVolume);
-                float maxVolume = std::max(audio.m_fadeStartVolume, audio.m_fadeTargetVolume);
-                currentVolume = std::clamp(currentVolume, minVolume, maxVolume);
+                if (!finished)
+                {
+                    ++i;
+                    continue;
+                }
+
+                removeFade(activeAudio, i);
+                if (volume == 0.0f)
+                {
+                    if (source->stop())
+                    {
+                        m_resourceManager.releaseSource(*source);
+                        releaseAudioBuffer(audio);
+                    }
+                    else
+                        logcoe::warning("SoundManager::handleFadeEffects: Failed to stop handle " + std::to_string(handle) + " when finished to fade out");
+
+                    activeAudio.erase(it);
+                    continue;
+                }
+                audio.m_baseVolume = volume;
+                audio.m_fadeIndex = NO_FADE;
+            }
+        }
 
-                float finalVolume = currentVolume * m_masterVolume * categoryMultiplier;
+        void SoundManager::handleInactiveAudio(SlotMap<ActiveAudio> &activeAudio)
+        {
+            for (auto it = activeAudio.begin(); it != activeAudio.end();)
+            {
+                ActiveAudio &audio = it->second;
+                if (audio.m_virtual)
+                {
+                    ++it;
+                    continue;
+                }
 
                 auto sourceAllocation = m_resourceManager.getSourceAllocation(audio.m_sourceIndex);
                 if (!(sourceAllocation.has_value()) || !(sourceAllocation.value().get().m_active))
                 {
-                    logcoe::warning("SoundManager::handleFadeEffects: handle " + std::to_string(it->first) + " is no longer active");
+                    logcoe::debug("SoundManager::update: Cleaning up inactive audio handle: " + std::to_string(it->first));
                     it = activeAudio.erase(it);
                     continue;
                 }
-                auto &source = sourceAllocation.value().get().m_source;
-                if (!(source->setVolume(finalVolume)))
-                    logcoe::warning("SoundManager::handleFadeEffects: Failed to update the volume of handle " + std::to_string(it->first));
 
-                if (finished)
+                // The source was stolen by a more important sound, ours carries on as a virtual voice
+                if (sourceAllocation.value().get().m_allocatedTime != audio.m_sourceAllocatedTime)
                 {
-                    if (currentVolume == 0.0f)
+                    if (virtualizeIfStolen(audio))
                     {
-                        if (source->stop())
-                        {
-                            m_resourceManager.releaseSource(*source);
-                            m_resourceManager.releaseBuffer(audio.m_filename);
-                        }
-                        else
-                            logcoe::warning("SoundManager::handleFadeEffects: Failed to stop handle " + std::to_string(it->first) + " when finished to fade out");
-
-                        it = activeAudio.erase(it);
+                        logcoe::debug("SoundManager::update: Audio handle " + std::to_string(it->first) + " became virtual");
+                        ++it;
                         continue;
                     }
 
-                    audio.m_isFading = false;
-                    audio.m_baseVolume = audio.m_fadeTargetVolume;
-                    audio.m_fadeDuration = 0.0f;
-                    audio.m_fadeElapsed = 0.0f;
-                    audio.m_fadeStartVolume = 0.0f;
-                    audio.m_fadeTargetVolume = 0.0f;
-                }
+                    logcoe::debug("SoundManager::update: Cleaning up replaced audio handle: " + std::to_string(it->first));
+                    releaseAudioBuffer(audio);
+                    it = activeAudio.erase(it);
+                    continue;
+                }
+
+                // Finished voices go back to the pool here, so stealing a source never has to query their state
+                auto &source = sourceAllocation.value().get().m_source;
+                bool streamFinished = !audio.m_soundStream || audio.m_soundStream->isFinished();
+                if (streamFinished && source->isStopped())
+                {
+                    logcoe::debug("SoundManager::update: Releasing finished audio handle: " + std::to_string(it->first));
+                    m_resourceManager.releaseSource(*source);
+                    releaseAudioBuffer(audio);
+                    it = activeAudio.erase(it);
+                    continue;
+                }
+
+                ++it;
+            }
+        }
+
+        void SoundManager::handleOutOfRangeAudio(SlotMap<ActiveAudio> &activeAudio)
+        {
+            // A voice that leaves hearing range goes virtual like one that started there, so what plays matches
+            // the estimate play() culled with. Streams cannot be virtual and keep their source.
+            for (auto &[handle, audio] : activeAudio)
+            {
+                if (audio.m_virtual || !audio.m_is3D || audio.m_stream || getAudibility(audio) >= m_audibilityThreshold)
+                    continue;
+                if (m_virtualVoiceCount >= m_maxVirtualVoices)
+                    return;
+
+                auto sourceAllocation = m_resourceManager.getSourceAllocation(audio.m_sourceIndex);
+                if (!(sourceAllocation.has_value()) || !(sourceAllocation.value().get().m_active) ||
+                    sourceAllocation.value().get().m_allocatedTime != audio.m_sourceAllocatedTime)
+                    continue;
+
+                // The voice keeps its buffer reference, its playback clock carries on from where the source stopped
+                auto &source = sourceAllocation.value().get().m_source;
+                if (!(source->stop()))
+                {
+                    logcoe::warning("SoundManager::update: Failed to stop out of range audio handle " + std::to_string(handle));
+                    continue;
+                }
+                m_resourceManager.releaseSource(*source);
+                audio.m_virtual = true;
+                ++m_virtualVoiceCount;
+                logcoe::debug("SoundManager::update: Audio handle " + std::to_string(handle) + " left hearing range and became virtual");
+            }
+        }
+
+        void SoundManager::advancePlaybackClocks(SlotMap<ActiveAudio> &activeAudio, float categoryPitch,
+                                                 float deltaTime)
+        {
+            for (auto it = activeAudio.begin(); it != activeAudio.end();)
+            {
+                ActiveAudio &audio = it->second;
+                if (audio.m_paused)
+                {
+                    ++it;
+                    continue;
+                }
+
+                audio.m_playbackOffset += deltaTime * audio.m_basePitch * m_masterPitch * categoryPitch;
+                if (audio.m_duration > 0.0f && audio.m_playbackOffset >= audio.m_duration)
+                {
+                    if (audio.m_loop)
+                        audio.m_playbackOffset = std::fmod(audio.m_playbackOffset, audio.m_duration);
+                    else if (audio.m_virtual)
+                    {
+                        logcoe::debug("SoundManager::update: Virtual audio handle " + std::to_string(it->first) + " finished");
+                        releaseAudioBuffer(audio);
+                        it = activeAudio.erase(it);
+                        --m_virtualVoiceCount;
+                        continue;
+                    }
+                }
+                ++it;
+            }
+        }
+
+        float SoundManager::estimateGain(float volume, const Vec3 &position, float maxDistance) const
+        {
+            // Sources keep OpenAL's default distance model, reference distance and rolloff
+            float distance = m_listenerPosition.distance(position);
+            if (maxDistance > 0.0f && distance >= maxDistance)
+                return 0.0f;
+            return volume * math::calculateInverseDistanceGain(distance);
+        }
+
+        float SoundManager::getAudibility(const ActiveAudio &audio) const
+        {
+            if (!audio.m_is3D)
+                return audio.m_baseVolume;
+            return estimateGain(audio.m_baseVolume, audio.m_position, audio.m_maxDistance);
+        }
+
+        bool SoundManager::realizeAudio(ActiveAudio &audio, size_t poolIndex, SoundSource &source, float volume, float pitch)
+        {
+            auto buffer = audio.m_soundId.isValid() ? m_resourceManager.getBuffer(audio.m_soundId, audio.m_priority)
+                                                    : m_resourceManager.getBuffer(audio.m_filename, audio.m_priority);
+            if (!(buffer.has_value()))
+                return false;
+            // The voice kept its own reference while it was virtual
+            releaseAudioBuffer(audio);
+
+            try
+            {
+                m_resourceManager.attachBuffer(poolIndex, buffer.value());
+            }
+            catch (const std::exception &e)
+            {
+                logcoe::warning("SoundManager::update: Failed to attach buffer: " + std::string(e.what()));
+                return false;
+            }
+
+            source.setVolume(volume);
+            source.setPitch(pitch);
+            source.setLooping(audio.m_loop);
+            if (audio.m_is3D)
+            {
+                source.setPosition(audio.m_position);
+                source.setVelocity(audio.m_velocity);
+            }
+            // Applied on the next play, a paused voice starts from here when it is resumed
+            source.setPlaybackOffset(std::min(audio.m_playbackOffset, audio.m_duration));
+            if (!audio.m_paused && !(source.play()))
+                return false;
+
+            auto sourceAllocation = m_resourceManager.getSourceAllocation(poolIndex);
+            if (sourceAllocation.has_value())
+                audio.m_sourceAllocatedTime = sourceAllocation.value().get().m_allocatedTime;
+            audio.m_sourceIndex = poolIndex;
+            audio.m_virtual = false;
+            return true;
+        }
+
+        void SoundManager::handleVirtualAudio()
+        {
+            if (m_virtualVoiceCount == 0)
+                return;
+
+            // Voices are kept by handle, erasing one moves another within the slot map
+            struct VirtualVoice
+            {
+                SlotMap<ActiveAudio> *m_activeAudio;
+                size_t m_handle;
+                SoundPriority m_priority;
+                float m_audibility;
+            };
+
+            std::vector<VirtualVoice> voices;
+            voices.reserve(m_virtualVoiceCount);
+            for (auto *activeAudio : {&m_activeSounds, &m_activeMusic})
+                for (auto &[handle, audio] : *activeAudio)
+                    if (audio.m_virtual)
+                        voices.push_back({activeAudio, handle, audio.m_priority, getAudibility(audio)});
+
+            // The most important voices get sources first, the loudest at the listener among equals
+            std::sort(voices.begin(), voices.end(), [](const VirtualVoice &a, const VirtualVoice &b)
+                      {
+                          if (a.m_priority != b.m_priority)
+                              return a.m_priority > b.m_priority;
+                          return a.m_audibility > b.m_audibility;
+                      });
+
+            for (const auto &voice : voices)
+            {
+                auto it = voice.m_activeAudio->find(voice.m_handle);
+                if (it == voice.m_activeAudio->end())
+                    continue;
+
+                ActiveAudio &audio = it->second;
+                if (audio.m_is3D && voice.m_audibility < m_audibilityThreshold)
+                    continue;
+
+                size_t poolIndex;
+                // Equal priorities are not stolen, or two voices would keep taking the same source from each other
+                auto source = m_resourceManager.acquireSource(poolIndex, audio.m_priority, false);
+                if (!(source.has_value()))
+                    break;
+
+                bool music = voice.m_activeAudio == &m_activeMusic;
+                bool mute = m_mute || (music ? m_musicMute : m_soundsMute);
+                float volume = getFadeVolume(*voice.m_activeAudio, audio);
+                if (audio.m_fadeIndex != NO_FADE)
+                    getFades(*voice.m_activeAudio).m_appliedGain[audio.m_fadeIndex] = -1.0f;
+                volume = mute ? 0.0f : volume * m_masterVolume * (music ? m_masterMusicVolume : m_masterSoundsVolume);
+                float pitch = audio.m_basePitch * m_masterPitch * (music ? m_masterMusicPitch : m_masterSoundsPitch);
+
+                --m_virtualVoiceCount;
+                if (realizeAudio(audio, poolIndex, source->get(), volume, pitch))
+                    continue;
+
+                logcoe::warning("SoundManager::update: Failed to resume virtual audio handle " + std::to_string(voice.m_handle));
+                m_resourceManager.releaseSource(source.value());
+                releaseAudioBuffer(audio);
+                voice.m_activeAudio->erase(it);
+            }
+        }
+
+        void SoundManager::reserveHandleCapacity()
+        {
+            // Every voice and every play the queue can hold gets a slot up front, so producers never grow the maps
+            size_t capacity = m_resourceManager.getSourceAllocations().size() + m_maxVirtualVoices + COMMAND_QUEUE_CAPACITY;
+            m_activeSounds.reserveCapacity(capacity);
+            m_activeMusic.reserveCapacity(capacity);
+        }
+
+        size_t SoundManager::queuePlay(AudioCommand &&command, SlotMap<ActiveAudio> &activeAudio)
+        {
+            command.m_type = CommandType::Play;
+            if (enterQueue())
+            {
+                // The handle is reserved now so the caller can address the sound before update() starts it.
+                // initialize() sizes the maps for every voice and queued play, so this only grows the map when
+                // handles pile up.
+                size_t handle = activeAudio.reserve(true);
+                command.m_handle = handle;
+                bool queued = handle != INVALID_SOUND_HANDLE && m_commands.tryPush(std::move(command));
+                leaveQueue();
+                if (handle == INVALID_SOUND_HANDLE || queued)
+                    return handle;
+            }
+
+            // A full queue, or one disabled since the caller checked it, falls back to the locked path, draining
+            // first so the caller's earlier commands go before it
+            std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
+            return applyPlay(command);
+        }
+
+        bool SoundManager::queueOperation(bool music, size_t handle, CommandType type,
+                                          PropertyType property, float value, const Vec3 &vector)
+        {
+            AudioCommand command;
+            command.m_type = type;
+            command.m_music = music;
+            command.m_handle = handle;
+            command.m_property = property;
+            command.m_volume = value;
+            command.m_position = vector;
+            return queueCommand(std::move(command));
+        }
+
+        bool SoundManager::queueCommand(AudioCommand &&command)
+        {
+            if (enterQueue())
+            {
+                bool queued = m_commands.tryPush(std::move(command));
+                leaveQueue();
+                if (queued)
+                    return true;
+            }
+
+            // A full queue, or one disabled since the caller checked it, falls back to the locked path, draining
+            // first so the caller's earlier commands go before it
+            std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
+            return applyCommand(command);
+        }
+
+        bool SoundManager::enterQueue()
+        {
+            // Announced before the flag is read again, so stopQueueing() either sees this producer or it sees the
+            // queue disabled. Both are sequentially consistent, as the handshake needs.
+            ++m_queueProducers;
+            if (m_commandQueueEnabled)
+                return true;
+            --m_queueProducers;
+            return false;
+        }
+
+        void SoundManager::leaveQueue()
+        {
+            --m_queueProducers;
+        }
+
+        void SoundManager::stopQueueing()
+        {
+            // Producers never take m_mutex before leaving the queue, so the caller can hold it while waiting
+            m_commandQueueEnabled = false;
+            while (m_queueProducers != 0)
+                std::this_thread::yield();
+        }
+
+        size_t SoundManager::applyPlay(AudioCommand &command)
+        {
+            auto &activeAudio = command.m_music ? m_activeMusic : m_activeSounds;
+            const std::string &subdir = command.m_music ? m_musicSubdir : m_soundSubdir;
+            std::string filename = command.m_soundId.isValid() ? std::string() : subdir + command.m_filename;
+            std::string method = command.m_music ? "playMusic" : (command.m_is3D ? "playSound3D" : "playSound");
+            size_t handle = play(activeAudio, filename, command.m_soundId, command.m_volume, command.m_pitch,
+                                 command.m_loop, command.m_priority, method,
+                                 command.m_music ? m_masterMusicVolume : m_masterSoundsVolume,
+                                 command.m_music ? m_masterMusicPitch : m_masterSoundsPitch, command.m_is3D,
+                                 command.m_position, command.m_velocity, command.m_maxDistance, command.m_handle);
+
+            // Commands queued after this one for the same handle now find a stale handle
+            if (handle == INVALID_SOUND_HANDLE)
+                activeAudio.cancel(command.m_handle);
+            return handle;
+        }
+
+        bool SoundManager::applyCommand(AudioCommand &command)
+        {
+            auto &activeAudio = command.m_music ? m_activeMusic : m_activeSounds;
+            switch (command.m_type)
+            {
+            case CommandType::Play:
+                return applyPlay(command) != INVALID_SOUND_HANDLE;
+            case CommandType::Pause:
+                return audioOperation(activeAudio, command.m_handle, SoundState::Paused,
+                                      command.m_music ? "pauseMusic" : "pauseSound");
+            case CommandType::Resume:
+            {
+                std::string method = command.m_music ? "resumeMusic" : "resumeSound";
+                if (!checkAudioState(activeAudio, command.m_handle, SoundState::Paused, method))
+                    return setError("SoundManager::" + method + ": Audio is not paused");
+                return audioOperation(activeAudio, command.m_handle, SoundState::Playing, method);
+            }
+            case CommandType::Stop:
+                return audioOperation(activeAudio, command.m_handle, SoundState::Stopped,
+                                      command.m_music ? "stopMusic" : "stopSound");
+            case CommandType::SetProperty:
+            {
+                bool vector = command.m_property == PropertyType::Position || command.m_property == PropertyType::Velocity;
+                return setAudioProperty(activeAudio, command.m_handle, command.m_property, "update",
+                                        vector ? command.m_position.x : command.m_volume,
+                                        command.m_position.y, command.m_position.z);
+            }
+            }
+
+            return setError("SoundManager::update: Internal error - Invalid command type");
+        }
+
+        size_t SoundManager::processCommands()
+        {
+            // Only commands pushed before this point are applied, a producer that keeps pushing cannot stall update()
+            size_t pending = m_commands.capacity();
+            size_t processed = 0;
+            AudioCommand command;
+            while (processed < pending && m_commands.tryPop(command))
+            {
+                applyCommand(command);
+                ++processed;
+            }
+            return processed;
+        }
+
+        void SoundManager::discardCommands()
+        {
+            // A dropped play hands its reserved slot back, or the slot map would keep it reserved for good
+            AudioCommand command;
+            while (m_commands.tryPop(command))
+                if (command.m_type == CommandType::Play)
+                    (command.m_music ? m_activeMusic : m_activeSounds).cancel(command.m_handle);
+        }
+
+        SoundManager::SoundManager() : m_resourceManager(),
+                                       m_activeSounds(), m_activeMusic(), m_listenerPosition(),
+                                       m_listenerVelocity(), m_listenerForward(), m_listenerUp(),
+                                       m_lastUpdate() { }
+
+        SoundManager::~SoundManager() 
+        {
+            shutdown(); 
+        }
+
+        bool SoundManager::initialize(const std::string &audioRootDirectory, size_t maxSources,
+                                      size_t maxCacheSizeMB, const std::string &soundSubdir,
+                                      const std::string &musicSubdir, LogLevel level)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            
+            if (m_initialized)
+            {
+                logcoe::warning("SoundManager::initialize: Need to shutdown SoundManager before initialize it again");
+                return false;
+            }
+
+            // shutdown() leaves the queue empty, a new session still never inherits a reservation
+            discardCommands();
+
+
+            logcoe::initialize(level, "soundcoe");
+
+            if (audioRootDirectory.empty())
+            {
+                logcoe::error("SoundManager::initialize: Audio root directory cannot be empty");
+                logcoe::shutdown();
+                return false;
+            }
+
+            if (!std::filesystem::exists(audioRootDirectory) || !std::filesystem::is_directory(audioRootDirectory))
+            {
+                logcoe::error("SoundManager::initialize: Audio root directory does not exist or is not a directory: " + audioRootDirectory);
+                logcoe::shutdown();
+                return false;
+            }
+
+            try
+            {
+                m_resourceManager.initialize(audioRootDirectory, maxSources, maxCacheSizeMB);
+            }
+            catch (const std::exception &e)
+            {
+                logcoe::error("SoundManager::initialize: Failed to create Resource Manager: " + std::string(e.what()));
+                logcoe::shutdown();
+                return false;
+            }
+
+            m_soundSubdir = soundSubdir + "/";
+            m_musicSubdir = musicSubdir + "/";
+            reserveHandleCapacity();
+
+            alListenerf(AL_GAIN, 1.0f);
+
+            std::filesystem::path rootDirectory(audioRootDirectory);
+            std::filesystem::path generalAudioDirectory(rootDirectory / "general");
+            if (std::filesystem::exists(generalAudioDirectory) && std::filesystem::is_directory(generalAudioDirectory))
+            {
+                if (!m_resourceManager.preloadDirectory("general"))
+                {
+                    logcoe::error("SoundManager::initialize: Failed to load general audio subdirectory");
+                    m_resourceManager.shutdown();
+                    logcoe::shutdown();
+                    return false;
+                }
+            }
+            else
+                logcoe::warning("SoundManager::initialize: There is no general audio subdirectory");
+
+            m_streamWorker.start();
+
+            m_initialized = true;
+            logcoe::info("SoundManager::initialize: SoundManager initialized successfully");
+            return true;
+        }
+
+        void SoundManager::shutdown()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            logcoe::info("SoundManager::shutdown() called");
+
+            // Producers that already saw the queue enabled finish their push before the queue is drained, commands
+            // still waiting refer to handles that die with this session
+            stopQueueing();
+            discardCommands();
+
+            releaseStreams(m_activeSounds);
+            releaseStreams(m_activeMusic);
+            m_streamWorker.stop();
+            m_streamUnderruns = 0;
+            m_activeSounds.clear();
+            m_activeMusic.clear();
+            m_soundFades.clear();
+            m_musicFades.clear();
+            m_virtualVoiceCount = 0;
+            m_maxVirtualVoices = 1024;
+            m_audibilityThreshold = 0.001f;
+
+            m_masterVolume = 1.0f;
+            m_masterSoundsVolume = 1.0f;
+            m_masterMusicVolume = 1.0f;
+            m_masterPitch = 1.0f;
+            m_masterSoundsPitch = 1.0f;
+            m_masterMusicPitch = 1.0f;
+
+            m_mute = false;
+            m_soundsMute = false;
+            m_musicMute = false;
+
+            m_listenerPosition = Vec3::zero();
+            m_listenerVelocity = Vec3::zero();
+            m_listenerForward = Vec3::zero();
+            m_listenerUp = Vec3::zero();
+
+            m_lastUpdate = std::chrono::steady_clock::time_point();
+            m_firstUpdate = true;
+
+            m_lastError = "";
+            m_hasError = false;
+
+            m_resourceManager.shutdown();
+            logcoe::info("SoundManager::shutdown() completed");
+            logcoe::shutdown();
+            m_initialized = false;
+        }
+
+        bool SoundManager::isInitialized() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            
+            return m_initialized;
+        }
+
+        bool SoundManager::preloadScene(const std::string &sceneName)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
+
+            return m_resourceManager.preloadDirectory(sceneName);
+        }
+
+        PreloadTicket SoundManager::preloadSceneAsync(const std::string &sceneName)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
+
+            return m_resourceManager.preloadDirectoryAsync(sceneName);
+        }
+
+        bool SoundManager::unloadScene(const std::string &sceneName)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
+
+            return m_resourceManager.unloadDirectory(sceneName);
+        }
+
+        bool SoundManager::isSceneLoaded(const std::string &sceneName) const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            return m_resourceManager.isDirectoryLoaded(sceneName);
+        }
+
+        bool SoundManager::setStreamingPolicy(const StreamingPolicy &policy)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_resourceManager.setStreamingPolicy(policy);
+            return true;
+        }
+
+        bool SoundManager::setStreamingPolicy(const std::string &subdirectory, const StreamingPolicy &policy)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (!(m_resourceManager.setStreamingPolicy(subdirectory, policy)))
+                return setError("SoundManager::setStreamingPolicy: Invalid subdirectory \"" + subdirectory + "\"");
+            return true;
+        }
+
+        StreamingPolicy SoundManager::getStreamingPolicy(const std::string &subdirectory) const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            return m_resourceManager.getStreamingPolicy(subdirectory);
+        }
+
+        bool SoundManager::setMonoDownmix(bool enabled)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_resourceManager.setMonoDownmix(enabled);
+            return true;
+        }
+
+        bool SoundManager::setMonoDownmix(const std::string &subdirectory, bool enabled)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (!(m_resourceManager.setMonoDownmix(subdirectory, enabled)))
+                return setError("SoundManager::setMonoDownmix: Invalid subdirectory \"" + subdirectory + "\"");
+            return true;
+        }
+
+        bool SoundManager::isMonoDownmixEnabled(const std::string &subdirectory) const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            return m_resourceManager.isMonoDownmixEnabled(subdirectory);
+        }
+
+        bool SoundManager::setResampleOnLoad(bool enabled)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_resourceManager.setResampleOnLoad(enabled);
+            return true;
+        }
+
+        bool SoundManager::isResampleOnLoadEnabled() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            return m_resourceManager.isResampleOnLoadEnabled();
+        }
+
+        bool SoundManager::setBufferCompression(BufferCompression compression)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
 
-                ++it;
-            }
+            m_resourceManager.setBufferCompression(compression);
+            return true;
         }
 
-        void SoundManager::handleInactiveAudio(std::unordered_map<size_t, ActiveAudio> &activeAudio)
+        bool SoundManager::setBufferCompression(const std::string &subdirectory, BufferCompression compression)
         {
-            for (auto it = activeAudio.begin(); it != activeAudio.end();)
-            {
-                auto sourceAllocation = m_resourceManager.getSourceAllocation(it->second.m_sourceIndex);
-                if (!(sourceAllocation.has_value()) || !(sourceAllocation.value().get().m_active))
-                {
-                    logcoe::debug("SoundManager::update: Cleaning up inactive audio handle: " + std::to_string(it->first));
-                    it = activeAudio.erase(it);
-                }
-                else
-                    ++it;
-            }
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (!(m_resourceManager.setBufferCompression(subdirectory, compression)))
+                return setError("SoundManager::setBufferCompression: Invalid subdirectory \"" + subdirectory + "\"");
+            return true;
         }
 
-        SoundManager::SoundManager() : m_resourceManager(), m_nextSoundHandle(1), m_nextMusicHandle(1),
-                                       m_activeSounds(), m_activeMusic(), m_listenerPosition(),
-                                       m_listenerVelocity(), m_listenerForward(), m_listenerUp(),
-                                       m_lastUpdate() { }
+        BufferCompression SoundManager::getBufferCompression(const std::string &subdirectory) const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
 
-        SoundManager::~SoundManager() 
+            return m_resourceManager.getBufferCompression(subdirectory);
+        }
+
+        bool SoundManager::setCompressedCaching(bool enabled)
         {
-            shutdown(); 
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_resourceManager.setCompressedCaching(enabled);
+            return true;
         }
 
-        bool SoundManager::initialize(const std::string &audioRootDirectory, size_t maxSources,
-                                      size_t maxCacheSizeMB, const std::string &soundSubdir,
-                                      const std::string &musicSubdir, LogLevel level)
+        bool SoundManager::setCompressedCaching(const std::string &subdirectory, bool enabled)
         {
             std::lock_guard<std::mutex> lock(m_mutex);
-            
-            if (m_initialized)
-            {
-                logcoe::warning("SoundManager::initialize: Need to shutdown SoundManager before initialize it again");
-                return false;
-            }
 
-            logcoe::initialize(level, "soundcoe");
+            if (!(m_resourceManager.setCompressedCaching(subdirectory, enabled)))
+                return setError("SoundManager::setCompressedCaching: Invalid subdirectory \"" + subdirectory + "\"");
+            return true;
+        }
 
-            if (audioRootDirectory.empty())
-            {
-                logcoe::error("SoundManager::initialize: Audio root directory cannot be empty");
-                logcoe::shutdown();
-                return false;
-            }
+        bool SoundManager::isCompressedCachingEnabled(const std::string &subdirectory) const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
 
-            if (!std::filesystem::exists(audioRootDirectory) || !std::filesystem::is_directory(audioRootDirectory))
-            {
-                logcoe::error("SoundManager::initialize: Audio root directory does not exist or is not a directory: " + audioRootDirectory);
-                logcoe::shutdown();
-                return false;
-            }
+            return m_resourceManager.isCompressedCachingEnabled(subdirectory);
+        }
 
-            try
-            {
-                m_resourceManager.initialize(audioRootDirectory, maxSources, maxCacheSizeMB);
-            }
-            catch (const std::exception &e)
-            {
-                logcoe::error("SoundManager::initialize: Failed to create Resource Manager: " + std::string(e.what()));
-                logcoe::shutdown();
-                return false;
-            }
+        bool SoundManager::setCompressedCacheLimits(size_t compressedMB, size_t decodedMB)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
 
-            m_soundSubdir = soundSubdir + "/";
-            m_musicSubdir = musicSubdir + "/";
+            m_resourceManager.setCompressedCacheLimits(compressedMB, decodedMB);
+            return true;
+        }
 
-            alListenerf(AL_GAIN, 1.0f);
+        bool SoundManager::setStreamReadAhead(size_t chunks)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
 
-            std::filesystem::path rootDirectory(audioRootDirectory);
-            std::filesystem::path generalAudioDirectory(rootDirectory / "general");
-            if (std::filesystem::exists(generalAudioDirectory) && std::filesystem::is_directory(generalAudioDirectory))
-            {
-                if (!m_resourceManager.preloadDirectory("general"))
-                {
-                    logcoe::error("SoundManager::initialize: Failed to load general audio subdirectory");
-                    m_resourceManager.shutdown();
-                    logcoe::shutdown();
-                    return false;
-                }
-            }
-            else
-                logcoe::warning("SoundManager::initialize: There is no general audio subdirectory");
+            if (chunks == 0)
+                return setError("SoundManager::setStreamReadAhead: Read-ahead must be at least one chunk");
 
-            m_initialized = true;
-            logcoe::info("SoundManager::initialize: SoundManager initialized successfully");
+            m_streamReadAhead = chunks;
             return true;
         }
 
-        void SoundManager::shutdown()
+        size_t SoundManager::getStreamReadAhead() const
         {
             std::lock_guard<std::mutex> lock(m_mutex);
-            logcoe::info("SoundManager::shutdown() called");
 
-            m_nextSoundHandle = 1;
-            m_nextMusicHandle = 1;
+            return m_streamReadAhead;
+        }
 
-            m_activeSounds.clear();
-            m_activeMusic.clear();
+        size_t SoundManager::getStreamUnderrunCount() const
+        {
+            return m_streamUnderruns.load();
+        }
 
-            m_masterVolume = 1.0f;
-            m_masterSoundsVolume = 1.0f;
-            m_masterMusicVolume = 1.0f;
-            m_masterPitch = 1.0f;
-            m_masterSoundsPitch = 1.0f;
-            m_masterMusicPitch = 1.0f;
+        bool SoundManager::setDecodeThreadCount(size_t threadCount)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
 
-            m_mute = false;
-            m_soundsMute = false;
-            m_musicMute = false;
+            if (!(m_resourceManager.setDecodeThreadCount(threadCount)))
+                return setError("SoundManager::setDecodeThreadCount: Cannot change the decode thread count while a scene is loading");
+            return true;
+        }
 
-            m_listenerPosition = Vec3::zero();
-            m_listenerVelocity = Vec3::zero();
-            m_listenerForward = Vec3::zero();
-            m_listenerUp = Vec3::zero();
+        size_t SoundManager::getDecodeThreadCount() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
 
-            m_lastUpdate = std::chrono::steady_clock::time_point();
-            m_firstUpdate = true;
+            return m_resourceManager.getDecodeThreadCount();
+        }
 
-            m_lastError = "";
-            m_hasError = false;
+        bool SoundManager::setMaxVirtualVoices(size_t count)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
 
-            m_resourceManager.shutdown();
-            logcoe::info("SoundManager::shutdown() completed");
-            logcoe::shutdown();
-            m_initialized = false;
+            // Voices that are already virtual keep running, only new ones are refused
+            m_maxVirtualVoices = count;
+            if (m_initialized)
+                reserveHandleCapacity();
+            return true;
         }
 
-        bool SoundManager::isInitialized() const
+        size_t SoundManager::getMaxVirtualVoices() const
         {
             std::lock_guard<std::mutex> lock(m_mutex);
-            
-            return m_initialized;
+
+            return m_maxVirtualVoices;
         }
 
-        bool SoundManager::preloadScene(const std::string &sceneName)
+        size_t SoundManager::getVirtualVoiceCount() const
         {
             std::lock_guard<std::mutex> lock(m_mutex);
 
-            return m_resourceManager.preloadDirectory(sceneName);
+            return m_virtualVoiceCount;
         }
 
-        bool SoundManager::unloadScene(const std::string &sceneName)
+        bool SoundManager::setAudibilityThreshold(float gain)
         {
             std::lock_guard<std::mutex> lock(m_mutex);
 
-            return m_resourceManager.unloadDirectory(sceneName);
+            if (gain < 0.0f)
+                return setError("SoundManager::setAudibilityThreshold: Threshold must be non-negative");
+
+            m_audibilityThreshold = gain;
+            return true;
         }
 
-        bool SoundManager::isSceneLoaded(const std::string &sceneName) const
+        float SoundManager::getAudibilityThreshold() const
         {
             std::lock_guard<std::mutex> lock(m_mutex);
 
-            return m_resourceManager.isDirectoryLoaded(sceneName);
+            return m_audibilityThreshold;
+        }
+
+        bool SoundManager::setCommandQueueEnabled(bool enabled)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            // Queued plays hand out handles without checking the manager, which must exist by then
+            if (enabled && !m_initialized)
+                return setError("SoundManager::setCommandQueueEnabled: SoundManager is not initialized");
+
+            // Calls made after this return are applied directly, so the ones still queued must go first
+            if (!enabled)
+            {
+                stopQueueing();
+                processCommands();
+            }
+            else
+                m_commandQueueEnabled = true;
+            return true;
+        }
+
+        bool SoundManager::isCommandQueueEnabled() const
+        {
+            return m_commandQueueEnabled;
         }
 
         void SoundManager::update()
         {
             std::lock_guard<std::mutex> lock(m_mutex);
 
+            // Everything this frame changes on sources reaches the mixer in one update
+            DeferredUpdates deferred(m_resourceManager);
+            processCommands();
+
             auto now = std::chrono::steady_clock::now();
             if (m_firstUpdate)
             {
@@ -612,42 +1653,153 @@ namespace soundcoe
 
             float deltaTime = std::chrono::duration<float>(now - m_lastUpdate).count();
 
-            handleStreamingAudio();
-            handleFadeEffects(m_activeSounds, m_masterSoundsVolume, deltaTime);
-            handleFadeEffects(m_activeMusic, m_masterMusicVolume, deltaTime);
+            m_resourceManager.processAsyncLoads();
+            advancePlaybackClocks(m_activeSounds, m_masterSoundsPitch, deltaTime);
+            advancePlaybackClocks(m_activeMusic, m_masterMusicPitch, deltaTime);
+            handleStreamingAudio(m_activeSounds);
+            handleStreamingAudio(m_activeMusic);
+            handleFadeEffects(m_activeSounds, m_masterSoundsVolume, m_mute || m_soundsMute, deltaTime);
+            handleFadeEffects(m_activeMusic, m_masterMusicVolume, m_mute || m_musicMute, deltaTime);
             handleInactiveAudio(m_activeSounds);
             handleInactiveAudio(m_activeMusic);
+            handleOutOfRangeAudio(m_activeSounds);
+            handleOutOfRangeAudio(m_activeMusic);
+            handleVirtualAudio();
 
             m_lastUpdate = now;
         }
 
         SoundHandle SoundManager::playSound(const std::string &filename, float volume, float pitch, bool loop, SoundPriority priority)
         {
+            if (m_commandQueueEnabled)
+            {
+                AudioCommand command;
+                command.m_filename = filename;
+                command.m_volume = volume;
+                command.m_pitch = pitch;
+                command.m_loop = loop;
+                command.m_priority = priority;
+                return queuePlay(std::move(command), m_activeSounds);
+            }
+
             std::lock_guard<std::mutex> lock(m_mutex);
 
-            return play(m_activeSounds, m_soundSubdir + filename, volume, pitch, loop, priority, m_nextSoundHandle, "playSound",
+            return play(m_activeSounds, m_soundSubdir + filename, INVALID_SOUND_ID, volume, pitch, loop, priority, "playSound",
                         m_masterSoundsVolume, m_masterSoundsPitch);
         }
 
         SoundHandle SoundManager::playSound3D(const std::string &filename, const Vec3 &position, const Vec3 &velocity,
-                                              float volume, float pitch, bool loop, SoundPriority priority)
+                                              float volume, float pitch, bool loop, SoundPriority priority, float maxDistance)
+        {
+            if (m_commandQueueEnabled)
+            {
+                AudioCommand command;
+                command.m_filename = filename;
+                command.m_is3D = true;
+                command.m_position = position;
+                command.m_velocity = velocity;
+                command.m_volume = volume;
+                command.m_pitch = pitch;
+                command.m_loop = loop;
+                command.m_priority = priority;
+                command.m_maxDistance = maxDistance;
+                return queuePlay(std::move(command), m_activeSounds);
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            return play(m_activeSounds, m_soundSubdir + filename, INVALID_SOUND_ID, volume, pitch, loop, priority, "playSound3D",
+                        m_masterSoundsVolume, m_masterSoundsPitch, true, position, velocity, maxDistance);
+        }
+
+        SoundId SoundManager::registerSound(const std::string &filename)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_initialized)
+            {
+                setError("SoundManager::registerSound: SoundManager is not initialized");
+                return INVALID_SOUND_ID;
+            }
+
+            // Hashed the same way as the constants of a generated sound ID header
+            std::string name = std::filesystem::path(filename).lexically_normal().generic_string();
+            SoundId id = makeSoundId(name);
+            if (name.empty() || !(m_resourceManager.registerSound(id, m_soundSubdir + name)))
+            {
+                setError("SoundManager::registerSound: Failed to register \"" + filename + "\"");
+                return INVALID_SOUND_ID;
+            }
+            return id;
+        }
+
+        SoundHandle SoundManager::playSound(SoundId id, float volume, float pitch, bool loop, SoundPriority priority)
+        {
+            if (m_commandQueueEnabled)
+            {
+                AudioCommand command;
+                command.m_soundId = id;
+                command.m_volume = volume;
+                command.m_pitch = pitch;
+                command.m_loop = loop;
+                command.m_priority = priority;
+                return queuePlay(std::move(command), m_activeSounds);
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            return play(m_activeSounds, std::string(), id, volume, pitch, loop, priority, "playSound",
+                        m_masterSoundsVolume, m_masterSoundsPitch);
+        }
+
+        SoundHandle SoundManager::playSound3D(SoundId id, const Vec3 &position, const Vec3 &velocity,
+                                              float volume, float pitch, bool loop, SoundPriority priority, float maxDistance)
         {
+            if (m_commandQueueEnabled)
+            {
+                AudioCommand command;
+                command.m_soundId = id;
+                command.m_is3D = true;
+                command.m_position = position;
+                command.m_velocity = velocity;
+                command.m_volume = volume;
+                command.m_pitch = pitch;
+                command.m_loop = loop;
+                command.m_priority = priority;
+                command.m_maxDistance = maxDistance;
+                return queuePlay(std::move(command), m_activeSounds);
+            }
+
             std::lock_guard<std::mutex> lock(m_mutex);
 
-            return play(m_activeSounds, m_soundSubdir + filename, volume, pitch, loop, priority, m_nextSoundHandle, "playSound3D",
-                        m_masterSoundsVolume, m_masterSoundsPitch, true, position, velocity);
+            return play(m_activeSounds, std::string(), id, volume, pitch, loop, priority, "playSound3D",
+                        m_masterSoundsVolume, m_masterSoundsPitch, true, position, velocity, maxDistance);
         }
 
         MusicHandle SoundManager::playMusic(const std::string &filename, float volume, float pitch, bool loop, SoundPriority priority)
         {
+            if (m_commandQueueEnabled)
+            {
+                AudioCommand command;
+                command.m_music = true;
+                command.m_filename = filename;
+                command.m_volume = volume;
+                command.m_pitch = pitch;
+                command.m_loop = loop;
+                command.m_priority = priority;
+                return queuePlay(std::move(command), m_activeMusic);
+            }
+
             std::lock_guard<std::mutex> lock(m_mutex);
 
-            return play(m_activeMusic, m_musicSubdir + filename, volume, pitch, loop, priority, m_nextMusicHandle, "playMusic",
+            return play(m_activeMusic, m_musicSubdir + filename, INVALID_SOUND_ID, volume, pitch, loop, priority, "playMusic",
                         m_masterMusicVolume, m_masterMusicPitch);
         }
 
         bool SoundManager::pauseSound(SoundHandle handle)
         {
+            if (m_commandQueueEnabled)
+                return queueOperation(false, handle, CommandType::Pause);
+
             std::lock_guard<std::mutex> lock(m_mutex);
 
             return audioOperation(m_activeSounds, handle, SoundState::Paused, "pauseSound");
@@ -655,6 +1807,9 @@ namespace soundcoe
 
         bool SoundManager::pauseMusic(MusicHandle handle)
         {
+            if (m_commandQueueEnabled)
+                return queueOperation(true, handle, CommandType::Pause);
+
             std::lock_guard<std::mutex> lock(m_mutex);
 
             return audioOperation(m_activeMusic, handle, SoundState::Paused, "pauseMusic");
@@ -663,6 +1818,7 @@ namespace soundcoe
         bool SoundManager::pauseAllSounds()
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
             return audioOperationAll(m_activeSounds, SoundState::Paused, "pauseAllSounds");
         }
@@ -670,6 +1826,7 @@ namespace soundcoe
         bool SoundManager::pauseAllMusic()
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
             return audioOperationAll(m_activeMusic, SoundState::Paused, "pauseAllMusic");
         }
@@ -677,13 +1834,20 @@ namespace soundcoe
         bool SoundManager::pauseAll()
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
-            return audioOperationAll(m_activeSounds, SoundState::Paused, "pauseAll") &&
-                   audioOperationAll(m_activeMusic, SoundState::Paused, "pauseAll");
+            // Nested in one window so sounds and music change in the same mixer update
+            DeferredUpdates deferred(m_resourceManager);
+            bool success = audioOperationAll(m_activeSounds, SoundState::Paused, "pauseAll") &&
+                           audioOperationAll(m_activeMusic, SoundState::Paused, "pauseAll");
+            return success;
         }
 
         bool SoundManager::resumeSound(SoundHandle handle)
         {
+            if (m_commandQueueEnabled)
+                return queueOperation(false, handle, CommandType::Resume);
+
             std::lock_guard<std::mutex> lock(m_mutex);
 
             if (!checkAudioState(m_activeSounds, handle, SoundState::Paused, "resumeSound"))
@@ -694,6 +1858,9 @@ namespace soundcoe
 
         bool SoundManager::resumeMusic(MusicHandle handle)
         {
+            if (m_commandQueueEnabled)
+                return queueOperation(true, handle, CommandType::Resume);
+
             std::lock_guard<std::mutex> lock(m_mutex);
 
             if (!checkAudioState(m_activeMusic, handle, SoundState::Paused, "resumeMusic"))
@@ -705,6 +1872,7 @@ namespace soundcoe
         bool SoundManager::resumeAllSounds()
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
             return audioOperationAll(m_activeSounds, SoundState::Playing, "resumeAllSounds");
         }
@@ -712,6 +1880,7 @@ namespace soundcoe
         bool SoundManager::resumeAllMusic()
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
             return audioOperationAll(m_activeMusic, SoundState::Playing, "resumeAllMusic");
         }
@@ -719,13 +1888,19 @@ namespace soundcoe
         bool SoundManager::resumeAll()
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
-            return audioOperationAll(m_activeSounds, SoundState::Playing, "resumeAll") &&
-                   audioOperationAll(m_activeMusic, SoundState::Playing, "resumeAll");
+            DeferredUpdates deferred(m_resourceManager);
+            bool success = audioOperationAll(m_activeSounds, SoundState::Playing, "resumeAll") &&
+                           audioOperationAll(m_activeMusic, SoundState::Playing, "resumeAll");
+            return success;
         }
 
         bool SoundManager::stopSound(SoundHandle handle)
         {
+            if (m_commandQueueEnabled)
+                return queueOperation(false, handle, CommandType::Stop);
+
             std::lock_guard<std::mutex> lock(m_mutex);
 
             return audioOperation(m_activeSounds, handle, SoundState::Stopped, "stopSound");
@@ -733,6 +1908,9 @@ namespace soundcoe
 
         bool SoundManager::stopMusic(MusicHandle handle)
         {
+            if (m_commandQueueEnabled)
+                return queueOperation(true, handle, CommandType::Stop);
+
             std::lock_guard<std::mutex> lock(m_mutex);
 
             return audioOperation(m_activeMusic, handle, SoundState::Stopped, "stopMusic");
@@ -741,6 +1919,7 @@ namespace soundcoe
         bool SoundManager::stopAllSounds()
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
             return audioOperationAll(m_activeSounds, SoundState::Stopped, "stopAllSounds");
         }
@@ -748,6 +1927,7 @@ namespace soundcoe
         bool SoundManager::stopAllMusic()
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
             return audioOperationAll(m_activeMusic, SoundState::Stopped, "stopAllMusic");
         }
@@ -755,13 +1935,19 @@ namespace soundcoe
         bool SoundManager::stopAll()
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
-            return audioOperationAll(m_activeSounds, SoundState::Stopped, "stopAll") &&
-                   audioOperationAll(m_activeMusic, SoundState::Stopped, "stopAll");
+            DeferredUpdates deferred(m_resourceManager);
+            bool success = audioOperationAll(m_activeSounds, SoundState::Stopped, "stopAll") &&
+                           audioOperationAll(m_activeMusic, SoundState::Stopped, "stopAll");
+            return success;
         }
 
         bool SoundManager::setSoundVolume(SoundHandle handle, float volume)
         {
+            if (m_commandQueueEnabled)
+                return queueOperation(false, handle, CommandType::SetProperty, PropertyType::Volume, volume);
+
             std::lock_guard<std::mutex> lock(m_mutex);
 
             return setAudioProperty(m_activeSounds, handle, PropertyType::Volume, "setSoundVolume", volume);
@@ -769,6 +1955,9 @@ namespace soundcoe
 
         bool SoundManager::setMusicVolume(MusicHandle handle, float volume)
         {
+            if (m_commandQueueEnabled)
+                return queueOperation(true, handle, CommandType::SetProperty, PropertyType::Volume, volume);
+
             std::lock_guard<std::mutex> lock(m_mutex);
 
             return setAudioProperty(m_activeMusic, handle, PropertyType::Volume, "setMusicVolume", volume);
@@ -776,6 +1965,9 @@ namespace soundcoe
 
         bool SoundManager::setSoundPitch(SoundHandle handle, float pitch)
         {
+            if (m_commandQueueEnabled)
+                return queueOperation(false, handle, CommandType::SetProperty, PropertyType::Pitch, pitch);
+
             std::lock_guard<std::mutex> lock(m_mutex);
 
             return setAudioProperty(m_activeSounds, handle, PropertyType::Pitch, "setSoundPitch", pitch);
@@ -783,6 +1975,9 @@ namespace soundcoe
 
         bool SoundManager::setMusicPitch(MusicHandle handle, float pitch)
         {
+            if (m_commandQueueEnabled)
+                return queueOperation(true, handle, CommandType::SetProperty, PropertyType::Pitch, pitch);
+
             std::lock_guard<std::mutex> lock(m_mutex);
 
             return setAudioProperty(m_activeMusic, handle, PropertyType::Pitch, "setMusicPitch", pitch);
@@ -790,6 +1985,9 @@ namespace soundcoe
 
         bool SoundManager::setSoundPosition(SoundHandle handle, const Vec3 &position)
         {
+            if (m_commandQueueEnabled)
+                return queueOperation(false, handle, CommandType::SetProperty, PropertyType::Position, 0.0f, position);
+
             std::lock_guard<std::mutex> lock(m_mutex);
 
             return setAudioProperty(m_activeSounds, handle, PropertyType::Position, "setSoundPosition",
@@ -798,6 +1996,9 @@ namespace soundcoe
 
         bool SoundManager::setSoundVelocity(SoundHandle handle, const Vec3 &velocity)
         {
+            if (m_commandQueueEnabled)
+                return queueOperation(false, handle, CommandType::SetProperty, PropertyType::Velocity, 0.0f, velocity);
+
             std::lock_guard<std::mutex> lock(m_mutex);
 
             return setAudioProperty(m_activeSounds, handle, PropertyType::Velocity, "setSoundVelocity",
@@ -846,6 +2047,107 @@ namespace soundcoe
             return checkAudioState(m_activeMusic, handle, SoundState::Stopped, "isMusicStopped");
         }
 
+        std::vector<SoundHandle> SoundManager::playSounds(const std::vector<PlayRequest> &requests)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            // Calls still in the command queue were made before this one
+            processCommands();
+
+            std::vector<SoundHandle> handles;
+            handles.reserve(requests.size());
+            DeferredUpdates deferred(m_resourceManager);
+            for (const PlayRequest &request : requests)
+            {
+                std::string filename = request.id.isValid() ? std::string() : m_soundSubdir + request.filename;
+                handles.push_back(play(m_activeSounds, filename, request.id, request.volume, request.pitch, request.loop,
+                                       request.priority, "playSounds", m_masterSoundsVolume,
+                                       m_masterSoundsPitch, request.is3D, request.position, request.velocity,
+                                       request.maxDistance));
+            }
+            return handles;
+        }
+
+        bool SoundManager::setSoundPositions(const std::vector<std::pair<SoundHandle, Vec3>> &positions)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            processCommands();
+
+            bool success = true;
+            DeferredUpdates deferred(m_resourceManager);
+            for (const auto &entry : positions)
+            {
+                auto it = m_activeSounds.find(entry.first);
+                if (it == m_activeSounds.end())
+                {
+                    success = setError("SoundManager::setSoundPositions: Invalid handle " + std::to_string(entry.first));
+                    continue;
+                }
+
+                ActiveAudio &audio = it->second;
+                virtualizeIfStolen(audio);
+                audio.m_position = entry.second;
+                if (audio.m_virtual)
+                    continue;
+
+                auto sourceAllocation = m_resourceManager.getSourceAllocation(audio.m_sourceIndex);
+                if (!(sourceAllocation.has_value()) || !(sourceAllocation.value().get().m_active))
+                {
+                    m_activeSounds.erase(it);
+                    success = setError("SoundManager::setSoundPositions: handle " + std::to_string(entry.first) +
+                                       " is no longer active");
+                    continue;
+                }
+                if (sourceAllocation.value().get().m_allocatedTime != audio.m_sourceAllocatedTime)
+                {
+                    success = setError("SoundManager::setSoundPositions: handle " + std::to_string(entry.first) +
+                                       " lost its source");
+                    continue;
+                }
+
+                sourceAllocation.value().get().m_source->setPosition(entry.second, false);
+            }
+            // One error check for the whole batch instead of one per source
+            if (ErrorHandler::checkOpenALError("Set Positions"))
+                success = setError("SoundManager::setSoundPositions: Failed to set the source positions");
+            return success;
+        }
+
+        std::vector<SoundState> SoundManager::getSoundStates(const std::vector<SoundHandle> &handles)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            // Handles that finished and were reaped by update() report Stopped
+            std::vector<SoundState> states;
+            states.reserve(handles.size());
+            for (SoundHandle handle : handles)
+            {
+                auto it = m_activeSounds.find(handle);
+                if (it == m_activeSounds.end())
+                {
+                    states.push_back(SoundState::Stopped);
+                    continue;
+                }
+
+                ActiveAudio &audio = it->second;
+                virtualizeIfStolen(audio);
+                if (audio.m_virtual)
+                {
+                    states.push_back(audio.m_paused ? SoundState::Paused : SoundState::Playing);
+                    continue;
+                }
+
+                auto sourceAllocation = m_resourceManager.getSourceAllocation(audio.m_sourceIndex);
+                if (!(sourceAllocation.has_value()) || !(sourceAllocation.value().get().m_active) ||
+                    sourceAllocation.value().get().m_allocatedTime != audio.m_sourceAllocatedTime)
+                    states.push_back(SoundState::Stopped);
+                else
+                    states.push_back(sourceAllocation.value().get().m_source->getState());
+            }
+            return states;
+        }
+
         size_t SoundManager::getActiveSoundsCount() const
         {
             std::lock_guard<std::mutex> lock(m_mutex);
@@ -862,14 +2164,15 @@ namespace soundcoe
                                               float volume, float pitch, bool loop, SoundPriority priority)
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
-            SoundHandle handle = play(m_activeSounds, m_soundSubdir + filename, 0.0f, pitch, loop, priority, m_nextSoundHandle, "fadeInSound",
+            SoundHandle handle = play(m_activeSounds, m_soundSubdir + filename, INVALID_SOUND_ID, 0.0f, pitch, loop, priority, "fadeInSound",
                                       m_masterSoundsVolume, m_masterSoundsPitch);
 
             if (!isHandleValid(handle))
                 return INVALID_SOUND_HANDLE;
 
-            ActiveAudio &sound = m_activeSounds[handle];
+            ActiveAudio &sound = m_activeSounds.find(handle)->second;
             sound.m_baseVolume = volume;
 
             if (fade(m_activeSounds, handle, true, duration, "fadeInSound"))
@@ -883,13 +2186,14 @@ namespace soundcoe
                                               float volume, float pitch, bool loop, SoundPriority priority)
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
-            MusicHandle handle = play(m_activeMusic, m_musicSubdir + filename, 0.0f, pitch, loop, priority, m_nextMusicHandle, "fadeInMusic",
+            MusicHandle handle = play(m_activeMusic, m_musicSubdir + filename, INVALID_SOUND_ID, 0.0f, pitch, loop, priority, "fadeInMusic",
                                       m_masterMusicVolume, m_masterMusicPitch);
             if (!isHandleValid(handle))
                 return INVALID_MUSIC_HANDLE;
 
-            ActiveAudio &music = m_activeMusic[handle];
+            ActiveAudio &music = m_activeMusic.find(handle)->second;
             music.m_baseVolume = volume;
 
             if (fade(m_activeMusic, handle, true, duration, "fadeInMusic"))
@@ -902,6 +2206,7 @@ namespace soundcoe
         bool SoundManager::fadeOutSound(SoundHandle handle, float duration)
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
             return fade(m_activeSounds, handle, false, duration, "fadeOutSound");
         }
@@ -909,6 +2214,7 @@ namespace soundcoe
         bool SoundManager::fadeOutMusic(MusicHandle handle, float duration)
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
             return fade(m_activeMusic, handle, false, duration, "fadeOutMusic");
         }
@@ -916,6 +2222,7 @@ namespace soundcoe
         bool SoundManager::fadeToVolumeSound(SoundHandle handle, float targetVolume, float duration)
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
             return fadeToVolume(m_activeSounds, handle, targetVolume, duration, "fadeToVolumeSound");
         }
@@ -923,6 +2230,7 @@ namespace soundcoe
         bool SoundManager::fadeToVolumeMusic(MusicHandle handle, float targetVolume, float duration)
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
             return fadeToVolume(m_activeMusic, handle, targetVolume, duration, "fadeToVolumeMusic");
         }
@@ -930,7 +2238,9 @@ namespace soundcoe
         bool SoundManager::setMasterVolume(float volume)
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
+            DeferredUpdates deferred(m_resourceManager);
             m_masterVolume = volume;
             updateAllVolume();
 
@@ -940,7 +2250,9 @@ namespace soundcoe
         bool SoundManager::setMasterSoundsVolume(float volume)
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
+            DeferredUpdates deferred(m_resourceManager);
             m_masterSoundsVolume = volume;
             updateAllSoundsVolume();
 
@@ -950,7 +2262,9 @@ namespace soundcoe
         bool SoundManager::setMasterMusicVolume(float volume)
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
+            DeferredUpdates deferred(m_resourceManager);
             m_masterMusicVolume = volume;
             updateAllMusicVolume();
 
@@ -960,7 +2274,9 @@ namespace soundcoe
         bool SoundManager::setMasterPitch(float pitch)
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
+            DeferredUpdates deferred(m_resourceManager);
             m_masterPitch = pitch;
             updateAllPitch();
 
@@ -970,7 +2286,9 @@ namespace soundcoe
         bool SoundManager::setMasterSoundsPitch(float pitch)
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
+            DeferredUpdates deferred(m_resourceManager);
             m_masterSoundsPitch = pitch;
             updateAllSoundsPitch();
 
@@ -980,7 +2298,9 @@ namespace soundcoe
         bool SoundManager::setMasterMusicPitch(float pitch)
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
+            DeferredUpdates deferred(m_resourceManager);
             m_masterMusicPitch = pitch;
             updateAllMusicPitch();
 
@@ -1032,7 +2352,9 @@ namespace soundcoe
         bool SoundManager::muteAllSounds()
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
+            DeferredUpdates deferred(m_resourceManager);
             m_soundsMute = true;
             updateAllSoundsVolume();
 
@@ -1042,7 +2364,9 @@ namespace soundcoe
         bool SoundManager::muteAllMusic()
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
+            DeferredUpdates deferred(m_resourceManager);
             m_musicMute = true;
             updateAllMusicVolume();
 
@@ -1052,7 +2376,9 @@ namespace soundcoe
         bool SoundManager::muteAll()
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
+            DeferredUpdates deferred(m_resourceManager);
             m_mute = true;
             updateAllVolume();
 
@@ -1062,7 +2388,9 @@ namespace soundcoe
         bool SoundManager::unmuteAllSounds()
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
+            DeferredUpdates deferred(m_resourceManager);
             m_soundsMute = false;
             updateAllSoundsVolume();
 
@@ -1072,7 +2400,9 @@ namespace soundcoe
         bool SoundManager::unmuteAllMusic()
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
+            DeferredUpdates deferred(m_resourceManager);
             m_musicMute = false;
             updateAllMusicVolume();
 
@@ -1082,9 +2412,10 @@ namespace soundcoe
         bool SoundManager::unmuteAll()
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
+            DeferredUpdates deferred(m_resourceManager);
             m_mute = m_soundsMute = m_musicMute = false;
-
             updateAllVolume();
 
             return true;
@@ -1114,15 +2445,19 @@ namespace soundcoe
         bool SoundManager::updateListener(const Vec3 &position, const Vec3 &velocity, const Vec3 &forward, const Vec3 &up)
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
-            return setListenerPositionImpl(position) &&
-                   setListenerVelocityImpl(velocity) &&
-                   setListenerOrientationImpl(forward, up);
+            DeferredUpdates deferred(m_resourceManager);
+            bool success = setListenerPositionImpl(position) &&
+                           setListenerVelocityImpl(velocity) &&
+                           setListenerOrientationImpl(forward, up);
+            return success;
         }
 
         bool SoundManager::setListenerPosition(const Vec3 &position)
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
             return setListenerPositionImpl(position);
         }
@@ -1130,6 +2465,7 @@ namespace soundcoe
         bool SoundManager::setListenerVelocity(const Vec3 &velocity)
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
             return setListenerVelocityImpl(velocity);
         }
@@ -1137,6 +2473,7 @@ namespace soundcoe
         bool SoundManager::setListenerForward(const Vec3 &forward)
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
             return setListenerOrientationImpl(forward, m_listenerUp);
         }
@@ -1144,6 +2481,7 @@ namespace soundcoe
         bool SoundManager::setListenerUp(const Vec3 &up)
         {
             std::lock_guard<std::mutex> lock(m_mutex);
+            processCommands();
 
             return setListenerOrientationImpl(m_listenerForward, up);
         }
@@ -1,7 +1,16 @@
 #include <soundcoe/resources/audio_data.hpp>
 #include <soundcoe/core/error_handler.hpp>
+#include <soundcoe/utils/mapped_file.hpp>
+#include <soundcoe/utils/pcm.hpp>
+#include <soundcoe/utils/adpcm.hpp>
+#include <AL/alext.h>
 #include <logcoe.hpp>
+#include <algorithm>
 #include <exception>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <fstream>
 
 #define DR_WAV_IMPLEMENTATION
 #include <dr_libs/dr_wav.h>
@@ -30,6 +39,14 @@ namespace soundcoe
             if (!m_pcmData)
                 return;
 
+            if (m_mappedFile.isOpen())
+            {
+                // Samples live inside the file mapping
+                m_mappedFile.close();
+                m_pcmData = nullptr;
+                return;
+            }
+
             switch (m_sourceFormat)
             {
             case AudioFormat::Wav:
@@ -47,12 +64,15 @@ namespace soundcoe
 
         ALenum AudioData::calculateOpenALFormat(ALsizei channels, ALsizei bitsPerSample)
         {
+            // 32-bit samples are only ever produced as float
             if (channels == 1)
             {
                 if (bitsPerSample == 8)
                     return AL_FORMAT_MONO8;
                 if (bitsPerSample == 16)
                     return AL_FORMAT_MONO16;
+                if (bitsPerSample == 32)
+                    return AL_FORMAT_MONO_FLOAT32;
             }
             else if (channels == 2)
             {
@@ -60,6 +80,8 @@ namespace soundcoe
                     return AL_FORMAT_STEREO8;
                 if (bitsPerSample == 16)
                     return AL_FORMAT_STEREO16;
+                if (bitsPerSample == 32)
+                    return AL_FORMAT_STEREO_FLOAT32;
             }
 
             return AL_NONE;
@@ -67,7 +89,8 @@ namespace soundcoe
 
         AudioData::AudioData(AudioData &&other) noexcept : m_pcmData(other.m_pcmData), m_pcmDataSize(other.m_pcmDataSize), m_channels(other.m_channels),
                                                         m_bitsPerSample(other.m_bitsPerSample), m_sampleRate(other.m_sampleRate), m_duration(other.m_duration),
-                                                        m_openALFormat(other.m_openALFormat), m_sourceFormat(other.m_sourceFormat)
+                                                        m_openALFormat(other.m_openALFormat), m_sourceFormat(other.m_sourceFormat),
+                                                        m_mappedFile(std::move(other.m_mappedFile))
         {
             other.m_pcmData = nullptr;
         }
@@ -87,6 +110,7 @@ namespace soundcoe
             m_duration = other.m_duration;
             m_openALFormat = other.m_openALFormat;
             m_sourceFormat = other.m_sourceFormat;
+            m_mappedFile = std::move(other.m_mappedFile);
 
             other.m_pcmData = nullptr;
             return *this;
@@ -94,60 +118,368 @@ namespace soundcoe
 
         AudioData::~AudioData() { cleanup(); }
 
-        AudioData AudioData::loadFromWav(const std::string &filename)
+        AudioData AudioData::loadFromFile(const std::string &filename, const DecodeOptions &options)
         {
-            unsigned int channels, sampleRate, bitsPerSample;
-            drwav_uint64 totalFrameCount;
-            void *pcmData;
-            drwav wav;
-            if (!drwav_init_file(&wav, filename.c_str(), nullptr))
+            MappedFile file;
+            if (!file.open(filename))
+                ErrorHandler::throwOnAudioError(filename, AudioFormat::Unsupported, AudioDecoderOperation::OpenFile);
+
+            return loadFromFile(std::move(file), options);
+        }
+
+        AudioData AudioData::loadFromFile(MappedFile &&file, const DecodeOptions &options)
+        {
+            if (detectFormat(file.data(), file.size()) == AudioFormat::Wav)
+                return loadFromMappedFile(std::move(file), options);
+
+            return loadFromMemory(file.data(), file.size(), file.getFileName(), options);
+        }
+
+        AudioData AudioData::loadFromWav(const std::string &filename, const DecodeOptions &options)
+        {
+            MappedFile file;
+            if (!file.open(filename))
                 ErrorHandler::throwOnAudioError(filename, AudioFormat::Wav, AudioDecoderOperation::OpenFile);
 
-            bitsPerSample = wav.bitsPerSample;
-            drwav_uninit(&wav);
+            return loadFromMappedFile(std::move(file), options);
+        }
+
+        AudioData AudioData::loadFromMappedFile(MappedFile &&file, const DecodeOptions &options)
+        {
+            ALsizei channels, sampleRate;
+            size_t pcmOffset, pcmSize;
+            if (!findPcm16WavData(file.data(), file.size(), channels, sampleRate, pcmOffset, pcmSize))
+                return loadFromWavMemory(file.data(), file.size(), file.getFileName(), options);
+
+            // The data chunk already holds what OpenAL wants, hand it over without decoding or copying
+            ALvoid *pcmData = const_cast<uint8_t *>(file.data() + pcmOffset);
+            AudioData audioData(pcmData, static_cast<ALsizei>(pcmSize), channels, 16, sampleRate, AudioFormat::Wav);
+            audioData.m_mappedFile = std::move(file);
+            audioData.applyDecodeOptions(options);
+            return audioData;
+        }
 
-            pcmData = (bitsPerSample <= 16) ? (void *)drwav_open_file_and_read_pcm_frames_s16(filename.c_str(), &channels, &sampleRate,
-                                                                                            &totalFrameCount, nullptr)
-                                            : (void *)drwav_open_file_and_read_pcm_frames_s32(filename.c_str(), &channels, &sampleRate,
-                                                                                            &totalFrameCount, nullptr);
+        bool AudioData::findPcm16WavData(const uint8_t *data, size_t size, ALsizei &channels, ALsizei &sampleRate,
+                                         size_t &pcmOffset, size_t &pcmSize)
+        {
+            auto readU16 = [](const uint8_t *bytes)
+            { return static_cast<uint32_t>(bytes[0] | (bytes[1] << 8)); };
+            auto readU32 = [](const uint8_t *bytes)
+            { return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+                     (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24); };
+
+            // WAV samples are little endian, big endian hosts go through the decoder
+            const uint16_t endianProbe = 1;
+            if (*reinterpret_cast<const uint8_t *>(&endianProbe) != 1)
+                return false;
+
+            if (!data || size < 12 || std::memcmp(data, "RIFF", 4) != 0 || std::memcmp(data + 8, "WAVE", 4) != 0)
+                return false;
+
+            bool hasFormat = false;
+            uint32_t blockAlign = 0;
+            size_t offset = 12;
+            while (offset + 8 <= size)
+            {
+                const uint8_t *chunk = data + offset;
+                size_t chunkSize = readU32(chunk + 4);
+                size_t bodyOffset = offset + 8;
+
+                if (std::memcmp(chunk, "fmt ", 4) == 0)
+                {
+                    if (chunkSize < 16 || bodyOffset + chunkSize > size)
+                        return false;
+
+                    const uint8_t *format = data + bodyOffset;
+                    uint32_t formatTag = readU16(format);
+                    uint32_t bitsPerSample = readU16(format + 14);
+                    // WAVE_FORMAT_EXTENSIBLE keeps the real format tag at the start of its sub format GUID
+                    if (formatTag == 0xFFFE && chunkSize >= 40)
+                        formatTag = readU16(format + 24);
+
+                    channels = static_cast<ALsizei>(readU16(format + 2));
+                    sampleRate = static_cast<ALsizei>(readU32(format + 4));
+                    blockAlign = readU16(format + 12);
+                    if (formatTag != 1 || bitsPerSample != 16 || (channels != 1 && channels != 2) ||
+                        sampleRate <= 0 || blockAlign != static_cast<uint32_t>(channels) * 2)
+                        return false;
+                    hasFormat = true;
+                }
+                else if (std::memcmp(chunk, "data", 4) == 0)
+                {
+                    if (!hasFormat)
+                        return false;
+
+                    // Truncated files keep whatever whole frames made it to disk
+                    size_t available = std::min(chunkSize, size - bodyOffset);
+                    pcmOffset = bodyOffset;
+                    pcmSize = available - available % blockAlign;
+                    return pcmSize > 0 && pcmSize <= static_cast<size_t>(std::numeric_limits<ALsizei>::max());
+                }
+
+                // Chunks are padded to an even size
+                offset = bodyOffset + chunkSize + (chunkSize & 1);
+            }
+
+            return false;
+        }
+
+        AudioData AudioData::loadFromOgg(const std::string &filename, const DecodeOptions &options)
+        {
+            MappedFile file;
+            if (!file.open(filename))
+                ErrorHandler::throwOnAudioError(filename, AudioFormat::Ogg, AudioDecoderOperation::OpenFile);
+
+            return loadFromOggMemory(file.data(), file.size(), filename, options);
+        }
 
+        AudioData AudioData::loadFromMp3(const std::string &filename, const DecodeOptions &options)
+        {
+            MappedFile file;
+            if (!file.open(filename))
+                ErrorHandler::throwOnAudioError(filename, AudioFormat::Mp3, AudioDecoderOperation::OpenFile);
+
+            return loadFromMp3Memory(file.data(), file.size(), filename, options);
+        }
+
+        AudioData AudioData::loadFromMemory(const void *data, size_t size, const std::string &name,
+                                            const DecodeOptions &options)
+        {
+            AudioFormat format = detectFormat(data, size);
+            switch (format)
+            {
+            case AudioFormat::Wav:
+                return loadFromWavMemory(data, size, name, options);
+            case AudioFormat::Mp3:
+                return loadFromMp3Memory(data, size, name, options);
+            case AudioFormat::Ogg:
+                return loadFromOggMemory(data, size, name, options);
+            default:
+                std::string message = "AudioData::loadFromMemory: Unsupported audio format: " + name;
+                logcoe::error(message);
+                throw std::runtime_error(message);
+            }
+        }
+
+        AudioData AudioData::loadFromWavMemory(const void *data, size_t size, const std::string &name,
+                                               const DecodeOptions &options)
+        {
+            drwav wav;
+            if (!drwav_init_memory(&wav, data, size, nullptr))
+                ErrorHandler::throwOnAudioError(name, AudioFormat::Wav, AudioDecoderOperation::DecodeAudio);
+
+            unsigned int channels = wav.channels;
+            unsigned int sampleRate = wav.sampleRate;
+            bool floatSource = wav.translatedFormatTag == DR_WAVE_FORMAT_IEEE_FLOAT;
+            bool highResolution = floatSource || (wav.translatedFormatTag == DR_WAVE_FORMAT_PCM && wav.bitsPerSample > 16);
+            bool keepFloat = highResolution && options.floatOutput;
+            size_t sampleCount = static_cast<size_t>(wav.totalPCMFrameCount) * channels;
+
+            // 32-bit wide staging for high resolution sources, the 16-bit result is written over it in place.
+            // Allocated like dr_wav does so cleanup() can hand it to drwav_free
+            size_t sampleSize = highResolution ? sizeof(float) : sizeof(drwav_int16);
+            void *pcmData = sampleCount > 0 ? DRWAV_MALLOC(sampleCount * sampleSize) : nullptr;
             if (!pcmData)
-                ErrorHandler::throwOnAudioError(filename, AudioFormat::Wav, AudioDecoderOperation::DecodeAudio);
+            {
+                drwav_uninit(&wav);
+                ErrorHandler::throwOnAudioError(name, AudioFormat::Wav, AudioDecoderOperation::DecodeAudio);
+            }
+
+            // Everything up to 16-bit goes through dr_wav's own 16-bit conversion
+            drwav_uint64 framesRead;
+            if (keepFloat || floatSource)
+                framesRead = drwav_read_pcm_frames_f32(&wav, wav.totalPCMFrameCount, static_cast<float *>(pcmData));
+            else if (highResolution)
+                framesRead = drwav_read_pcm_frames_s32(&wav, wav.totalPCMFrameCount, static_cast<drwav_int32 *>(pcmData));
+            else
+                framesRead = drwav_read_pcm_frames_s16(&wav, wav.totalPCMFrameCount, static_cast<drwav_int16 *>(pcmData));
+            drwav_uninit(&wav);
+
+            if (framesRead == 0)
+            {
+                drwav_free(pcmData, nullptr);
+                ErrorHandler::throwOnAudioError(name, AudioFormat::Wav, AudioDecoderOperation::DecodeAudio);
+            }
+
+            sampleCount = static_cast<size_t>(framesRead) * channels;
+            if (highResolution && !keepFloat)
+            {
+                if (floatSource)
+                    pcm::convertFloatToS16(static_cast<float *>(pcmData), static_cast<int16_t *>(pcmData), sampleCount);
+                else
+                    pcm::convertS32ToS16(static_cast<int32_t *>(pcmData), static_cast<int16_t *>(pcmData), sampleCount);
+            }
 
-            ALsizei bytesPerSample = (bitsPerSample <= 16) ? sizeof(drwav_int16) : sizeof(drwav_int32);
-            ALsizei pcmDataSize = static_cast<ALsizei>(totalFrameCount * channels * bytesPerSample);
+            ALsizei bitsPerSample = keepFloat ? 32 : 16;
+            ALsizei pcmDataSize = static_cast<ALsizei>(sampleCount * (bitsPerSample / 8));
 
-            return AudioData(pcmData, pcmDataSize, static_cast<ALsizei>(channels), static_cast<ALsizei>(bitsPerSample),
-                            static_cast<ALsizei>(sampleRate), AudioFormat::Wav);
+            AudioData audioData(pcmData, pcmDataSize, static_cast<ALsizei>(channels), bitsPerSample,
+                                static_cast<ALsizei>(sampleRate), AudioFormat::Wav);
+            audioData.applyDecodeOptions(options);
+            return audioData;
         }
 
-        AudioData AudioData::loadFromOgg(const std::string &filename)
+        AudioData AudioData::loadFromOggMemory(const void *data, size_t size, const std::string &name,
+                                               const DecodeOptions &options)
         {
             int channels, sampleRate;
             short *pcmData;
-            int totalSamples = stb_vorbis_decode_filename(filename.c_str(), &channels, &sampleRate, &pcmData);
+            int totalSamples = stb_vorbis_decode_memory(static_cast<const unsigned char *>(data), static_cast<int>(size),
+                                                        &channels, &sampleRate, &pcmData);
             if (totalSamples <= 0 || !pcmData)
-                ErrorHandler::throwOnAudioError(filename, AudioFormat::Ogg, AudioDecoderOperation::DecodeAudio);
+                ErrorHandler::throwOnAudioError(name, AudioFormat::Ogg, AudioDecoderOperation::DecodeAudio);
 
-            ALsizei pcmDataSize = static_cast<ALsizei>(totalSamples * sizeof(short));
+            // stb_vorbis_decode_memory returns samples per channel
+            ALsizei pcmDataSize = static_cast<ALsizei>(static_cast<size_t>(totalSamples) * channels * sizeof(short));
 
-            return AudioData(pcmData, pcmDataSize, static_cast<ALsizei>(channels), 16,
-                            static_cast<ALsizei>(sampleRate), AudioFormat::Ogg);
+            AudioData audioData(pcmData, pcmDataSize, static_cast<ALsizei>(channels), 16,
+                                static_cast<ALsizei>(sampleRate), AudioFormat::Ogg);
+            audioData.applyDecodeOptions(options);
+            return audioData;
         }
 
-        AudioData AudioData::loadFromMp3(const std::string &filename)
+        AudioData AudioData::loadFromMp3Memory(const void *data, size_t size, const std::string &name,
+                                               const DecodeOptions &options)
         {
             drmp3_config config;
             drmp3_uint64 totalFrameCount;
 
-            drmp3_int16 *pcmData = drmp3_open_file_and_read_pcm_frames_s16(filename.c_str(), &config, &totalFrameCount, nullptr);
+            drmp3_int16 *pcmData = drmp3_open_memory_and_read_pcm_frames_s16(data, size, &config, &totalFrameCount, nullptr);
             if (!pcmData)
-                ErrorHandler::throwOnAudioError(filename, AudioFormat::Mp3, AudioDecoderOperation::DecodeAudio);
+                ErrorHandler::throwOnAudioError(name, AudioFormat::Mp3, AudioDecoderOperation::DecodeAudio);
 
             ALsizei pcmDataSize = static_cast<ALsizei>(totalFrameCount * config.channels * sizeof(drmp3_int16));
 
-            return AudioData(pcmData, pcmDataSize, static_cast<ALsizei>(config.channels), 16,
-                            static_cast<ALsizei>(config.sampleRate), AudioFormat::Mp3);
+            AudioData audioData(pcmData, pcmDataSize, static_cast<ALsizei>(config.channels), 16,
+                                static_cast<ALsizei>(config.sampleRate), AudioFormat::Mp3);
+            audioData.applyDecodeOptions(options);
+            return audioData;
+        }
+
+        void AudioData::applyDecodeOptions(const DecodeOptions &options)
+        {
+            // Downmix first so the resampler has half the channels to run through
+            if (options.downmixToMono)
+                downmixToMono();
+            if (options.targetSampleRate > 0)
+                resampleTo(options.targetSampleRate);
+            // Compress last, the encoders only take 16-bit PCM
+            if (options.compression != BufferCompression::None)
+                compress(options.compression);
+        }
+
+        void AudioData::downmixToMono()
+        {
+            if (m_channels != 2 || !m_pcmData)
+                return;
+
+            size_t sampleSize = static_cast<size_t>(m_bitsPerSample / 8);
+            size_t frameCount = static_cast<size_t>(m_pcmDataSize) / (sampleSize * 2);
+            void *output = m_pcmData;
+            if (m_mappedFile.isOpen())
+            {
+                // The mapping is read only, the mono copy gets its own buffer (released through drwav_free, which
+                // ends in free) and the file is closed
+                output = std::malloc(frameCount * sampleSize);
+                if (!output)
+                {
+                    logcoe::warning("AudioData::downmixToMono: Out of memory, keeping \"" + m_mappedFile.getFileName() + "\" stereo");
+                    return;
+                }
+            }
+
+            if (m_bitsPerSample == 32)
+                pcm::downmixStereoToMono(static_cast<const float *>(m_pcmData), static_cast<float *>(output), frameCount);
+            else if (m_bitsPerSample == 16)
+                pcm::downmixStereoToMono(static_cast<const int16_t *>(m_pcmData), static_cast<int16_t *>(output), frameCount);
+            else
+            {
+                if (output != m_pcmData)
+                    std::free(output);
+                return;
+            }
+
+            if (m_mappedFile.isOpen())
+            {
+                m_mappedFile.close();
+                m_pcmData = output;
+            }
+
+            m_channels = 1;
+            m_pcmDataSize = static_cast<ALsizei>(frameCount * sampleSize);
+            m_openALFormat = calculateOpenALFormat(m_channels, m_bitsPerSample);
+        }
+
+        void AudioData::resampleTo(ALsizei sampleRate)
+        {
+            if (sampleRate <= 0 || sampleRate == m_sampleRate || !m_pcmData || m_channels <= 0 ||
+                (m_bitsPerSample != 16 && m_bitsPerSample != 32))
+                return;
+
+            size_t sampleSize = static_cast<size_t>(m_bitsPerSample / 8);
+            size_t channels = static_cast<size_t>(m_channels);
+            size_t frameCount = static_cast<size_t>(m_pcmDataSize) / (sampleSize * channels);
+            size_t outputFrames = pcm::getResampledFrameCount(frameCount, m_sampleRate, sampleRate);
+            size_t outputSize = outputFrames * channels * sampleSize;
+            if (outputFrames == 0 || outputSize > static_cast<size_t>(std::numeric_limits<ALsizei>::max()))
+                return;
+
+            // Every decoder allocates with malloc, so cleanup() releases this buffer the same way
+            void *output = std::malloc(outputSize);
+            if (!output)
+            {
+                logcoe::warning("AudioData::resampleTo: Out of memory, keeping the original sample rate");
+                return;
+            }
+
+            if (m_bitsPerSample == 32)
+                pcm::resample(static_cast<const float *>(m_pcmData), static_cast<float *>(output), frameCount, channels,
+                              m_sampleRate, sampleRate);
+            else
+                pcm::resample(static_cast<const int16_t *>(m_pcmData), static_cast<int16_t *>(output), frameCount, channels,
+                              m_sampleRate, sampleRate);
+
+            cleanup();
+            m_pcmData = output;
+            m_pcmDataSize = static_cast<ALsizei>(outputSize);
+            m_sampleRate = sampleRate;
+        }
+
+        void AudioData::compress(BufferCompression compression)
+        {
+            if (compression == BufferCompression::None || !m_pcmData || m_bitsPerSample != 16 ||
+                (m_channels != 1 && m_channels != 2))
+                return;
+
+            bool ima4 = compression == BufferCompression::Ima4;
+            size_t channels = static_cast<size_t>(m_channels);
+            size_t frameCount = static_cast<size_t>(m_pcmDataSize) / (2 * channels);
+            size_t blockCount = adpcm::getBlockCount(frameCount, ima4 ? adpcm::IMA4_FRAMES_PER_BLOCK
+                                                                      : adpcm::MSADPCM_FRAMES_PER_BLOCK);
+            size_t outputSize = blockCount * (ima4 ? adpcm::getIma4BlockSize(channels) : adpcm::getMsAdpcmBlockSize(channels));
+
+            // Released by cleanup() like every decoder's malloc'd buffer
+            uint8_t *output = static_cast<uint8_t *>(std::malloc(outputSize));
+            if (!output)
+            {
+                logcoe::warning("AudioData::compress: Out of memory, keeping 16-bit PCM");
+                return;
+            }
+
+            const int16_t *samples = static_cast<const int16_t *>(m_pcmData);
+            if (ima4)
+                adpcm::encodeIma4(samples, output, frameCount, channels);
+            else
+                adpcm::encodeMsAdpcm(samples, output, frameCount, channels);
+
+            cleanup();
+            m_pcmData = output;
+            m_pcmDataSize = static_cast<ALsizei>(outputSize);
+            m_bitsPerSample = 4;
+            if (ima4)
+                m_openALFormat = m_channels == 1 ? AL_FORMAT_MONO_IMA4 : AL_FORMAT_STEREO_IMA4;
+            else
+                m_openALFormat = m_channels == 1 ? AL_FORMAT_MONO_MSADPCM_SOFT : AL_FORMAT_STEREO_MSADPCM_SOFT;
         }
 
         ALvoid *AudioData::getPcmData() const { return m_pcmData; }
@@ -166,41 +498,38 @@ namespace soundcoe
 
         AudioFormat AudioData::getSourceFormat() const { return m_sourceFormat; }
 
+        bool AudioData::isMapped() const { return m_mappedFile.isOpen() && m_pcmData != nullptr; }
+
         ALboolean AudioData::isValid() const { return m_pcmData != nullptr && m_pcmDataSize > 0; }
 
-        bool AudioData::isValidWav(const std::string &filename)
+        AudioFormat AudioData::detectFormat(const std::string &filename)
         {
-            drwav wav;
-            bool valid = drwav_init_file(&wav, filename.c_str(), nullptr);
-            if (valid) 
-                drwav_uninit(&wav);
-            return valid;
-        }
+            uint8_t header[12] = {};
+            std::ifstream file(filename, std::ios::binary);
+            if (!file)
+                return AudioFormat::Unsupported;
 
-        bool AudioData::isValidMp3(const std::string &filename)
-        {
-            drmp3 mp3;
-            bool valid = drmp3_init_file(&mp3, filename.c_str(), nullptr);
-            if (valid)
-                drmp3_uninit(&mp3);
-            return valid;
+            file.read(reinterpret_cast<char *>(header), sizeof(header));
+            return detectFormat(header, static_cast<size_t>(file.gcount()));
         }
 
-        bool AudioData::isValidOgg(const std::string &filename)
+        AudioFormat AudioData::detectFormat(const void *data, size_t size)
         {
-            stb_vorbis* vorbis = stb_vorbis_open_filename(filename.c_str(), nullptr, nullptr);
-            if (!vorbis) return false;
-            
-            stb_vorbis_info info = stb_vorbis_get_info(vorbis);
-            stb_vorbis_close(vorbis);
-            return info.channels > 0 && info.sample_rate > 0;
-        }
+            const uint8_t *bytes = static_cast<const uint8_t *>(data);
+            if (!bytes || size < 4)
+                return AudioFormat::Unsupported;
+
+            if (std::memcmp(bytes, "RIFF", 4) == 0 || std::memcmp(bytes, "RIFX", 4) == 0 ||
+                std::memcmp(bytes, "RF64", 4) == 0 || std::memcmp(bytes, "riff", 4) == 0) // "riff" starts a Wave64 GUID
+                return AudioFormat::Wav;
+            if (std::memcmp(bytes, "OggS", 4) == 0)
+                return AudioFormat::Ogg;
+            if (std::memcmp(bytes, "ID3", 3) == 0)
+                return AudioFormat::Mp3;
+            // Raw MPEG audio frame: 11 sync bits, a valid version and layer III
+            if (bytes[0] == 0xFF && (bytes[1] & 0xE0) == 0xE0 && (bytes[1] & 0x18) != 0x08 && (bytes[1] & 0x06) == 0x02)
+                return AudioFormat::Mp3;
 
-        AudioFormat AudioData::detectFormat(const std::string &filename)
-        {
-            if (isValidWav(filename)) return AudioFormat::Wav;
-            if (isValidMp3(filename)) return AudioFormat::Mp3;
-            if (isValidOgg(filename)) return AudioFormat::Ogg;
             return AudioFormat::Unsupported;
         }
     } // namespace detail
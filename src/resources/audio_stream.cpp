@@ -0,0 +1,279 @@
+#include <soundcoe/resources/audio_stream.hpp>
+#include <soundcoe/resources/audio_data.hpp>
+#include <soundcoe/core/error_handler.hpp>
+#include <logcoe.hpp>
+#include <exception>
+
+#include <dr_libs/dr_wav.h>
+#include <dr_libs/dr_mp3.h>
+#define STB_VORBIS_HEADER_ONLY
+#include <stb/stb_vorbis.c>
+
+namespace soundcoe
+{
+    namespace detail
+    {
+        AudioStream::AudioStream() : m_decoder(nullptr), m_sourceFormat(AudioFormat::Unsupported), m_filename(), m_channels(0),
+                                     m_sampleRate(0), m_openALFormat(AL_NONE), m_totalFrames(0), m_framePosition(0) { }
+
+        AudioStream::AudioStream(const std::string &filename) : AudioStream()
+        {
+            open(filename);
+        }
+
+        AudioStream::AudioStream(AudioStream &&other) noexcept : m_decoder(other.m_decoder), m_sourceFormat(other.m_sourceFormat),
+                                                                 m_filename(std::move(other.m_filename)), m_channels(other.m_channels),
+                                                                 m_sampleRate(other.m_sampleRate), m_openALFormat(other.m_openALFormat),
+                                                                 m_totalFrames(other.m_totalFrames), m_framePosition(other.m_framePosition),
+                                                                 m_mappedFile(std::move(other.m_mappedFile))
+        {
+            other.m_decoder = nullptr;
+            other.m_sourceFormat = AudioFormat::Unsupported;
+        }
+
+        AudioStream &AudioStream::operator=(AudioStream &&other) noexcept
+        {
+            if (this == &other)
+                return *this;
+
+            close();
+
+            m_decoder = other.m_decoder;
+            m_sourceFormat = other.m_sourceFormat;
+            m_filename = std::move(other.m_filename);
+            m_channels = other.m_channels;
+            m_sampleRate = other.m_sampleRate;
+            m_openALFormat = other.m_openALFormat;
+            m_totalFrames = other.m_totalFrames;
+            m_framePosition = other.m_framePosition;
+            m_mappedFile = std::move(other.m_mappedFile);
+
+            other.m_decoder = nullptr;
+            other.m_sourceFormat = AudioFormat::Unsupported;
+            return *this;
+        }
+
+        AudioStream::~AudioStream() { close(); }
+
+        void AudioStream::openWav(const std::string &filename, const void *data, size_t size)
+        {
+            drwav *wav = new drwav;
+            bool initialized = data ? drwav_init_memory(wav, data, size, nullptr) : drwav_init_file(wav, filename.c_str(), nullptr);
+            if (!initialized)
+            {
+                delete wav;
+                ErrorHandler::throwOnAudioError(filename, AudioFormat::Wav, AudioDecoderOperation::OpenFile);
+            }
+
+            m_decoder = wav;
+            m_channels = static_cast<ALsizei>(wav->channels);
+            m_sampleRate = static_cast<ALsizei>(wav->sampleRate);
+            m_totalFrames = wav->totalPCMFrameCount;
+        }
+
+        void AudioStream::openMp3(const std::string &filename, const void *data, size_t size)
+        {
+            drmp3 *mp3 = new drmp3;
+            bool initialized = data ? drmp3_init_memory(mp3, data, size, nullptr) : drmp3_init_file(mp3, filename.c_str(), nullptr);
+            if (!initialized)
+            {
+                delete mp3;
+                ErrorHandler::throwOnAudioError(filename, AudioFormat::Mp3, AudioDecoderOperation::OpenFile);
+            }
+
+            m_decoder = mp3;
+            m_channels = static_cast<ALsizei>(mp3->channels);
+            m_sampleRate = static_cast<ALsizei>(mp3->sampleRate);
+            m_totalFrames = drmp3_get_pcm_frame_count(mp3);
+        }
+
+        void AudioStream::openOgg(const std::string &filename, const void *data, size_t size)
+        {
+            stb_vorbis *vorbis = data ? stb_vorbis_open_memory(static_cast<const unsigned char *>(data), static_cast<int>(size), nullptr, nullptr)
+                                      : stb_vorbis_open_filename(filename.c_str(), nullptr, nullptr);
+            if (!vorbis)
+                ErrorHandler::throwOnAudioError(filename, AudioFormat::Ogg, AudioDecoderOperation::OpenFile);
+
+            stb_vorbis_info info = stb_vorbis_get_info(vorbis);
+            m_decoder = vorbis;
+            m_channels = static_cast<ALsizei>(info.channels);
+            m_sampleRate = static_cast<ALsizei>(info.sample_rate);
+            m_totalFrames = stb_vorbis_stream_length_in_samples(vorbis);
+        }
+
+        void AudioStream::open(const std::string &filename)
+        {
+            close();
+            openDecoder(filename, AudioData::detectFormat(filename), nullptr, 0);
+        }
+
+        void AudioStream::open(MappedFile &&file)
+        {
+            close();
+            m_mappedFile = std::move(file);
+            try
+            {
+                openDecoder(m_mappedFile.getFileName(), AudioData::detectFormat(m_mappedFile.data(), m_mappedFile.size()),
+                            m_mappedFile.data(), m_mappedFile.size());
+            }
+            catch (...)
+            {
+                m_mappedFile.close();
+                throw;
+            }
+        }
+
+        void AudioStream::open(const void *data, size_t size, const std::string &name)
+        {
+            close();
+            openDecoder(name, AudioData::detectFormat(data, size), data, size);
+        }
+
+        void AudioStream::openDecoder(const std::string &filename, AudioFormat format, const void *data, size_t size)
+        {
+            switch (format)
+            {
+            case AudioFormat::Wav:
+                openWav(filename, data, size);
+                break;
+            case AudioFormat::Mp3:
+                openMp3(filename, data, size);
+                break;
+            case AudioFormat::Ogg:
+                openOgg(filename, data, size);
+                break;
+            default:
+                std::string message = "AudioStream::open: Unsupported audio format: " + filename;
+                logcoe::error(message);
+                throw std::runtime_error(message);
+            }
+
+            m_sourceFormat = format;
+            m_filename = filename;
+            m_framePosition = 0;
+            m_openALFormat = (m_channels == 1) ? AL_FORMAT_MONO16 : (m_channels == 2) ? AL_FORMAT_STEREO16 : AL_NONE;
+            if (m_openALFormat == AL_NONE || m_sampleRate <= 0)
+            {
+                close();
+                ErrorHandler::throwOnAudioError(filename, format, AudioDecoderOperation::DecodeAudio);
+            }
+        }
+
+        void AudioStream::close()
+        {
+            if (!m_decoder)
+            {
+                m_mappedFile.close();
+                return;
+            }
+
+            switch (m_sourceFormat)
+            {
+            case AudioFormat::Wav:
+                drwav_uninit(static_cast<drwav *>(m_decoder));
+                delete static_cast<drwav *>(m_decoder);
+                break;
+            case AudioFormat::Mp3:
+                drmp3_uninit(static_cast<drmp3 *>(m_decoder));
+                delete static_cast<drmp3 *>(m_decoder);
+                break;
+            case AudioFormat::Ogg:
+                stb_vorbis_close(static_cast<stb_vorbis *>(m_decoder));
+                break;
+            default:
+                break;
+            }
+
+            m_decoder = nullptr;
+            m_sourceFormat = AudioFormat::Unsupported;
+            m_framePosition = 0;
+            // Decoders read straight from the mapping, it goes once they are gone
+            m_mappedFile.close();
+        }
+
+        size_t AudioStream::readFrames(int16_t *output, size_t frameCount)
+        {
+            if (!m_decoder || !output || frameCount == 0)
+                return 0;
+
+            uint64_t framesRead = 0;
+            switch (m_sourceFormat)
+            {
+            case AudioFormat::Wav:
+                framesRead = drwav_read_pcm_frames_s16(static_cast<drwav *>(m_decoder), frameCount, output);
+                break;
+            case AudioFormat::Mp3:
+                framesRead = drmp3_read_pcm_frames_s16(static_cast<drmp3 *>(m_decoder), frameCount, output);
+                break;
+            case AudioFormat::Ogg:
+            {
+                int samples = static_cast<int>(frameCount * static_cast<size_t>(m_channels));
+                int frames = stb_vorbis_get_samples_short_interleaved(static_cast<stb_vorbis *>(m_decoder), m_channels,
+                                                                      output, samples);
+                framesRead = frames > 0 ? static_cast<uint64_t>(frames) : 0;
+                break;
+            }
+            default:
+                break;
+            }
+
+            m_framePosition += framesRead;
+            return static_cast<size_t>(framesRead);
+        }
+
+        bool AudioStream::rewind()
+        {
+            if (!m_decoder)
+                return false;
+
+            bool succeed = false;
+            switch (m_sourceFormat)
+            {
+            case AudioFormat::Wav:
+                succeed = drwav_seek_to_pcm_frame(static_cast<drwav *>(m_decoder), 0);
+                break;
+            case AudioFormat::Mp3:
+                succeed = drmp3_seek_to_pcm_frame(static_cast<drmp3 *>(m_decoder), 0);
+                break;
+            case AudioFormat::Ogg:
+                succeed = stb_vorbis_seek_start(static_cast<stb_vorbis *>(m_decoder)) != 0;
+                break;
+            default:
+                break;
+            }
+
+            if (succeed)
+                m_framePosition = 0;
+            else
+                logcoe::warning("AudioStream::rewind: Failed to rewind \"" + m_filename + "\"");
+            return succeed;
+        }
+
+        bool AudioStream::isOpen() const { return m_decoder != nullptr; }
+
+        bool AudioStream::isAtEnd() const { return !m_decoder || m_framePosition >= m_totalFrames; }
+
+        ALsizei AudioStream::getChannels() const { return m_channels; }
+
+        ALsizei AudioStream::getSampleRate() const { return m_sampleRate; }
+
+        ALenum AudioStream::getOpenALFormat() const { return m_openALFormat; }
+
+        ALsizei AudioStream::getFrameSize() const { return m_channels * static_cast<ALsizei>(sizeof(int16_t)); }
+
+        uint64_t AudioStream::getTotalFrames() const { return m_totalFrames; }
+
+        uint64_t AudioStream::getFramePosition() const { return m_framePosition; }
+
+        ALfloat AudioStream::getDuration() const
+        {
+            if (m_sampleRate <= 0)
+                return 0.0f;
+            return static_cast<ALfloat>(m_totalFrames) / static_cast<ALfloat>(m_sampleRate);
+        }
+
+        AudioFormat AudioStream::getSourceFormat() const { return m_sourceFormat; }
+
+        const std::string &AudioStream::getFileName() const { return m_filename; }
+    } // namespace detail
+} // namespace soundcoe
\ No newline at end of file
@@ -1,8 +1,14 @@
 #include <soundcoe/resources/resource_manager.hpp>
 #include <soundcoe/core/audio_context.hpp>
 #include <soundcoe/core/error_handler.hpp>
+#include <soundcoe/resources/audio_stream.hpp>
+#include <soundcoe/utils/adpcm.hpp>
+#include <soundcoe/utils/mapped_file.hpp>
+#include <AL/alext.h>
 #include <logcoe.hpp>
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 
 namespace soundcoe
 {
@@ -30,6 +36,7 @@ namespace soundcoe
             }
 
             m_audioContext.initialize();
+            m_decodeOptions.floatOutput = m_audioContext.isFloat32Supported();
 
             m_audioRootDirectory = std::filesystem::absolute(audioRootDirectory).lexically_normal();
             m_maxSources = maxSources;
@@ -44,6 +51,7 @@ namespace soundcoe
                 logcoe::error("ResourceManager::initialize: Failed to create Source Pool: " + std::string(e.what()));
                 m_sourcePool.clear();
                 m_freeSourceIndices.clear();
+                m_sourceSlots.clear();
                 throw;
             }
 
@@ -58,15 +66,28 @@ namespace soundcoe
             if (!m_initialized)
                 return;
 
+            cancelAsyncLoads();
+            m_decodePool.stop();
+
             m_sourcePool.clear();
             m_bufferCache.clear();
+            m_lruLists = {};
+            m_compressedLruLists = {};
             m_loadedDirectories.clear();
+            m_loadedBanks.clear();
+            m_fileIndex.clear();
+            m_registeredSounds.clear();
             m_freeSourceIndices.clear();
+            m_sourceSlots.clear();
+            m_bufferSources.clear();
+            m_voiceHeap.clear();
 
             try { m_audioContext.shutdown(); }
             catch(const std::runtime_error &) { logcoe::warning("ResourceManager::shutdown: Failed to shutdown the AudioContext"); }
 
             m_currentCacheSize = 0;
+            m_currentCompressedCacheSize = 0;
+            m_currentDecodedCacheSize = 0;
             m_initialized = false;
         }
 
@@ -92,8 +113,10 @@ namespace soundcoe
                 return false;
             }
 
+            // A packed bank next to the directory takes precedence over the loose files
+            std::filesystem::path bankFile = findBankFile(subdirectory);
             std::filesystem::path fullPath = m_audioRootDirectory / normalizePath(subdirectory);
-            if (!std::filesystem::exists(fullPath) || !std::filesystem::is_directory(fullPath))
+            if (bankFile.empty() && (!std::filesystem::exists(fullPath) || !std::filesystem::is_directory(fullPath)))
             {
                 logcoe::warning("ResourceManager::preloadDirectory: Not a directory: \"" + subdirectory + "\"");
                 return false;
@@ -105,18 +128,43 @@ namespace soundcoe
                 return true;
             }
 
-            std::vector<std::filesystem::path> audioFiles;
-            if (scanDirectoryForFiles(subdirectory, audioFiles))
+            if (!bankFile.empty())
+            {
+                if (!preloadBankImpl(subdirectory, bankFile))
+                    return false;
+            }
+            else
             {
-                for (const auto &file : audioFiles)
-                    preloadFileImpl(file);
+                std::vector<std::filesystem::path> audioFiles;
+                if (!scanDirectoryForFiles(subdirectory, audioFiles))
+                {
+                    logcoe::warning("ResourceManager::preloadDirectory: No audio files found in directory: " + subdirectory);
+                    return false;
+                }
 
-                m_loadedDirectories.push_back(subdirectory);
-                return true;
+                indexDirectoryFiles(subdirectory, audioFiles);
+
+                // Files already in the cache (shared with another directory) are not decoded again
+                audioFiles.erase(std::remove_if(audioFiles.begin(), audioFiles.end(), [this](const std::filesystem::path &file)
+                                                { return m_bufferCache.find(file.string()) != m_bufferCache.end(); }),
+                                 audioFiles.end());
+
+                // Decode in parallel, then upload one by one since OpenAL calls stay on this thread
+                std::vector<DecodedFile> decodedFiles = decodeFiles(audioFiles);
+                for (auto &decoded : decodedFiles)
+                    insertDecodedFile(decoded);
             }
 
-            logcoe::warning("ResourceManager::preloadDirectory: No audio files found in directory: " + subdirectory);
-            return false;
+            m_loadedDirectories.push_back(subdirectory);
+
+            // A pending asynchronous preload of the same directory has nothing left to do
+            auto asyncLoad = findAsyncLoad(subdirectory);
+            if (asyncLoad != m_asyncLoads.end())
+            {
+                finishAsyncLoad(**asyncLoad, true);
+                m_asyncLoads.erase(asyncLoad);
+            }
+            return true;
         }
 
         bool ResourceManager::unloadDirectory(const std::string &subdirectory)
@@ -134,25 +182,225 @@ namespace soundcoe
                 return true;
             }
 
+            auto asyncLoad = findAsyncLoad(subdirectory);
+            if (asyncLoad != m_asyncLoads.end())
+            {
+                logcoe::info("ResourceManager::unloadDirectory: Cancelling asynchronous preload of \"" + subdirectory + "\"");
+                (*asyncLoad)->m_state->m_cancelled = true;
+                for (const auto &file : (*asyncLoad)->m_insertedFiles)
+                    unloadFileImpl(file);
+                finishAsyncLoad(**asyncLoad, false);
+                m_asyncLoads.erase(asyncLoad);
+                return true;
+            }
+
             if (!isDirectoryLoadedImpl(subdirectory))
             {
                 logcoe::warning("ResourceManager::unloadDirectory: Directory is not loaded: \"" + subdirectory + "\"");
                 return true;
             }
 
-            std::vector<std::filesystem::path> audioFiles;
-            if (scanDirectoryForFiles(subdirectory, audioFiles))
-                for (const auto &file : audioFiles)
-                    unloadFileImpl(file);
+            auto bank = m_loadedBanks.find(subdirectory);
+            if (bank != m_loadedBanks.end())
+            {
+                std::filesystem::path directory = m_audioRootDirectory / normalizePath(subdirectory);
+                for (size_t i = 0; i < bank->second.getEntryCount(); ++i)
+                    unloadFileImpl((directory / bank->second.getName(i)).lexically_normal());
+                m_loadedBanks.erase(bank);
+            }
             else
-                logcoe::warning("ResourceManager::unloadDirectory: No audio files found in directory: " + subdirectory);
+            {
+                std::vector<std::filesystem::path> audioFiles;
+                if (scanDirectoryForFiles(subdirectory, audioFiles))
+                    for (const auto &file : audioFiles)
+                        unloadFileImpl(file);
+                else
+                    logcoe::warning("ResourceManager::unloadDirectory: No audio files found in directory: " + subdirectory);
+            }
 
+            unindexDirectoryFiles(subdirectory);
             m_loadedDirectories.erase(std::remove(m_loadedDirectories.begin(), m_loadedDirectories.end(), subdirectory),
                                     m_loadedDirectories.end());
             return true;
         }
 
-        std::optional<std::reference_wrapper<SoundSource>> ResourceManager::acquireSource(size_t &poolIndex, SoundPriority priority)
+        PreloadTicket ResourceManager::preloadDirectoryAsync(const std::string &subdirectory)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto state = std::make_shared<PreloadState>();
+            PreloadTicket ticket(state);
+            state->m_done = true;
+
+            if (!m_initialized)
+            {
+                logcoe::error("ResourceManager::preloadDirectoryAsync: ResourceManager is not initialized");
+                return ticket;
+            }
+
+            if (subdirectory.empty())
+            {
+                logcoe::warning("ResourceManager::preloadDirectoryAsync: Cannot preload empty subdirectory - this would load the entire audio root directory");
+                return ticket;
+            }
+
+            std::filesystem::path bankFile = findBankFile(subdirectory);
+            std::filesystem::path fullPath = m_audioRootDirectory / normalizePath(subdirectory);
+            if (bankFile.empty() && (!std::filesystem::exists(fullPath) || !std::filesystem::is_directory(fullPath)))
+            {
+                logcoe::warning("ResourceManager::preloadDirectoryAsync: Not a directory: \"" + subdirectory + "\"");
+                return ticket;
+            }
+
+            if (isDirectoryLoadedImpl(subdirectory))
+            {
+                logcoe::warning("ResourceManager::preloadDirectoryAsync: Directory is already loaded: \"" + subdirectory + "\"");
+                state->m_succeeded = true;
+                return ticket;
+            }
+
+            auto pending = findAsyncLoad(subdirectory);
+            if (pending != m_asyncLoads.end())
+                return PreloadTicket((*pending)->m_state);
+
+            // Banks hold decoded samples, there is nothing to hand to the decode pool
+            if (!bankFile.empty())
+            {
+                if (preloadBankImpl(subdirectory, bankFile))
+                {
+                    const SoundBank &bank = m_loadedBanks.at(subdirectory);
+                    state->m_filesTotal = bank.getEntryCount();
+                    state->m_filesDone = bank.getEntryCount();
+                    state->m_succeeded = true;
+                    m_loadedDirectories.push_back(subdirectory);
+                }
+                return ticket;
+            }
+
+            std::vector<std::filesystem::path> audioFiles;
+            if (!scanDirectoryForFiles(subdirectory, audioFiles))
+            {
+                logcoe::warning("ResourceManager::preloadDirectoryAsync: No audio files found in directory: " + subdirectory);
+                return ticket;
+            }
+
+            if (!m_decodePool.isRunning())
+                m_decodePool.start(getDecodeThreadCount());
+
+            auto load = std::make_shared<AsyncLoad>();
+            load->m_subdirectory = subdirectory;
+            load->m_state = state;
+            state->m_done = false;
+            state->m_filesTotal = audioFiles.size();
+            load->m_files = audioFiles;
+
+            size_t bytesTotal = 0;
+            for (const auto &file : audioFiles)
+            {
+                std::error_code ec;
+                auto fileSize = std::filesystem::file_size(file, ec);
+                if (!ec)
+                    bytesTotal += static_cast<size_t>(fileSize);
+            }
+            state->m_bytesTotal = bytesTotal;
+
+            // Decoding happens on the pool, the OpenAL upload waits for processAsyncLoads() on the owning thread
+            for (const auto &file : audioFiles)
+            {
+                StreamingPolicy policy = getStreamingPolicyForFile(file);
+                DecodeOptions options = getDecodeOptionsForFile(file);
+                bool keepCompressed = shouldKeepCompressed(file);
+                m_decodePool.submit([load, file, policy, options, keepCompressed]()
+                                    { decodeFile(load, file, policy, options, keepCompressed); });
+            }
+
+            m_asyncLoads.push_back(load);
+            logcoe::info("ResourceManager::preloadDirectoryAsync: Decoding " + std::to_string(audioFiles.size()) +
+                         " files from \"" + subdirectory + "\"");
+            return ticket;
+        }
+
+        size_t ResourceManager::processAsyncLoads()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_initialized || m_asyncLoads.empty())
+                return 0;
+
+            size_t uploaded = 0;
+            for (auto it = m_asyncLoads.begin(); it != m_asyncLoads.end();)
+            {
+                AsyncLoad &load = **it;
+                std::vector<DecodedFile> decodedFiles;
+                {
+                    std::lock_guard<std::mutex> loadLock(load.m_mutex);
+                    decodedFiles.swap(load.m_decodedFiles);
+                }
+
+                PreloadState &state = *load.m_state;
+                for (auto &decoded : decodedFiles)
+                {
+                    bool cached = m_bufferCache.find(decoded.m_filePath.string()) != m_bufferCache.end();
+                    bool succeeded = cached ? !decoded.m_failed : insertDecodedFile(decoded);
+                    if (succeeded && !cached)
+                    {
+                        load.m_insertedFiles.push_back(decoded.m_filePath);
+                        ++uploaded;
+                    }
+
+                    if (succeeded)
+                        ++state.m_filesDone;
+                    else
+                        ++state.m_filesFailed;
+                    state.m_bytesDone += decoded.m_fileSize;
+                }
+
+                if (state.m_filesDone + state.m_filesFailed < state.m_filesTotal)
+                {
+                    ++it;
+                    continue;
+                }
+
+                if (!isDirectoryLoadedImpl(load.m_subdirectory))
+                {
+                    indexDirectoryFiles(load.m_subdirectory, load.m_files);
+                    m_loadedDirectories.push_back(load.m_subdirectory);
+                }
+                logcoe::info("ResourceManager::processAsyncLoads: Finished preloading \"" + load.m_subdirectory + "\"");
+                finishAsyncLoad(load, true);
+                it = m_asyncLoads.erase(it);
+            }
+
+            return uploaded;
+        }
+
+        bool ResourceManager::isDirectoryLoading(const std::string &subdirectory) const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return std::any_of(m_asyncLoads.begin(), m_asyncLoads.end(), [&subdirectory](const std::shared_ptr<AsyncLoad> &load)
+                               { return load->m_subdirectory == subdirectory; });
+        }
+
+        bool ResourceManager::setDecodeThreadCount(size_t threadCount)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_asyncLoads.empty())
+            {
+                logcoe::warning("ResourceManager::setDecodeThreadCount: Cannot resize the decode pool while scenes are loading");
+                return false;
+            }
+
+            m_decodeThreadCount = threadCount;
+            // Restarted with the new size by the next preload
+            m_decodePool.stop();
+            return true;
+        }
+
+        size_t ResourceManager::getDecodeThreadCount() const
+        {
+            return m_decodeThreadCount > 0 ? m_decodeThreadCount : TaskPool::defaultThreadCount();
+        }
+
+        std::optional<std::reference_wrapper<SoundSource>> ResourceManager::acquireSource(size_t &poolIndex, SoundPriority priority,
+                                                                                          bool stealEqualPriority)
         {
             std::lock_guard<std::mutex> lock(m_mutex);
             if (!m_initialized)
@@ -164,9 +412,9 @@ namespace soundcoe
             size_t index;
             if (m_freeSourceIndices.empty())
             {
-                if (!findSourceToReplace(priority, index))
+                if (!findSourceToReplace(priority, stealEqualPriority, index))
                 {
-                    logcoe::error("ResourceManager::acquireSource: Could not find a Source to replace");
+                    logcoe::debug("ResourceManager::acquireSource: Could not find a Source to replace");
                     return std::nullopt;
                 }
             }
@@ -180,6 +428,7 @@ namespace soundcoe
             entry.m_priority = priority;
             entry.m_allocatedTime = std::chrono::steady_clock::now();
             entry.m_active = true;
+            pushVoice(index);
 
             if (entry.m_source.get() == nullptr)
                 return std::nullopt;
@@ -188,7 +437,8 @@ namespace soundcoe
             return std::ref(*(entry.m_source));
         }
 
-        std::optional<std::reference_wrapper<SoundBuffer>> ResourceManager::getBuffer(const std::string &filename)
+        std::optional<std::reference_wrapper<SoundBuffer>> ResourceManager::getBuffer(const std::string &filename,
+                                                                                      SoundPriority priority)
         {
             std::lock_guard<std::mutex> lock(m_mutex);
             if (!m_initialized)
@@ -209,60 +459,185 @@ namespace soundcoe
                 return std::nullopt;
             }
 
-            std::string cacheKey = foundPath.lexically_normal().string();
+            std::string cacheKey = foundPath.string();
             if ((m_bufferCache.find(cacheKey) == m_bufferCache.end()) && !preloadFileImpl(foundPath))
                 return std::nullopt;
 
-            auto &entry = m_bufferCache[cacheKey];
+            // A file larger than the whole cache is evicted as soon as it is inserted
+            auto it = m_bufferCache.find(cacheKey);
+            if (it == m_bufferCache.end())
+            {
+                logcoe::error("ResourceManager::getBuffer: \"" + cacheKey + "\" does not fit in the buffer cache");
+                return std::nullopt;
+            }
+            return referenceBuffer(cacheKey, it->second, priority);
+        }
+
+        std::optional<std::reference_wrapper<SoundBuffer>> ResourceManager::getBuffer(SoundId id, SoundPriority priority)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_initialized)
+            {
+                logcoe::error("ResourceManager::getBuffer: ResourceManager is not initialized");
+                return std::nullopt;
+            }
+
+            auto it = m_registeredSounds.find(id.value);
+            if (it == m_registeredSounds.end())
+            {
+                logcoe::error("ResourceManager::getBuffer: SoundId " + std::to_string(id.value) + " is not registered");
+                return std::nullopt;
+            }
+
+            RegisteredSound &sound = it->second;
+            if (sound.m_entry)
+                return referenceBuffer(sound.m_cacheKey, *(sound.m_entry), priority);
+
+            std::filesystem::path foundPath = findFileInLoadedDirectories(sound.m_filename);
+            if (foundPath.empty())
+            {
+                logcoe::error("ResourceManager::getBuffer: No such file in the loaded directories: " + sound.m_filename);
+                return std::nullopt;
+            }
+
+            std::string cacheKey = foundPath.string();
+            if ((m_bufferCache.find(cacheKey) == m_bufferCache.end()) && !preloadFileImpl(foundPath))
+                return std::nullopt;
+
+            auto entry = m_bufferCache.find(cacheKey);
+            if (entry == m_bufferCache.end())
+            {
+                logcoe::error("ResourceManager::getBuffer: \"" + cacheKey + "\" does not fit in the buffer cache");
+                return std::nullopt;
+            }
+
+            // Entries are nodes of the cache map, the pointer survives rehashing until the entry is erased
+            sound.m_entry = &(entry->second);
+            sound.m_cacheKey = std::move(cacheKey);
+            return referenceBuffer(sound.m_cacheKey, *(sound.m_entry), priority);
+        }
+
+        std::optional<std::reference_wrapper<SoundBuffer>> ResourceManager::referenceBuffer(const std::string &cacheKey,
+                                                                                             BufferCacheEntry &entry,
+                                                                                             SoundPriority priority)
+        {
+            bool compressed = !entry.m_compressedData.empty();
+            if (compressed && !entry.m_buffer->isLoaded() && !decodeCompressedEntry(cacheKey, entry))
+                return std::nullopt;
+
             ++entry.m_referenceCount;
-            entry.m_lastAccessed = std::chrono::steady_clock::now();
+            ++entry.m_priorityReferences[static_cast<size_t>(priority)];
+            unlinkLruEntry(entry);
+            linkLruEntry(entry);
+            // Referenced now, so only other sounds' PCM can make room
+            if (compressed)
+                freeDecodedBuffers();
             return std::ref(*(entry.m_buffer));
         }
 
-        bool ResourceManager::releaseSource(std::reference_wrapper<SoundSource> source)
+        bool ResourceManager::registerSound(SoundId id, const std::string &filename)
         {
             std::lock_guard<std::mutex> lock(m_mutex);
-            if (!m_initialized)
+            if (!id.isValid() || filename.empty())
             {
-                logcoe::error("ResourceManager::releaseSource: ResourceManager is not initialized");
+                logcoe::error("ResourceManager::registerSound: Invalid SoundId or empty filename");
                 return false;
             }
 
-            for (size_t i = 0; i < m_sourcePool.size(); ++i)
+            auto it = m_registeredSounds.find(id.value);
+            if (it != m_registeredSounds.end())
             {
-                auto &allocation = m_sourcePool[i];
-                if (!allocation.m_active || allocation.m_source->getSourceId() != source.get().getSourceId())
-                    continue;
+                if (it->second.m_filename == filename)
+                    return true;
+                logcoe::error("ResourceManager::registerSound: \"" + filename + "\" collides with \"" +
+                              it->second.m_filename + "\"");
+                return false;
+            }
 
-                try
-                {
-                    allocation.m_source->detachBuffer();
-                }
-                catch (const std::exception &e)
-                {
-                    logcoe::warning("ResourceManager::releaseSource: Failed to detach Buffer: " + std::string(e.what()));
-                }
+            m_registeredSounds[id.value].m_filename = filename;
+            return true;
+        }
 
-                allocation.m_active = false;
-                m_freeSourceIndices.push_back(i);
+        void ResourceManager::resetRegisteredSounds(const BufferCacheEntry *entry)
+        {
+            for (auto &[id, sound] : m_registeredSounds)
+                if (!entry || sound.m_entry == entry)
+                    sound.m_entry = nullptr;
+        }
+
+        bool ResourceManager::releaseSource(std::reference_wrapper<SoundSource> source)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_initialized)
+            {
+                logcoe::error("ResourceManager::releaseSource: ResourceManager is not initialized");
+                return false;
+            }
 
+            auto slot = m_sourceSlots.find(&(source.get()));
+            if (slot == m_sourceSlots.end() || !m_sourcePool[slot->second].m_active)
+            {
+                logcoe::warning("ResourceManager::releaseSource: This SoundSource is not acquired");
                 return true;
             }
 
-            logcoe::warning("ResourceManager::releaseSource: This SoundSource is not acquired");
+            detachSource(slot->second, "releaseSource");
+            removeVoice(slot->second);
+            m_sourcePool[slot->second].m_active = false;
+            m_freeSourceIndices.push_back(slot->second);
             return true;
         }
 
-        bool ResourceManager::releaseBuffer(std::reference_wrapper<SoundBuffer> buffer)
+        void ResourceManager::attachBuffer(size_t poolIndex, std::reference_wrapper<SoundBuffer> buffer)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_initialized || poolIndex >= m_sourcePool.size() || !m_sourcePool[poolIndex].m_active)
+                throw std::runtime_error("ResourceManager::attachBuffer: Source " + std::to_string(poolIndex) + " is not acquired");
+
+            auto &allocation = m_sourcePool[poolIndex];
+            if (allocation.m_attachedBuffer != 0)
+                detachSource(poolIndex, "attachBuffer");
+
+            allocation.m_source->attachBuffer(buffer.get());
+            allocation.m_attachedBuffer = buffer.get().getBufferId();
+            if (allocation.m_attachedBuffer != 0)
+                m_bufferSources[allocation.m_attachedBuffer].push_back(poolIndex);
+        }
+
+        bool ResourceManager::releaseBuffer(std::reference_wrapper<SoundBuffer> buffer, SoundPriority priority)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return releaseBufferImpl(buffer.get().getFileName(), priority);
+        }
+
+        bool ResourceManager::releaseBuffer(const std::string &filename, SoundPriority priority)
         {
             std::lock_guard<std::mutex> lock(m_mutex);
-            return releaseBufferImpl(buffer.get().getFileName());
+            return releaseBufferImpl(filename, priority);
         }
 
-        bool ResourceManager::releaseBuffer(const std::string &filename)
+        bool ResourceManager::releaseBuffer(SoundId id, SoundPriority priority)
         {
             std::lock_guard<std::mutex> lock(m_mutex);
-            return releaseBufferImpl(filename);
+            auto it = m_registeredSounds.find(id.value);
+            if (it == m_registeredSounds.end())
+            {
+                logcoe::warning("ResourceManager::releaseBuffer: SoundId " + std::to_string(id.value) + " is not registered");
+                return true;
+            }
+
+            BufferCacheEntry *entry = it->second.m_entry;
+            if (!entry)
+                return releaseBufferImpl(it->second.m_filename, priority);
+
+            if (entry->m_referenceCount == 0)
+            {
+                logcoe::warning("ResourceManager::releaseBuffer: Not a single Source is using this Buffer at the moment");
+                return true;
+            }
+
+            dereferenceEntry(*entry, priority);
+            return true;
         }
 
         size_t ResourceManager::getActiveSourceCount() const
@@ -357,8 +732,7 @@ namespace soundcoe
             {
                 if (it->second.m_referenceCount == 0)
                 {
-                    m_currentCacheSize -= it->second.m_buffer->getSize();
-                    it = m_bufferCache.erase(it);
+                    eraseCacheEntry(it++);
                     ++removed;
                 }
                 else
@@ -368,111 +742,539 @@ namespace soundcoe
             return removed;
         }
 
-        void ResourceManager::createSourcePool()
+        void ResourceManager::setStreamingPolicy(const StreamingPolicy &policy)
         {
-            m_sourcePool.resize(m_maxSources);
-            m_freeSourceIndices.clear();
-            auto time = std::chrono::steady_clock::now();
-
-            for (size_t index = 0; index < m_maxSources; ++index)
-            {
-                m_sourcePool[index].m_source = std::make_unique<SoundSource>();
-                m_sourcePool[index].m_priority = SoundPriority::Medium;
-                m_sourcePool[index].m_allocatedTime = time;
-                m_sourcePool[index].m_active = false;
-                m_freeSourceIndices.push_back(index);
-            }
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_streamingPolicy = policy;
         }
 
-        bool ResourceManager::findSourceToReplace(SoundPriority newPriority, size_t &replaceIndex)
+        bool ResourceManager::setStreamingPolicy(const std::string &subdirectory, const StreamingPolicy &policy)
         {
-            if (m_sourcePool.empty())
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::string key = normalizeSubdirectory(subdirectory);
+            if (key.empty())
             {
-                logcoe::warning("ResourceManager::findSourceToReplace: Source Pool is empty");
+                logcoe::warning("ResourceManager::setStreamingPolicy: Subdirectory cannot be empty - use the global policy instead");
                 return false;
             }
 
-            if (!m_freeSourceIndices.empty())
+            m_subdirStreamingPolicies[key] = policy;
+            return true;
+        }
+
+        bool ResourceManager::clearStreamingPolicy(const std::string &subdirectory)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_subdirStreamingPolicies.erase(normalizeSubdirectory(subdirectory)) > 0;
+        }
+
+        StreamingPolicy ResourceManager::getStreamingPolicy(const std::string &subdirectory) const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_subdirStreamingPolicies.find(normalizeSubdirectory(subdirectory));
+            if (it != m_subdirStreamingPolicies.end())
+                return it->second;
+            return m_streamingPolicy;
+        }
+
+        void ResourceManager::setMonoDownmix(bool enabled)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_monoDownmix = enabled;
+        }
+
+        bool ResourceManager::setMonoDownmix(const std::string &subdirectory, bool enabled)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::string key = normalizeSubdirectory(subdirectory);
+            if (key.empty())
             {
-                logcoe::warning("ResourceManager::findSourceToReplace: There are free sources available");
+                logcoe::warning("ResourceManager::setMonoDownmix: Subdirectory cannot be empty - use the global setting instead");
                 return false;
             }
 
-            auto sourceToReplace = std::find_if(m_sourcePool.begin(), m_sourcePool.end(),
-                                                [](const auto &it)
-                                                {
-                                                    return it.m_active && it.m_source->isStopped();
-                                                });
-            if (sourceToReplace == m_sourcePool.end())
-            {
-                sourceToReplace = std::min_element(m_sourcePool.begin(), m_sourcePool.end(),
-                                                [](const auto &a, const auto &b)
-                                                {
-                                                    if (a.m_priority != b.m_priority)
-                                                        return a.m_priority < b.m_priority;
-                                                    return a.m_allocatedTime < b.m_allocatedTime;
-                                                });
+            m_subdirMonoDownmix[key] = enabled;
+            return true;
+        }
 
-                if (sourceToReplace->m_priority > newPriority)
-                {
-                    logcoe::debug("ResourceManager::findSourceToReplace: There is no lower priority source to replace with");
-                    return false;
-                }
+        bool ResourceManager::clearMonoDownmix(const std::string &subdirectory)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_subdirMonoDownmix.erase(normalizeSubdirectory(subdirectory)) > 0;
+        }
 
-                if (sourceToReplace->m_active)
-                {
-                    sourceToReplace->m_source->stop();
-                    sourceToReplace->m_active = false;
-                }
-            }
+        bool ResourceManager::isMonoDownmixEnabled(const std::string &subdirectory) const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_subdirMonoDownmix.find(normalizeSubdirectory(subdirectory));
+            if (it != m_subdirMonoDownmix.end())
+                return it->second;
+            return m_monoDownmix;
+        }
 
-            replaceIndex = std::distance(m_sourcePool.begin(), sourceToReplace);
-            logcoe::info("ResourceManager::findSourceToReplace: Finished successfully");
-            return true;
+        void ResourceManager::setBufferCompression(BufferCompression compression)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_bufferCompression = compression;
         }
 
-        void ResourceManager::freeBuffers()
+        bool ResourceManager::setBufferCompression(const std::string &subdirectory, BufferCompression compression)
         {
-            while (m_currentCacheSize > m_maxCacheSize && !m_bufferCache.empty())
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::string key = normalizeSubdirectory(subdirectory);
+            if (key.empty())
             {
-                auto toFree = std::min_element(m_bufferCache.begin(), m_bufferCache.end(),
-                                            [this](const auto &a, const auto &b)
-                                            {
-                                                if (a.second.m_referenceCount == 0 && b.second.m_referenceCount > 0)
-                                                    return true;
-                                                if (a.second.m_referenceCount > 0 && b.second.m_referenceCount == 0)
-                                                    return false;
+                logcoe::warning("ResourceManager::setBufferCompression: Subdirectory cannot be empty - use the global setting instead");
+                return false;
+            }
 
-                                                auto aPriority = getHighestPriorityForBuffer(a.second.m_buffer->getBufferId());
-                                                auto bPriority = getHighestPriorityForBuffer(b.second.m_buffer->getBufferId());
-                                                if (aPriority != bPriority)
-                                                    return aPriority < bPriority;
+            m_subdirBufferCompression[key] = compression;
+            return true;
+        }
 
-                                                return a.second.m_lastAccessed < b.second.m_lastAccessed;
-                                            });
+        bool ResourceManager::clearBufferCompression(const std::string &subdirectory)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_subdirBufferCompression.erase(normalizeSubdirectory(subdirectory)) > 0;
+        }
 
-                auto oldestBufferId = toFree->second.m_buffer->getBufferId();
-                for (size_t i = 0; i < m_sourcePool.size(); ++i)
-                {
-                    auto &allocation = m_sourcePool[i];
-                    if (!allocation.m_active || allocation.m_source->getBufferId() != oldestBufferId)
-                        continue;
+        BufferCompression ResourceManager::getBufferCompression(const std::string &subdirectory) const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_subdirBufferCompression.find(normalizeSubdirectory(subdirectory));
+            if (it != m_subdirBufferCompression.end())
+                return it->second;
+            return m_bufferCompression;
+        }
 
-                    try
+        void ResourceManager::setCompressedCaching(bool enabled)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_compressedCaching = enabled;
+        }
+
+        bool ResourceManager::setCompressedCaching(const std::string &subdirectory, bool enabled)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::string key = normalizeSubdirectory(subdirectory);
+            if (key.empty())
+            {
+                logcoe::warning("ResourceManager::setCompressedCaching: Subdirectory cannot be empty - use the global setting instead");
+                return false;
+            }
+
+            m_subdirCompressedCaching[key] = enabled;
+            return true;
+        }
+
+        bool ResourceManager::clearCompressedCaching(const std::string &subdirectory)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_subdirCompressedCaching.erase(normalizeSubdirectory(subdirectory)) > 0;
+        }
+
+        bool ResourceManager::isCompressedCachingEnabled(const std::string &subdirectory) const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_subdirCompressedCaching.find(normalizeSubdirectory(subdirectory));
+            if (it != m_subdirCompressedCaching.end())
+                return it->second;
+            return m_compressedCaching;
+        }
+
+        void ResourceManager::setCompressedCacheLimits(size_t compressedMB, size_t decodedMB)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_maxCompressedCacheSize = compressedMB * 1024 * 1024;
+            m_maxDecodedCacheSize = decodedMB * 1024 * 1024;
+
+            // Shrinking drops what no sound is using right away
+            reserveCompressedCache(0);
+            freeDecodedBuffers();
+        }
+
+        size_t ResourceManager::getCompressedCacheSizeBytes() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_currentCompressedCacheSize;
+        }
+
+        size_t ResourceManager::getDecodedCacheSizeBytes() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_currentDecodedCacheSize;
+        }
+
+        void ResourceManager::setResampleOnLoad(bool enabled)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_resampleOnLoad = enabled;
+        }
+
+        bool ResourceManager::isResampleOnLoadEnabled() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_resampleOnLoad;
+        }
+
+        ALCint ResourceManager::getDeviceFrequency() const
+        {
+            return m_audioContext.getDeviceFrequency();
+        }
+
+        void ResourceManager::suspendUpdates()
+        {
+            m_audioContext.suspendUpdates();
+        }
+
+        void ResourceManager::processUpdates()
+        {
+            m_audioContext.processUpdates();
+        }
+
+        bool ResourceManager::isUpdatesSuspended() const
+        {
+            return m_audioContext.isUpdatesSuspended();
+        }
+
+        void ResourceManager::createSourcePool()
+        {
+            m_sourcePool.resize(m_maxSources);
+            m_freeSourceIndices.clear();
+            m_voiceHeap.clear();
+            m_voiceHeap.reserve(m_maxSources);
+            auto time = std::chrono::steady_clock::now();
+
+            for (size_t index = 0; index < m_maxSources; ++index)
+            {
+                m_sourcePool[index].m_source = std::make_unique<SoundSource>();
+                m_sourcePool[index].m_priority = SoundPriority::Medium;
+                m_sourcePool[index].m_allocatedTime = time;
+                m_sourcePool[index].m_active = false;
+                m_sourceSlots[m_sourcePool[index].m_source.get()] = index;
+                m_freeSourceIndices.push_back(index);
+            }
+        }
+
+        bool ResourceManager::findSourceToReplace(SoundPriority newPriority, bool stealEqualPriority, size_t &replaceIndex)
+        {
+            if (m_sourcePool.empty())
+            {
+                logcoe::warning("ResourceManager::findSourceToReplace: Source Pool is empty");
+                return false;
+            }
+
+            if (!m_freeSourceIndices.empty())
+            {
+                logcoe::warning("ResourceManager::findSourceToReplace: There are free sources available");
+                return false;
+            }
+
+            // Stopped voices are released by SoundManager::update, so every slot here is still in use
+            if (m_voiceHeap.empty())
+            {
+                logcoe::warning("ResourceManager::findSourceToReplace: No active source to replace");
+                return false;
+            }
+
+            size_t index = m_voiceHeap.front();
+            auto &sourceToReplace = m_sourcePool[index];
+            if (sourceToReplace.m_priority > newPriority || (!stealEqualPriority && sourceToReplace.m_priority == newPriority))
+            {
+                logcoe::debug("ResourceManager::findSourceToReplace: There is no lower priority source to replace with");
+                return false;
+            }
+
+            removeVoice(index);
+            sourceToReplace.m_source->stop();
+            sourceToReplace.m_active = false;
+
+            replaceIndex = index;
+            // The new owner must not be detached when the previous owner's buffer is freed
+            if (sourceToReplace.m_attachedBuffer != 0)
+                detachSource(replaceIndex, "findSourceToReplace");
+            logcoe::info("ResourceManager::findSourceToReplace: Finished successfully");
+            return true;
+        }
+
+        bool ResourceManager::stealsBefore(size_t a, size_t b) const
+        {
+            const auto &first = m_sourcePool[a];
+            const auto &second = m_sourcePool[b];
+            if (first.m_priority != second.m_priority)
+                return first.m_priority < second.m_priority;
+            return first.m_allocatedTime < second.m_allocatedTime;
+        }
+
+        void ResourceManager::siftVoice(size_t position)
+        {
+            auto place = [this](size_t heapPosition, size_t index)
+            {
+                m_voiceHeap[heapPosition] = index;
+                m_sourcePool[index].m_heapIndex = heapPosition;
+            };
+
+            size_t index = m_voiceHeap[position];
+            while (position > 0 && stealsBefore(index, m_voiceHeap[(position - 1) / 2]))
+            {
+                place(position, m_voiceHeap[(position - 1) / 2]);
+                position = (position - 1) / 2;
+            }
+
+            while (true)
+            {
+                size_t child = 2 * position + 1;
+                if (child >= m_voiceHeap.size())
+                    break;
+                if (child + 1 < m_voiceHeap.size() && stealsBefore(m_voiceHeap[child + 1], m_voiceHeap[child]))
+                    ++child;
+                if (!stealsBefore(m_voiceHeap[child], index))
+                    break;
+                place(position, m_voiceHeap[child]);
+                position = child;
+            }
+            place(position, index);
+        }
+
+        void ResourceManager::pushVoice(size_t index)
+        {
+            if (m_sourcePool[index].m_heapIndex != SIZE_MAX)
+                removeVoice(index);
+
+            m_voiceHeap.push_back(index);
+            siftVoice(m_voiceHeap.size() - 1);
+        }
+
+        void ResourceManager::removeVoice(size_t index)
+        {
+            size_t position = m_sourcePool[index].m_heapIndex;
+            if (position == SIZE_MAX)
+                return;
+
+            m_sourcePool[index].m_heapIndex = SIZE_MAX;
+            size_t last = m_voiceHeap.back();
+            m_voiceHeap.pop_back();
+            if (position < m_voiceHeap.size())
+            {
+                m_voiceHeap[position] = last;
+                siftVoice(position);
+            }
+        }
+
+        void ResourceManager::freeBuffers()
+        {
+            // Compressed tier entries live under their own budgets and lists
+            while (m_currentCacheSize > m_maxCacheSize)
+            {
+                BufferCacheEntry *toFree = nullptr;
+                for (const auto &list : m_lruLists)
+                {
+                    if (list.m_head)
                     {
-                        allocation.m_source->detachBuffer();
+                        toFree = list.m_head;
+                        break;
                     }
-                    catch (const std::exception &e)
+                }
+
+                if (!toFree)
+                    break;
+
+                detachBufferFromSources(toFree->m_buffer->getBufferId());
+                eraseCacheEntry(m_bufferCache.find(*(toFree->m_cacheKey)));
+            }
+        }
+
+        void ResourceManager::detachBufferFromSources(ALuint bufferId)
+        {
+            auto it = m_bufferSources.find(bufferId);
+            if (it == m_bufferSources.end())
+                return;
+
+            std::vector<size_t> sources = std::move(it->second);
+            m_bufferSources.erase(it);
+            for (size_t index : sources)
+            {
+                auto &allocation = m_sourcePool[index];
+                allocation.m_attachedBuffer = 0;
+                try
+                {
+                    allocation.m_source->detachBuffer();
+                }
+                catch (const std::exception &e)
+                {
+                    logcoe::warning("ResourceManager::detachBufferFromSources: Failed to detach Buffer: " + std::string(e.what()));
+                }
+
+                if (allocation.m_active)
+                {
+                    removeVoice(index);
+                    allocation.m_active = false;
+                    m_freeSourceIndices.push_back(index);
+                }
+            }
+        }
+
+        void ResourceManager::detachSource(size_t index, const std::string &method)
+        {
+            auto &allocation = m_sourcePool[index];
+            try
+            {
+                allocation.m_source->detachBuffer();
+            }
+            catch (const std::exception &e)
+            {
+                logcoe::warning("ResourceManager::" + method + ": Failed to detach Buffer: " + std::string(e.what()));
+            }
+
+            if (allocation.m_attachedBuffer == 0)
+                return;
+
+            auto it = m_bufferSources.find(allocation.m_attachedBuffer);
+            allocation.m_attachedBuffer = 0;
+            if (it == m_bufferSources.end())
+                return;
+
+            auto &sources = it->second;
+            auto slot = std::find(sources.begin(), sources.end(), index);
+            if (slot != sources.end())
+            {
+                *slot = sources.back();
+                sources.pop_back();
+            }
+            if (sources.empty())
+                m_bufferSources.erase(it);
+        }
+
+        void ResourceManager::eraseCacheEntry(std::unordered_map<std::string, BufferCacheEntry>::iterator it)
+        {
+            BufferCacheEntry &entry = it->second;
+            if (entry.m_compressedData.empty())
+                m_currentCacheSize -= entry.m_buffer->getSize();
+            else
+            {
+                m_currentCompressedCacheSize -= entry.m_compressedData.size();
+                if (entry.m_buffer->isLoaded())
+                    m_currentDecodedCacheSize -= entry.m_buffer->getSize();
+            }
+            if (!m_registeredSounds.empty())
+                resetRegisteredSounds(&entry);
+            unlinkLruEntry(entry);
+            m_bufferCache.erase(it);
+        }
+
+        BufferCacheEntry &ResourceManager::emplaceCacheEntry(const std::string &cacheKey, BufferCacheEntry &&entry)
+        {
+            auto existing = m_bufferCache.find(cacheKey);
+            if (existing != m_bufferCache.end())
+                eraseCacheEntry(existing);
+
+            auto it = m_bufferCache.emplace(cacheKey, std::move(entry)).first;
+            it->second.m_cacheKey = &(it->first);
+            linkLruEntry(it->second);
+            return it->second;
+        }
+
+        void ResourceManager::linkLruEntry(BufferCacheEntry &entry)
+        {
+            size_t bucket = 1;
+            if (entry.m_referenceCount > 0)
+            {
+                bucket = 2;
+                for (size_t priority = LRU_PRIORITY_COUNT; priority-- > 0;)
+                {
+                    if (entry.m_priorityReferences[priority] > 0)
                     {
-                        logcoe::warning("ResourceManager::freeBuffers: Failed to detach Buffer: " + std::string(e.what()));
+                        bucket = 2 + priority;
+                        break;
                     }
+                }
+            }
+            else if (!entry.m_buffer->isLoaded())
+                bucket = 0;
+
+            LruList &list = entry.m_compressedData.empty() ? m_lruLists[bucket] : m_compressedLruLists[bucket];
+            entry.m_lruList = &list;
+            entry.m_lruPrev = list.m_tail;
+            entry.m_lruNext = nullptr;
+            if (list.m_tail)
+                list.m_tail->m_lruNext = &entry;
+            else
+                list.m_head = &entry;
+            list.m_tail = &entry;
+        }
 
-                    allocation.m_active = false;
-                    m_freeSourceIndices.push_back(i);
+        void ResourceManager::unlinkLruEntry(BufferCacheEntry &entry)
+        {
+            if (!entry.m_lruList)
+                return;
+
+            if (entry.m_lruPrev)
+                entry.m_lruPrev->m_lruNext = entry.m_lruNext;
+            else
+                entry.m_lruList->m_head = entry.m_lruNext;
+            if (entry.m_lruNext)
+                entry.m_lruNext->m_lruPrev = entry.m_lruPrev;
+            else
+                entry.m_lruList->m_tail = entry.m_lruPrev;
+
+            entry.m_lruList = nullptr;
+            entry.m_lruPrev = nullptr;
+            entry.m_lruNext = nullptr;
+        }
+
+        void ResourceManager::dereferenceEntry(BufferCacheEntry &entry, SoundPriority priority)
+        {
+            --entry.m_referenceCount;
+            // A release at another priority than its acquire still leaves the counts summing to m_referenceCount
+            size_t index = static_cast<size_t>(priority);
+            for (size_t i = 0; i < LRU_PRIORITY_COUNT; ++i, index = (index + 1) % LRU_PRIORITY_COUNT)
+            {
+                if (entry.m_priorityReferences[index] > 0)
+                {
+                    --entry.m_priorityReferences[index];
+                    break;
                 }
+            }
 
-                m_currentCacheSize -= toFree->second.m_buffer->getSize();
-                m_bufferCache.erase(toFree);
+            // Stopped sounds count as recently used
+            unlinkLruEntry(entry);
+            linkLruEntry(entry);
+        }
+
+        bool ResourceManager::reserveCompressedCache(size_t size)
+        {
+            if (size > m_maxCompressedCacheSize)
+                return false;
+
+            while (m_currentCompressedCacheSize + size > m_maxCompressedCacheSize)
+            {
+                // Sounds whose PCM was already dropped go first, then the unreferenced decoded ones
+                BufferCacheEntry *toFree = m_compressedLruLists[0].m_head;
+                if (!toFree)
+                    toFree = m_compressedLruLists[1].m_head;
+                if (!toFree)
+                    return false;
+
+                detachBufferFromSources(toFree->m_buffer->getBufferId());
+                eraseCacheEntry(m_bufferCache.find(*(toFree->m_cacheKey)));
+            }
+            return true;
+        }
+
+        void ResourceManager::freeDecodedBuffers()
+        {
+            while (m_currentDecodedCacheSize > m_maxDecodedCacheSize)
+            {
+                BufferCacheEntry *toUnload = m_compressedLruLists[1].m_head;
+                if (!toUnload)
+                    return;
+
+                // Only the PCM goes, the compressed bytes decode it again on the next play
+                detachBufferFromSources(toUnload->m_buffer->getBufferId());
+                m_currentDecodedCacheSize -= toUnload->m_buffer->getSize();
+                toUnload->m_buffer->unload();
+                unlinkLruEntry(*toUnload);
+                linkLruEntry(*toUnload);
             }
         }
 
@@ -514,6 +1316,354 @@ namespace soundcoe
             return foundFile;
         }
 
+        std::string ResourceManager::normalizeSubdirectory(const std::string &subdirectory) const
+        {
+            std::string key = normalizePath(subdirectory).generic_string();
+            while (!key.empty() && key.back() == '/')
+                key.pop_back();
+            return key == "." ? "" : key;
+        }
+
+        template <typename T>
+        const T *ResourceManager::findSubdirectoryOverride(const std::unordered_map<std::string, T> &overrides,
+                                                           const std::filesystem::path &filePath) const
+        {
+            if (overrides.empty())
+                return nullptr;
+
+            std::vector<std::string> fileComponents;
+            for (const auto &component : filePath.lexically_relative(m_audioRootDirectory).parent_path())
+                fileComponents.push_back(component.string());
+
+            // An override matches wherever its components appear in the file's directory ("music" matches
+            // "general/music" and "scene1/music"), the most specific (longest) match wins
+            const T *result = nullptr;
+            size_t bestLength = 0;
+            for (const auto &[subdirectory, value] : overrides)
+            {
+                std::vector<std::string> components;
+                for (const auto &component : std::filesystem::path(subdirectory))
+                    components.push_back(component.string());
+
+                if (components.size() <= bestLength || components.size() > fileComponents.size())
+                    continue;
+
+                auto match = std::search(fileComponents.begin(), fileComponents.end(), components.begin(), components.end());
+                if (match != fileComponents.end())
+                {
+                    result = &value;
+                    bestLength = components.size();
+                }
+            }
+
+            return result;
+        }
+
+        const StreamingPolicy &ResourceManager::getStreamingPolicyForFile(const std::filesystem::path &filePath) const
+        {
+            const StreamingPolicy *policy = findSubdirectoryOverride(m_subdirStreamingPolicies, filePath);
+            return policy ? *policy : m_streamingPolicy;
+        }
+
+        DecodeOptions ResourceManager::getDecodeOptionsForFile(const std::filesystem::path &filePath) const
+        {
+            DecodeOptions options = m_decodeOptions;
+            const bool *downmix = findSubdirectoryOverride(m_subdirMonoDownmix, filePath);
+            options.downmixToMono = downmix ? *downmix : m_monoDownmix;
+            if (m_resampleOnLoad)
+                options.targetSampleRate = m_audioContext.getDeviceFrequency();
+
+            const BufferCompression *compression = findSubdirectoryOverride(m_subdirBufferCompression, filePath);
+            options.compression = compression ? *compression : m_bufferCompression;
+            if (!isCompressionSupported(options.compression))
+            {
+                logcoe::debug("ResourceManager::getDecodeOptionsForFile: The device cannot play the requested ADPCM format, keeping \"" +
+                              filePath.string() + "\" as PCM");
+                options.compression = BufferCompression::None;
+            }
+            // The ADPCM encoders take 16-bit input
+            if (options.compression != BufferCompression::None)
+                options.floatOutput = false;
+            return options;
+        }
+
+        bool ResourceManager::isCompressionSupported(BufferCompression compression) const
+        {
+            switch (compression)
+            {
+            case BufferCompression::Ima4:
+                return m_audioContext.isIma4Supported();
+            case BufferCompression::MsAdpcm:
+                return m_audioContext.isMsAdpcmSupported();
+            default:
+                return true;
+            }
+        }
+
+        bool ResourceManager::shouldStreamFile(const MappedFile &file, const StreamingPolicy &policy)
+        {
+            if (!policy.isEnabled())
+                return false;
+
+            if (policy.minFileSize > 0 && file.size() >= policy.minFileSize)
+                return true;
+
+            if (policy.minDuration > 0.0f)
+            {
+                try
+                {
+                    // Parses the headers in place, the file is not opened again
+                    AudioStream probe;
+                    probe.open(file.data(), file.size(), file.getFileName());
+                    return probe.getDuration() >= policy.minDuration;
+                }
+                catch (const std::exception &e)
+                {
+                    logcoe::debug("ResourceManager::shouldStreamFile: Could not probe duration of \"" + file.getFileName() +
+                                  "\": " + std::string(e.what()));
+                }
+            }
+
+            return false;
+        }
+
+        bool ResourceManager::shouldKeepCompressed(const std::filesystem::path &filePath) const
+        {
+            const bool *enabled = findSubdirectoryOverride(m_subdirCompressedCaching, filePath);
+            return enabled ? *enabled : m_compressedCaching;
+        }
+
+        DecodedFile ResourceManager::decodeFileImpl(const std::filesystem::path &filePath, const StreamingPolicy &policy,
+                                                    const DecodeOptions &options, bool keepCompressed)
+        {
+            DecodedFile decoded;
+            decoded.m_filePath = filePath;
+
+            // The format, the stream policy and the decoded audio all come from this one mapping
+            MappedFile file;
+            if (!file.open(filePath.string()))
+            {
+                logcoe::error("ResourceManager::decodeFileImpl: Failed to open \"" + filePath.string() + "\"");
+                decoded.m_failed = true;
+                return decoded;
+            }
+            decoded.m_fileSize = file.size();
+
+            // Only Ogg and MP3 are worth keeping compressed, WAV bytes are as large as their PCM
+            AudioFormat format = AudioData::detectFormat(file.data(), file.size());
+            if (keepCompressed && (format == AudioFormat::Ogg || format == AudioFormat::Mp3))
+            {
+                decoded.m_compressed = true;
+                decoded.m_compressedData.assign(file.data(), file.data() + file.size());
+                return decoded;
+            }
+
+            try
+            {
+                decoded.m_stream = shouldStreamFile(file, policy);
+                if (decoded.m_stream)
+                    decoded.m_audioStream.open(std::move(file));
+                else
+                    decoded.m_audioData = AudioData::loadFromFile(std::move(file), options);
+            }
+            catch (const std::exception &e)
+            {
+                logcoe::error("ResourceManager::decodeFileImpl: Failed to decode \"" + filePath.string() + "\": " + std::string(e.what()));
+                decoded.m_failed = true;
+            }
+
+            return decoded;
+        }
+
+        void ResourceManager::decodeFile(const std::shared_ptr<AsyncLoad> &load, const std::filesystem::path &filePath,
+                                         const StreamingPolicy &policy, const DecodeOptions &options, bool keepCompressed)
+        {
+            DecodedFile decoded;
+            if (!(load->m_state->m_cancelled))
+                decoded = decodeFileImpl(filePath, policy, options, keepCompressed);
+            else
+            {
+                decoded.m_filePath = filePath;
+                decoded.m_failed = true;
+            }
+
+            std::lock_guard<std::mutex> lock(load->m_mutex);
+            load->m_decodedFiles.push_back(std::move(decoded));
+        }
+
+        std::vector<DecodedFile> ResourceManager::decodeFiles(const std::vector<std::filesystem::path> &files)
+        {
+            std::vector<DecodedFile> decodedFiles(files.size());
+            std::vector<StreamingPolicy> policies;
+            std::vector<DecodeOptions> options;
+            std::vector<char> keepCompressed;
+            policies.reserve(files.size());
+            options.reserve(files.size());
+            keepCompressed.reserve(files.size());
+            for (const auto &file : files)
+            {
+                policies.push_back(getStreamingPolicyForFile(file));
+                options.push_back(getDecodeOptionsForFile(file));
+                keepCompressed.push_back(shouldKeepCompressed(file));
+            }
+
+            size_t threadCount = getDecodeThreadCount();
+            if (files.size() < 2 || threadCount < 2)
+            {
+                for (size_t i = 0; i < files.size(); ++i)
+                    decodedFiles[i] = decodeFileImpl(files[i], policies[i], options[i], keepCompressed[i]);
+                return decodedFiles;
+            }
+
+            if (!m_decodePool.isRunning())
+                m_decodePool.start(threadCount);
+
+            // Workers and the calling thread claim files from a shared index, results keep the scan order
+            struct DecodeBatch
+            {
+                std::atomic<size_t> m_nextFile{0};
+                std::atomic<size_t> m_filesDone{0};
+                std::mutex m_mutex;
+                std::condition_variable m_condition;
+            };
+            auto batch = std::make_shared<DecodeBatch>();
+            size_t fileCount = files.size();
+            // Helpers may still be claiming an index past the end after this function returned, so the loop
+            // only touches the references for indices it actually owns
+            auto decodeNext = [batch, fileCount, &files, &policies, &options, &keepCompressed, &decodedFiles]()
+            {
+                for (size_t i = batch->m_nextFile++; i < fileCount; i = batch->m_nextFile++)
+                {
+                    decodedFiles[i] = decodeFileImpl(files[i], policies[i], options[i], keepCompressed[i] != 0);
+                    if (++batch->m_filesDone == fileCount)
+                    {
+                        std::lock_guard<std::mutex> lock(batch->m_mutex);
+                        batch->m_condition.notify_all();
+                    }
+                }
+            };
+
+            size_t helpers = std::min(m_decodePool.getThreadCount(), files.size() - 1);
+            for (size_t i = 0; i < helpers; ++i)
+                m_decodePool.submit(decodeNext);
+            decodeNext();
+
+            std::unique_lock<std::mutex> lock(batch->m_mutex);
+            batch->m_condition.wait(lock, [&batch, fileCount]()
+                                    { return batch->m_filesDone == fileCount; });
+            return decodedFiles;
+        }
+
+        bool ResourceManager::insertBuffer(const std::string &cacheKey, std::unique_ptr<SoundBuffer> buffer)
+        {
+            BufferCacheEntry entry;
+            entry.m_buffer = std::move(buffer);
+            entry.m_referenceCount = 0;
+
+            m_currentCacheSize += entry.m_buffer->getSize();
+            emplaceCacheEntry(cacheKey, std::move(entry));
+
+            if (m_currentCacheSize > m_maxCacheSize)
+                freeBuffers();
+
+            return true;
+        }
+
+        bool ResourceManager::insertDecodedFile(DecodedFile &decoded)
+        {
+            if (decoded.m_failed)
+                return false;
+            if (decoded.m_compressed)
+                return insertCompressedFile(decoded.m_filePath, std::move(decoded.m_compressedData));
+
+            std::string cacheKey = decoded.m_filePath.string();
+            try
+            {
+                auto buffer = decoded.m_stream ? std::make_unique<SoundBuffer>(decoded.m_audioStream, cacheKey)
+                                               : std::make_unique<SoundBuffer>(std::move(decoded.m_audioData), cacheKey);
+                insertBuffer(cacheKey, std::move(buffer));
+            }
+            catch (const std::exception &e)
+            {
+                logcoe::error("ResourceManager::insertDecodedFile: Failed to create SoundBuffer: " + std::string(e.what()));
+                return false;
+            }
+
+            logcoe::info("ResourceManager::insertDecodedFile: preloadFile Successfully: \"" + cacheKey + "\"");
+            return true;
+        }
+
+        bool ResourceManager::insertCompressedFile(const std::filesystem::path &filePath, std::vector<uint8_t> &&data)
+        {
+            std::string cacheKey = filePath.string();
+            if (!reserveCompressedCache(data.size()))
+            {
+                // No room left in the compressed tier, the file becomes a regular PCM buffer
+                logcoe::info("ResourceManager::insertCompressedFile: Compressed cache is full, decoding \"" + cacheKey + "\"");
+                try
+                {
+                    AudioData audioData = AudioData::loadFromMemory(data.data(), data.size(), cacheKey, getDecodeOptionsForFile(filePath));
+                    insertBuffer(cacheKey, std::make_unique<SoundBuffer>(std::move(audioData), cacheKey));
+                }
+                catch (const std::exception &e)
+                {
+                    logcoe::error("ResourceManager::insertCompressedFile: Failed to create SoundBuffer: " + std::string(e.what()));
+                    return false;
+                }
+                return true;
+            }
+
+            BufferCacheEntry entry;
+            entry.m_buffer = std::make_unique<SoundBuffer>();
+            entry.m_referenceCount = 0;
+            entry.m_compressedData = std::move(data);
+
+            m_currentCompressedCacheSize += entry.m_compressedData.size();
+            emplaceCacheEntry(cacheKey, std::move(entry));
+            logcoe::info("ResourceManager::insertCompressedFile: Keeping \"" + cacheKey + "\" compressed in memory");
+            return true;
+        }
+
+        bool ResourceManager::decodeCompressedEntry(const std::string &cacheKey, BufferCacheEntry &entry)
+        {
+            try
+            {
+                AudioData audioData = AudioData::loadFromMemory(entry.m_compressedData.data(), entry.m_compressedData.size(),
+                                                                cacheKey, getDecodeOptionsForFile(cacheKey));
+                entry.m_buffer->loadFromAudioData(std::move(audioData), cacheKey);
+            }
+            catch (const std::exception &e)
+            {
+                logcoe::error("ResourceManager::decodeCompressedEntry: Failed to decode \"" + cacheKey + "\": " + std::string(e.what()));
+                return false;
+            }
+
+            m_currentDecodedCacheSize += entry.m_buffer->getSize();
+            return true;
+        }
+
+        std::vector<std::shared_ptr<AsyncLoad>>::iterator ResourceManager::findAsyncLoad(const std::string &subdirectory)
+        {
+            return std::find_if(m_asyncLoads.begin(), m_asyncLoads.end(), [&subdirectory](const std::shared_ptr<AsyncLoad> &load)
+                                { return load->m_subdirectory == subdirectory; });
+        }
+
+        void ResourceManager::finishAsyncLoad(AsyncLoad &load, bool succeeded)
+        {
+            load.m_state->m_succeeded = succeeded;
+            load.m_state->m_done = true;
+        }
+
+        void ResourceManager::cancelAsyncLoads()
+        {
+            for (auto &load : m_asyncLoads)
+            {
+                load->m_state->m_cancelled = true;
+                finishAsyncLoad(*load, false);
+            }
+            m_asyncLoads.clear();
+        }
+
         bool ResourceManager::preloadFileImpl(const std::filesystem::path &filePath)
         {
             if (!filePath.is_absolute())
@@ -522,6 +1672,12 @@ namespace soundcoe
                 return false;
             }
 
+            const SoundBank *bank = nullptr;
+            size_t bankIndex = 0;
+            if (findBankEntry(filePath, bank, bankIndex))
+                return m_bufferCache.find(filePath.string()) != m_bufferCache.end() ||
+                       insertBankEntry(*bank, bankIndex, filePath);
+
             try
             {
                 if (!std::filesystem::exists(filePath) || !std::filesystem::is_regular_file(filePath))
@@ -540,36 +1696,136 @@ namespace soundcoe
             if (m_bufferCache.find(cacheKey) != m_bufferCache.end())
                 return true;
 
-            try
+            DecodedFile decoded = decodeFileImpl(filePath, getStreamingPolicyForFile(filePath), getDecodeOptionsForFile(filePath),
+                                                 shouldKeepCompressed(filePath));
+            return insertDecodedFile(decoded);
+        }
+
+        std::filesystem::path ResourceManager::findBankFile(const std::string &subdirectory) const
+        {
+            std::string key = normalizeSubdirectory(subdirectory);
+            if (key.empty())
+                return std::filesystem::path();
+
+            std::filesystem::path bankFile = m_audioRootDirectory / normalizePath(key + SoundBank::FILE_EXTENSION);
+            std::error_code ec;
+            return std::filesystem::is_regular_file(bankFile, ec) ? bankFile : std::filesystem::path();
+        }
+
+        bool ResourceManager::preloadBankImpl(const std::string &subdirectory, const std::filesystem::path &bankFile)
+        {
+            SoundBank bank;
+            if (!bank.open(bankFile.string()))
+            {
+                logcoe::error("ResourceManager::preloadBankImpl: Failed to open sound bank: \"" + bankFile.string() + "\"");
+                return false;
+            }
+
+            std::filesystem::path directory = m_audioRootDirectory / normalizePath(subdirectory);
+            std::vector<std::filesystem::path> files;
+            files.reserve(bank.getEntryCount());
+            size_t uploaded = 0;
+            for (size_t i = 0; i < bank.getEntryCount(); ++i)
             {
-                BufferCacheEntry entry;
+                std::filesystem::path filePath = (directory / bank.getName(i)).lexically_normal();
+                files.push_back(filePath);
+                if (m_bufferCache.find(filePath.string()) == m_bufferCache.end() && insertBankEntry(bank, i, filePath))
+                    ++uploaded;
+            }
+            indexDirectoryFiles(subdirectory, files);
 
-                entry.m_buffer = std::make_unique<SoundBuffer>(cacheKey);
-                entry.m_referenceCount = 0;
-                entry.m_lastAccessed = std::chrono::steady_clock::now();
+            logcoe::info("ResourceManager::preloadBankImpl: Uploaded " + std::to_string(uploaded) + " of " +
+                         std::to_string(bank.getEntryCount()) + " files from \"" + bankFile.string() + "\"");
 
-                m_currentCacheSize += entry.m_buffer->getSize();
-                m_bufferCache[cacheKey] = std::move(entry);
+            // The mapping stays open so evicted entries can be uploaded again without touching the disk
+            m_loadedBanks[subdirectory] = std::move(bank);
+            return true;
+        }
+
+        bool ResourceManager::findBankEntry(const std::filesystem::path &filePath, const SoundBank *&bank, size_t &index) const
+        {
+            for (const auto &loaded : m_loadedBanks)
+            {
+                std::filesystem::path directory = (m_audioRootDirectory / normalizePath(loaded.first)).lexically_normal();
+                std::filesystem::path relative = filePath.lexically_normal().lexically_relative(directory);
+                if (relative.empty() || *relative.begin() == "..")
+                    continue;
+
+                if (loaded.second.find(relative.generic_string(), index))
+                {
+                    bank = &loaded.second;
+                    return true;
+                }
             }
-            catch (const std::exception &e)
+            return false;
+        }
+
+        bool ResourceManager::insertBankEntry(const SoundBank &bank, size_t index, const std::filesystem::path &filePath)
+        {
+            std::string cacheKey = filePath.string();
+            const BankEntry &entry = bank.getEntry(index);
+            ALenum format = bank.getOpenALFormat(index);
+            if (format == AL_NONE)
             {
-                logcoe::error("ResourceManager::preloadFileImpl: Failed to create SoundBuffer: " + std::string(e.what()));
-                m_bufferCache.erase(cacheKey);
+                logcoe::error("ResourceManager::insertBankEntry: Unsupported sample format for \"" + cacheKey + "\"");
                 return false;
             }
 
-            if (m_currentCacheSize > m_maxCacheSize)
-                freeBuffers();
+            const uint8_t *data = bank.getData(index);
+            size_t dataSize = static_cast<size_t>(entry.m_dataSize);
+            std::vector<uint8_t> converted;
+            const uint16_t endianProbe = 1;
+            if (entry.m_encoding == BankEncoding::Pcm16 && *reinterpret_cast<const uint8_t *>(&endianProbe) != 1)
+            {
+                // Bank samples are little endian
+                converted.assign(data, data + dataSize);
+                for (size_t i = 0; i + 1 < converted.size(); i += 2)
+                    std::swap(converted[i], converted[i + 1]);
+                data = converted.data();
+            }
+            else if (entry.m_encoding != BankEncoding::Pcm16 &&
+                     !isCompressionSupported(entry.m_encoding == BankEncoding::Ima4 ? BufferCompression::Ima4 : BufferCompression::MsAdpcm))
+            {
+                // A bank packed for ADPCM still plays on devices without the extension, at full PCM size
+                bool ima4 = entry.m_encoding == BankEncoding::Ima4;
+                size_t channels = entry.m_channels;
+                size_t blockCount = dataSize / entry.m_blockAlign;
+                size_t frameCount = blockCount * (ima4 ? adpcm::IMA4_FRAMES_PER_BLOCK : adpcm::MSADPCM_FRAMES_PER_BLOCK);
+                converted.resize(frameCount * channels * sizeof(int16_t));
+                int16_t *samples = reinterpret_cast<int16_t *>(converted.data());
+                if (ima4)
+                    adpcm::decodeIma4(data, samples, blockCount, channels);
+                else
+                    adpcm::decodeMsAdpcm(data, samples, blockCount, channels);
+
+                data = converted.data();
+                dataSize = converted.size();
+                format = channels == 1 ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
+            }
+
+            try
+            {
+                insertBuffer(cacheKey, std::make_unique<SoundBuffer>(data, format, static_cast<ALsizei>(dataSize),
+                                                                     static_cast<ALsizei>(entry.m_sampleRate), cacheKey));
+            }
+            catch (const std::exception &e)
+            {
+                logcoe::error("ResourceManager::insertBankEntry: Failed to create SoundBuffer: " + std::string(e.what()));
+                return false;
+            }
 
-            logcoe::info("ResourceManager::preloadFileImpl: preloadFile Successfully: \"" + cacheKey + "\"");
             return true;
         }
 
         bool ResourceManager::unloadFileImpl(const std::filesystem::path &filePath)
         {
+            const SoundBank *bank = nullptr;
+            size_t bankIndex = 0;
             try
             {
-                if (!std::filesystem::exists(filePath) || !std::filesystem::is_regular_file(filePath))
+                // Files served from a bank do not exist on disk
+                if (!findBankEntry(filePath, bank, bankIndex) &&
+                    (!std::filesystem::exists(filePath) || !std::filesystem::is_regular_file(filePath)))
                 {
                     logcoe::warning("ResourceManager::unloadFileImpl: Not a File: \"" + filePath.string() + "\"");
                     return true;
@@ -590,30 +1846,9 @@ namespace soundcoe
 
             auto &entry = m_bufferCache[cacheKey];
             if (entry.m_referenceCount > 0)
-            {
-                auto bufferId = entry.m_buffer->getBufferId();
-                for (size_t i = 0; i < m_sourcePool.size(); ++i)
-                {
-                    auto &allocation = m_sourcePool[i];
-                    if (!allocation.m_active || allocation.m_source->getBufferId() != bufferId)
-                        continue;
+                detachBufferFromSources(entry.m_buffer->getBufferId());
 
-                    try
-                    {
-                        allocation.m_source->detachBuffer();
-                    }
-                    catch (const std::exception &e)
-                    {
-                        logcoe::warning("ResourceManager::unloadFileImpl: Failed to detach Buffer: " + std::string(e.what()));
-                    }
-
-                    allocation.m_active = false;
-                    m_freeSourceIndices.push_back(i);
-                }
-            }
-
-            m_currentCacheSize -= entry.m_buffer->getSize();
-            m_bufferCache.erase(cacheKey);
+            eraseCacheEntry(m_bufferCache.find(cacheKey));
             return true;
         }
 
@@ -624,22 +1859,7 @@ namespace soundcoe
             return it != m_loadedDirectories.end();
         }
 
-        SoundPriority ResourceManager::getHighestPriorityForBuffer(ALuint bufferId) const
-        {
-            SoundPriority highest = SoundPriority::Low;
-            for (const auto &allocation : m_sourcePool)
-            {
-                if (allocation.m_active && allocation.m_source->getBufferId() == bufferId &&
-                    allocation.m_priority > highest)
-                {
-                    highest = allocation.m_priority;
-                }
-            }
-
-            return highest;
-        }
-
-        bool ResourceManager::releaseBufferImpl(const std::string &filename)
+        bool ResourceManager::releaseBufferImpl(const std::string &filename, SoundPriority priority)
         {
             if (!m_initialized)
             {
@@ -654,7 +1874,7 @@ namespace soundcoe
                 return true;
             }
 
-            std::string cacheKey = foundPath.lexically_normal().string();
+            std::string cacheKey = foundPath.string();
             if (m_bufferCache.find(cacheKey) == m_bufferCache.end())
             {
                 logcoe::warning("ResourceManager::releaseBufferImpl: Buffer is not loaded in cache: " + cacheKey);
@@ -668,20 +1888,65 @@ namespace soundcoe
                 return true;
             }
 
-            --entry.m_referenceCount;
+            dereferenceEntry(entry, priority);
             return true;
         }
 
+        void ResourceManager::indexDirectoryFiles(const std::string &subdirectory, const std::vector<std::filesystem::path> &files)
+        {
+            std::filesystem::path directory = (m_audioRootDirectory / normalizePath(subdirectory)).lexically_normal();
+            for (const auto &file : files)
+            {
+                std::filesystem::path filePath = file.lexically_normal();
+                std::filesystem::path relative = filePath.lexically_relative(directory);
+                if (relative.empty() || *relative.begin() == "..")
+                    continue;
+
+                m_fileIndex[relative.generic_string()].push_back({subdirectory, filePath.string()});
+            }
+            resetRegisteredSounds();
+        }
+
+        void ResourceManager::unindexDirectoryFiles(const std::string &subdirectory)
+        {
+            for (auto it = m_fileIndex.begin(); it != m_fileIndex.end();)
+            {
+                auto &candidates = it->second;
+                candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [&subdirectory](const IndexedFile &file)
+                                                { return file.m_subdirectory == subdirectory; }),
+                                 candidates.end());
+                if (candidates.empty())
+                    it = m_fileIndex.erase(it);
+                else
+                    ++it;
+            }
+            resetRegisteredSounds();
+        }
+
         std::filesystem::path ResourceManager::findFileInLoadedDirectories(const std::string &filename) const
         {
-            auto loadedDirs = m_loadedDirectories;
-            for(const auto &dir : loadedDirs)
+            // Names are resolved from the index built at preload, files added to a directory afterwards need a reload
+            auto it = m_fileIndex.find(filename);
+            if (it != m_fileIndex.end())
+                return std::filesystem::path(it->second.front().m_cacheKey);
+
+            std::filesystem::path filePath = std::filesystem::path(filename).lexically_normal();
+            if (!filePath.is_absolute())
             {
-                std::filesystem::path candidatePath = (m_audioRootDirectory / dir / filename).lexically_normal();
-                if (std::filesystem::exists(candidatePath) && std::filesystem::is_regular_file(candidatePath))
-                {
-                    return candidatePath;
-                }
+                it = m_fileIndex.find(filePath.generic_string());
+                return it != m_fileIndex.end() ? std::filesystem::path(it->second.front().m_cacheKey) : std::filesystem::path();
+            }
+
+            // Absolute paths (a buffer's own file name) resolve if they are inside a loaded directory
+            if (m_bufferCache.find(filePath.string()) != m_bufferCache.end())
+                return filePath;
+            for (const auto &dir : m_loadedDirectories)
+            {
+                std::filesystem::path relative = filePath.lexically_relative((m_audioRootDirectory / dir).lexically_normal());
+                if (relative.empty() || *relative.begin() == "..")
+                    continue;
+                if (m_fileIndex.find(relative.generic_string()) != m_fileIndex.end())
+                    return filePath;
             }
             return std::filesystem::path();
         }
@@ -693,5 +1958,12 @@ namespace soundcoe
                 return std::ref(m_sourcePool[index]);
             return std::nullopt;
         }
+
+        std::vector<SourceAllocation> &ResourceManager::getSourceAllocations()
+        {
+            // The pool is only resized by initialize and shutdown, one lock covers a pass over every voice
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_sourcePool;
+        }
     } // namespace detail
 } // namespace soundcoe
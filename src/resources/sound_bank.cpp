@@ -0,0 +1,351 @@
+#include <soundcoe/resources/sound_bank.hpp>
+#include <soundcoe/core/types.hpp>
+#include <soundcoe/utils/adpcm.hpp>
+#include <AL/alext.h>
+#include <logcoe.hpp>
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+namespace soundcoe
+{
+    namespace detail
+    {
+        static constexpr size_t BANK_HEADER_SIZE = 32;
+        static constexpr size_t BANK_ENTRY_SIZE = 48;
+        static constexpr size_t BANK_PAYLOAD_ALIGNMENT = 16;
+
+        static uint16_t readU16(const uint8_t *bytes) { return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8)); }
+
+        static uint32_t readU32(const uint8_t *bytes)
+        {
+            return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+                   (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+        }
+
+        static uint64_t readU64(const uint8_t *bytes)
+        {
+            return static_cast<uint64_t>(readU32(bytes)) | (static_cast<uint64_t>(readU32(bytes + 4)) << 32);
+        }
+
+        static void writeU16(std::vector<uint8_t> &out, uint16_t value)
+        {
+            out.push_back(static_cast<uint8_t>(value));
+            out.push_back(static_cast<uint8_t>(value >> 8));
+        }
+
+        static void writeU32(std::vector<uint8_t> &out, uint32_t value)
+        {
+            for (int shift = 0; shift < 32; shift += 8)
+                out.push_back(static_cast<uint8_t>(value >> shift));
+        }
+
+        static void writeU64(std::vector<uint8_t> &out, uint64_t value)
+        {
+            writeU32(out, static_cast<uint32_t>(value));
+            writeU32(out, static_cast<uint32_t>(value >> 32));
+        }
+
+        uint64_t SoundBank::hashName(const std::string &name)
+        {
+            return makeSoundId(name).value;
+        }
+
+        bool SoundBank::pack(const std::string &directory, const std::string &bankFile, const DecodeOptions &options)
+        {
+            std::filesystem::path root(directory);
+            std::vector<std::filesystem::path> files;
+            try
+            {
+                for (const auto &entry : std::filesystem::recursive_directory_iterator(root))
+                    if (entry.is_regular_file())
+                        files.push_back(entry.path());
+            }
+            catch (const std::exception &e)
+            {
+                logcoe::error("SoundBank::pack: Failed to scan \"" + directory + "\": " + std::string(e.what()));
+                return false;
+            }
+            std::sort(files.begin(), files.end());
+
+            // Payloads are always 16-bit, the bank must play on devices without AL_EXT_FLOAT32
+            DecodeOptions packOptions = options;
+            packOptions.floatOutput = false;
+
+            struct PackedFile
+            {
+                BankEntry m_entry;
+                std::string m_name;
+                AudioData m_audioData;
+            };
+            std::vector<PackedFile> packedFiles;
+            for (const auto &file : files)
+            {
+                if (AudioData::detectFormat(file.string()) == AudioFormat::Unsupported)
+                    continue;
+
+                PackedFile packed;
+                packed.m_name = file.lexically_relative(root).generic_string();
+                try { packed.m_audioData = AudioData::loadFromFile(file.string(), packOptions); }
+                catch (const std::exception &e)
+                {
+                    logcoe::warning("SoundBank::pack: Skipping \"" + file.string() + "\": " + std::string(e.what()));
+                    continue;
+                }
+
+                BankEntry &entry = packed.m_entry;
+                entry.m_nameHash = hashName(packed.m_name);
+                entry.m_dataSize = static_cast<uint64_t>(packed.m_audioData.getPcmDataSize());
+                entry.m_sampleRate = static_cast<uint32_t>(packed.m_audioData.getSampleRate());
+                entry.m_channels = static_cast<uint16_t>(packed.m_audioData.getChannels());
+                entry.m_bitsPerSample = static_cast<uint16_t>(packed.m_audioData.getBitsPerSample());
+                switch (packed.m_audioData.getOpenALFormat())
+                {
+                case AL_FORMAT_MONO16:
+                case AL_FORMAT_STEREO16:
+                    entry.m_encoding = BankEncoding::Pcm16;
+                    entry.m_blockAlign = static_cast<uint16_t>(entry.m_channels * 2);
+                    break;
+                case AL_FORMAT_MONO_IMA4:
+                case AL_FORMAT_STEREO_IMA4:
+                    entry.m_encoding = BankEncoding::Ima4;
+                    entry.m_blockAlign = static_cast<uint16_t>(adpcm::getIma4BlockSize(entry.m_channels));
+                    break;
+                case AL_FORMAT_MONO_MSADPCM_SOFT:
+                case AL_FORMAT_STEREO_MSADPCM_SOFT:
+                    entry.m_encoding = BankEncoding::MsAdpcm;
+                    entry.m_blockAlign = static_cast<uint16_t>(adpcm::getMsAdpcmBlockSize(entry.m_channels));
+                    break;
+                default:
+                    logcoe::warning("SoundBank::pack: Skipping \"" + file.string() + "\": Only 16-bit mono and stereo files can be packed");
+                    continue;
+                }
+                packedFiles.push_back(std::move(packed));
+            }
+
+            if (packedFiles.empty())
+            {
+                logcoe::warning("SoundBank::pack: No audio files found in \"" + directory + "\"");
+                return false;
+            }
+
+            std::sort(packedFiles.begin(), packedFiles.end(), [](const PackedFile &a, const PackedFile &b)
+                      { return a.m_entry.m_nameHash < b.m_entry.m_nameHash; });
+
+            // Lay out the names right after the index and the payloads after the names
+            uint64_t namesOffset = BANK_HEADER_SIZE + BANK_ENTRY_SIZE * packedFiles.size();
+            uint64_t namesSize = 0;
+            for (auto &packed : packedFiles)
+            {
+                packed.m_entry.m_nameOffset = static_cast<uint32_t>(namesSize);
+                packed.m_entry.m_nameLength = static_cast<uint32_t>(packed.m_name.size());
+                namesSize += packed.m_name.size();
+            }
+
+            uint64_t dataOffset = namesOffset + namesSize;
+            for (auto &packed : packedFiles)
+            {
+                dataOffset = (dataOffset + BANK_PAYLOAD_ALIGNMENT - 1) & ~static_cast<uint64_t>(BANK_PAYLOAD_ALIGNMENT - 1);
+                packed.m_entry.m_dataOffset = dataOffset;
+                dataOffset += packed.m_entry.m_dataSize;
+            }
+
+            std::vector<uint8_t> header;
+            header.reserve(static_cast<size_t>(namesOffset + namesSize));
+            header.insert(header.end(), {'S', 'C', 'B', 'K'});
+            writeU32(header, VERSION);
+            writeU32(header, static_cast<uint32_t>(packedFiles.size()));
+            writeU32(header, 0);
+            writeU64(header, namesOffset);
+            writeU64(header, namesSize);
+            for (const auto &packed : packedFiles)
+            {
+                const BankEntry &entry = packed.m_entry;
+                writeU64(header, entry.m_nameHash);
+                writeU64(header, entry.m_dataOffset);
+                writeU64(header, entry.m_dataSize);
+                writeU32(header, entry.m_nameOffset);
+                writeU32(header, entry.m_nameLength);
+                writeU32(header, entry.m_sampleRate);
+                writeU16(header, entry.m_channels);
+                writeU16(header, entry.m_bitsPerSample);
+                writeU16(header, static_cast<uint16_t>(entry.m_encoding));
+                writeU16(header, entry.m_blockAlign);
+                writeU32(header, 0);
+            }
+            for (const auto &packed : packedFiles)
+                header.insert(header.end(), packed.m_name.begin(), packed.m_name.end());
+
+            std::ofstream out(bankFile, std::ios::binary | std::ios::trunc);
+            if (!out)
+            {
+                logcoe::error("SoundBank::pack: Cannot create \"" + bankFile + "\"");
+                return false;
+            }
+            out.write(reinterpret_cast<const char *>(header.data()), static_cast<std::streamsize>(header.size()));
+
+            uint64_t written = header.size();
+            std::vector<uint8_t> samples;
+            for (const auto &packed : packedFiles)
+            {
+                static const char padding[BANK_PAYLOAD_ALIGNMENT] = {};
+                out.write(padding, static_cast<std::streamsize>(packed.m_entry.m_dataOffset - written));
+
+                // Samples are stored little endian whatever the packing host is, ADPCM blocks already are
+                const uint8_t *pcm = static_cast<const uint8_t *>(packed.m_audioData.getPcmData());
+                samples.assign(pcm, pcm + packed.m_entry.m_dataSize);
+                const uint16_t endianProbe = 1;
+                if (packed.m_entry.m_encoding == BankEncoding::Pcm16 && *reinterpret_cast<const uint8_t *>(&endianProbe) != 1)
+                    for (size_t i = 0; i + 1 < samples.size(); i += 2)
+                        std::swap(samples[i], samples[i + 1]);
+
+                out.write(reinterpret_cast<const char *>(samples.data()), static_cast<std::streamsize>(samples.size()));
+                written = packed.m_entry.m_dataOffset + packed.m_entry.m_dataSize;
+            }
+
+            if (!out)
+            {
+                logcoe::error("SoundBank::pack: Failed to write \"" + bankFile + "\"");
+                return false;
+            }
+
+            logcoe::info("SoundBank::pack: Packed " + std::to_string(packedFiles.size()) + " files from \"" + directory +
+                         "\" into \"" + bankFile + "\"");
+            return true;
+        }
+
+        bool SoundBank::open(const std::string &filename)
+        {
+            close();
+            if (!m_file.open(filename))
+                return false;
+
+            const uint8_t *data = m_file.data();
+            size_t size = m_file.size();
+            auto fail = [this, &filename](const std::string &reason)
+            {
+                logcoe::error("SoundBank::open: \"" + filename + "\" " + reason);
+                close();
+                return false;
+            };
+
+            if (size < BANK_HEADER_SIZE || std::memcmp(data, "SCBK", 4) != 0)
+                return fail("is not a sound bank");
+            if (readU32(data + 4) != VERSION)
+                return fail("has unsupported version " + std::to_string(readU32(data + 4)));
+
+            size_t entryCount = readU32(data + 8);
+            uint64_t namesOffset = readU64(data + 16);
+            uint64_t namesSize = readU64(data + 24);
+            if (BANK_HEADER_SIZE + entryCount * BANK_ENTRY_SIZE > size || namesOffset > size || namesSize > size - namesOffset)
+                return fail("is truncated");
+
+            m_entries.reserve(entryCount);
+            for (size_t i = 0; i < entryCount; ++i)
+            {
+                const uint8_t *bytes = data + BANK_HEADER_SIZE + i * BANK_ENTRY_SIZE;
+                BankEntry entry;
+                entry.m_nameHash = readU64(bytes);
+                entry.m_dataOffset = readU64(bytes + 8);
+                entry.m_dataSize = readU64(bytes + 16);
+                entry.m_nameOffset = readU32(bytes + 24);
+                entry.m_nameLength = readU32(bytes + 28);
+                entry.m_sampleRate = readU32(bytes + 32);
+                entry.m_channels = readU16(bytes + 36);
+                entry.m_bitsPerSample = readU16(bytes + 38);
+                entry.m_encoding = static_cast<BankEncoding>(readU16(bytes + 40));
+                entry.m_blockAlign = readU16(bytes + 42);
+
+                if (entry.m_dataOffset > size || entry.m_dataSize > size - entry.m_dataOffset ||
+                    static_cast<uint64_t>(entry.m_nameOffset) + entry.m_nameLength > namesSize ||
+                    entry.m_dataSize > static_cast<uint64_t>(std::numeric_limits<ALsizei>::max()))
+                    return fail("has an entry pointing outside the file");
+                if (entry.m_encoding != BankEncoding::Pcm16)
+                {
+                    // The ADPCM formats are uploaded at OpenAL's default block alignment
+                    size_t blockSize = entry.m_encoding == BankEncoding::Ima4 ? adpcm::getIma4BlockSize(entry.m_channels)
+                                                                              : adpcm::getMsAdpcmBlockSize(entry.m_channels);
+                    if (entry.m_blockAlign != blockSize || blockSize == 0 || entry.m_dataSize % blockSize != 0)
+                        return fail("has an ADPCM entry with an unexpected block size");
+                }
+                if (!m_entries.empty() && m_entries.back().m_nameHash > entry.m_nameHash)
+                    return fail("has an unsorted index");
+
+                m_entries.push_back(entry);
+            }
+
+            // Names are read relative to the names table from now on
+            for (auto &entry : m_entries)
+                entry.m_nameOffset += static_cast<uint32_t>(namesOffset);
+
+            logcoe::info("SoundBank::open: Opened \"" + filename + "\" with " + std::to_string(m_entries.size()) + " entries");
+            return true;
+        }
+
+        void SoundBank::close()
+        {
+            m_entries.clear();
+            m_file.close();
+        }
+
+        bool SoundBank::isOpen() const { return m_file.isOpen(); }
+
+        size_t SoundBank::getEntryCount() const { return m_entries.size(); }
+
+        const BankEntry &SoundBank::getEntry(size_t index) const { return m_entries[index]; }
+
+        std::string SoundBank::getName(size_t index) const
+        {
+            const BankEntry &entry = m_entries[index];
+            return std::string(reinterpret_cast<const char *>(m_file.data() + entry.m_nameOffset), entry.m_nameLength);
+        }
+
+        bool SoundBank::find(const std::string &name, size_t &index) const
+        {
+            std::string key = std::filesystem::path(name).lexically_normal().generic_string();
+            uint64_t hash = hashName(key);
+            auto it = std::lower_bound(m_entries.begin(), m_entries.end(), hash, [](const BankEntry &entry, uint64_t value)
+                                       { return entry.m_nameHash < value; });
+
+            // Colliding hashes sit next to each other, the stored name settles it
+            for (; it != m_entries.end() && it->m_nameHash == hash; ++it)
+            {
+                size_t candidate = static_cast<size_t>(it - m_entries.begin());
+                if (it->m_nameLength == key.size() &&
+                    std::memcmp(m_file.data() + it->m_nameOffset, key.data(), key.size()) == 0)
+                {
+                    index = candidate;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        const uint8_t *SoundBank::getData(size_t index) const { return m_file.data() + m_entries[index].m_dataOffset; }
+
+        ALenum SoundBank::getOpenALFormat(size_t index) const
+        {
+            const BankEntry &entry = m_entries[index];
+            if (entry.m_channels != 1 && entry.m_channels != 2)
+                return AL_NONE;
+
+            bool mono = entry.m_channels == 1;
+            switch (entry.m_encoding)
+            {
+            case BankEncoding::Pcm16:
+                return entry.m_bitsPerSample == 16 ? (mono ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16) : AL_NONE;
+            case BankEncoding::Ima4:
+                return mono ? AL_FORMAT_MONO_IMA4 : AL_FORMAT_STEREO_IMA4;
+            case BankEncoding::MsAdpcm:
+                return mono ? AL_FORMAT_MONO_MSADPCM_SOFT : AL_FORMAT_STEREO_MSADPCM_SOFT;
+            default:
+                return AL_NONE;
+            }
+        }
+
+        const std::string &SoundBank::getFileName() const { return m_file.getFileName(); }
+    } // namespace detail
+} // namespace soundcoe
\ No newline at end of file
@@ -1,7 +1,10 @@
 #include <soundcoe/resources/sound_buffer.hpp>
+#include <soundcoe/resources/audio_stream.hpp>
 #include <soundcoe/core/audio_context.hpp>
 #include <soundcoe/core/error_handler.hpp>
 #include <soundcoe/core/types.hpp>
+#include <soundcoe/utils/adpcm.hpp>
+#include <AL/alext.h>
 #include <logcoe.hpp>
 #include <iostream>
 #include <exception>
@@ -12,19 +15,6 @@ namespace soundcoe
 {
     namespace detail
     {
-        void SoundBuffer::loadFromAudioData(AudioData &&audioData)
-        {
-            const void *data = audioData.getPcmData();
-            m_format = audioData.getOpenALFormat();
-            m_size = audioData.getPcmDataSize();
-            m_sampleRate = audioData.getSampleRate();
-            m_duration = audioData.getDuration();
-
-            generateBuffer(data);
-
-            m_loaded = true;
-        }
-
         void SoundBuffer::generateBuffer(const void* data)
         {
             alGenBuffers(1, &m_bufferId);
@@ -42,14 +32,25 @@ namespace soundcoe
 
         SoundBuffer::SoundBuffer() { }
 
-        SoundBuffer::SoundBuffer(const std::string &filename) : SoundBuffer()
+        SoundBuffer::SoundBuffer(const std::string &filename, bool stream, const DecodeOptions &options) : SoundBuffer()
+        {
+            loadFromFile(filename, stream, options);
+        }
+
+        SoundBuffer::SoundBuffer(const void *data, ALenum format, ALsizei size, ALsizei sampleRate,
+                                 const std::string &filename) : SoundBuffer()
         {
-            loadFromFile(filename);
+            loadFromMemory(data, format, size, sampleRate, filename);
         }
 
-        SoundBuffer::SoundBuffer(const void *data, ALenum format, ALsizei size, ALsizei sampleRate) : SoundBuffer()
+        SoundBuffer::SoundBuffer(AudioData &&audioData, const std::string &filename) : SoundBuffer()
         {
-            loadFromMemory(data, format, size, sampleRate);
+            loadFromAudioData(std::move(audioData), filename);
+        }
+
+        SoundBuffer::SoundBuffer(const AudioStream &stream, const std::string &filename) : SoundBuffer()
+        {
+            loadStreamInfo(stream, filename);
         }
 
         SoundBuffer::~SoundBuffer()
@@ -63,10 +64,12 @@ namespace soundcoe
                                                                 m_format(other.m_format),
                                                                 m_size(other.m_size),
                                                                 m_sampleRate(other.m_sampleRate),
-                                                                m_duration(other.m_duration)
+                                                                m_duration(other.m_duration),
+                                                                m_stream(other.m_stream)
         {
             other.m_bufferId = 0;
             other.m_loaded = false;
+            other.m_stream = false;
             other.m_format = AL_NONE;
             other.m_size = 0;
             other.m_sampleRate = 0;
@@ -86,9 +89,11 @@ namespace soundcoe
             m_size = other.m_size;
             m_sampleRate = other.m_sampleRate;
             m_duration = other.m_duration;
+            m_stream = other.m_stream;
 
             other.m_bufferId = 0;
             other.m_loaded = false;
+            other.m_stream = false;
             other.m_format = AL_NONE;
             other.m_size = 0;
             other.m_sampleRate = 0;
@@ -97,7 +102,7 @@ namespace soundcoe
             return *this;
         }
 
-        void SoundBuffer::loadFromFile(const std::string &filename)
+        void SoundBuffer::loadFromFile(const std::string &filename, bool stream, const DecodeOptions &options)
         {
             unload();
 
@@ -116,32 +121,23 @@ namespace soundcoe
                 throw std::runtime_error(message);
             }
 
-            m_filename = filename;
-
-            AudioFormat format = AudioData::detectFormat(filename);
-            switch(format)
+            if (stream)
             {
-                case AudioFormat::Wav:
-                    loadFromAudioData(std::move(AudioData::loadFromWav(filename)));
-                    break;
-                case AudioFormat::Mp3:
-                    loadFromAudioData(std::move(AudioData::loadFromMp3(filename)));
-                    break;
-                case AudioFormat::Ogg:
-                    loadFromAudioData(std::move(AudioData::loadFromOgg(filename)));
-                    break;
-                default:
-                    std::string message = "SoundBuffer::loadFromFile: Unsupported audio format: " + filename;
-                    logcoe::error(message);
-                    throw std::runtime_error(message);
+                loadStreamInfo(AudioStream(filename), filename);
+                logcoe::info("SoundBuffer::loadFromFile: SoundBuffer prepared for streaming");
+                return;
             }
+
+            loadFromAudioData(AudioData::loadFromFile(filename, options), filename);
             logcoe::info("SoundBuffer::loadFromFile: SoundBuffer loaded successfully");
         }
 
-        void SoundBuffer::loadFromMemory(const void *data, ALenum format, ALsizei size, ALsizei sampleRate)
+        void SoundBuffer::loadFromMemory(const void *data, ALenum format, ALsizei size, ALsizei sampleRate,
+                                         const std::string &filename)
         {
             unload();
 
+            m_filename = filename;
             m_format = format;
             m_size = size;
             m_sampleRate = sampleRate;
@@ -161,6 +157,22 @@ namespace soundcoe
             case AL_FORMAT_STEREO16:
                 bytesPerSample = 4.0f;
                 break;
+            case AL_FORMAT_MONO_FLOAT32:
+                bytesPerSample = 4.0f;
+                break;
+            case AL_FORMAT_STEREO_FLOAT32:
+                bytesPerSample = 8.0f;
+                break;
+            case AL_FORMAT_MONO_IMA4:
+            case AL_FORMAT_STEREO_IMA4:
+                bytesPerSample = static_cast<float>(adpcm::getIma4BlockSize(format == AL_FORMAT_MONO_IMA4 ? 1 : 2)) /
+                                 adpcm::IMA4_FRAMES_PER_BLOCK;
+                break;
+            case AL_FORMAT_MONO_MSADPCM_SOFT:
+            case AL_FORMAT_STEREO_MSADPCM_SOFT:
+                bytesPerSample = static_cast<float>(adpcm::getMsAdpcmBlockSize(format == AL_FORMAT_MONO_MSADPCM_SOFT ? 1 : 2)) /
+                                 adpcm::MSADPCM_FRAMES_PER_BLOCK;
+                break;
             default:
                 bytesPerSample = 0.0f;
                 break;
@@ -174,14 +186,53 @@ namespace soundcoe
             logcoe::info("SoundBuffer::loadFromMemory: SoundBuffer loaded successfully");
         }
 
+        void SoundBuffer::loadFromAudioData(AudioData &&audioData, const std::string &filename)
+        {
+            unload();
+
+            AudioData data = std::move(audioData);
+            if (!(data.isValid()) || data.getOpenALFormat() == AL_NONE)
+            {
+                std::string message = "SoundBuffer::loadFromAudioData: Invalid audio data for \"" + filename + "\"";
+                logcoe::error(message);
+                throw std::runtime_error(message);
+            }
+
+            m_filename = filename;
+            m_format = data.getOpenALFormat();
+            m_size = data.getPcmDataSize();
+            m_sampleRate = data.getSampleRate();
+            m_duration = data.getDuration();
+
+            generateBuffer(data.getPcmData());
+
+            m_loaded = true;
+        }
+
+        void SoundBuffer::loadStreamInfo(const AudioStream &stream, const std::string &filename)
+        {
+            unload();
+
+            m_filename = filename;
+            m_format = stream.getOpenALFormat();
+            m_size = 0;
+            m_sampleRate = stream.getSampleRate();
+            m_duration = stream.getDuration();
+            m_stream = true;
+
+            m_loaded = true;
+        }
+
         void SoundBuffer::unload()
         {
-            if (!m_loaded || !m_bufferId)
+            if (!m_loaded)
                 return;
 
-            alDeleteBuffers(1, &m_bufferId);
+            if (m_bufferId)
+                alDeleteBuffers(1, &m_bufferId);
             m_bufferId = 0;
             m_loaded = false;
+            m_stream = false;
         }
 
         ALuint SoundBuffer::getBufferId() const { return m_bufferId; }
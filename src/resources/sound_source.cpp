@@ -118,6 +118,66 @@ namespace soundcoe
             ErrorHandler::throwOnOpenALError("Detach Buffer from Source");
         }
 
+        bool SoundSource::queueBuffers(const ALuint *bufferIds, ALsizei count)
+        {
+            if(!m_created) create();
+            if(count <= 0) return true;
+
+            alSourceQueueBuffers(m_sourceId, count, bufferIds);
+            if(ErrorHandler::checkOpenALError("Queue Buffers"))
+                return false;
+
+            return true;
+        }
+
+        bool SoundSource::unqueueBuffers(ALuint *bufferIds, ALsizei count)
+        {
+            if(!m_created)
+            {
+                logcoe::warning("SoundSource::unqueueBuffers: SoundSource not created");
+                return false;
+            }
+            if(count <= 0) return true;
+
+            alSourceUnqueueBuffers(m_sourceId, count, bufferIds);
+            if(ErrorHandler::checkOpenALError("Unqueue Buffers"))
+                return false;
+
+            return true;
+        }
+
+        ALint SoundSource::getBuffersQueued() const
+        {
+            if(!m_created)
+            {
+                logcoe::warning("SoundSource::getBuffersQueued: SoundSource not created");
+                return 0;
+            }
+
+            ALint queued = 0;
+            alGetSourcei(m_sourceId, AL_BUFFERS_QUEUED, &queued);
+            if(ErrorHandler::checkOpenALError("Get Buffers Queued"))
+                return 0;
+
+            return queued;
+        }
+
+        ALint SoundSource::getBuffersProcessed() const
+        {
+            if(!m_created)
+            {
+                logcoe::warning("SoundSource::getBuffersProcessed: SoundSource not created");
+                return 0;
+            }
+
+            ALint processed = 0;
+            alGetSourcei(m_sourceId, AL_BUFFERS_PROCESSED, &processed);
+            if(ErrorHandler::checkOpenALError("Get Buffers Processed"))
+                return 0;
+
+            return processed;
+        }
+
         bool SoundSource::play()
         {
             if(!m_created)
@@ -213,7 +273,7 @@ namespace soundcoe
             return true;
         }
 
-        bool SoundSource::setPosition(const Vec3 &position)
+        bool SoundSource::setPosition(const Vec3 &position, bool checkError)
         {
             if(!m_created)
             {
@@ -222,7 +282,8 @@ namespace soundcoe
             }
             alSource3f(m_sourceId, AL_POSITION,
                     static_cast<ALfloat>(position.x), static_cast<ALfloat>(position.y), static_cast<ALfloat>(position.z));
-            if (ErrorHandler::checkOpenALError("Set Position"))
+            // A batch checks the AL error once after all of its sources instead
+            if (checkError && ErrorHandler::checkOpenALError("Set Position"))
                 return false;
 
             m_position = position;
@@ -261,6 +322,20 @@ namespace soundcoe
             return true;
         }
 
+        bool SoundSource::setPlaybackOffset(float seconds)
+        {
+            if(!m_created)
+            {
+                logcoe::warning("SoundSource::setPlaybackOffset: SoundSource not created");
+                return false;
+            }
+            alSourcef(m_sourceId, AL_SEC_OFFSET, static_cast<ALfloat>(seconds));
+            if (ErrorHandler::checkOpenALError("Set Playback Offset"))
+                return false;
+
+            return true;
+        }
+
         float SoundSource::getVolume() const { return static_cast<float>(m_volume); }
 
         float SoundSource::getPitch() const { return static_cast<float>(m_pitch); }
@@ -0,0 +1,252 @@
+#include <soundcoe/resources/sound_stream.hpp>
+#include <soundcoe/resources/stream_worker.hpp>
+#include <soundcoe/core/error_handler.hpp>
+#include <logcoe.hpp>
+#include <algorithm>
+#include <exception>
+
+namespace soundcoe
+{
+    namespace detail
+    {
+        StreamDecoder::StreamDecoder(const std::string &filename, bool loop, size_t chunkSize, size_t readAhead)
+            : m_audioStream(filename), m_loop(loop), m_chunkFrames(0),
+              m_freeChunks(std::max<size_t>(readAhead, 1)), m_readyChunks(std::max<size_t>(readAhead, 1)), m_finished(false)
+        {
+            m_chunkFrames = std::max<size_t>(chunkSize / static_cast<size_t>(m_audioStream.getFrameSize()), 1);
+            size_t samples = m_chunkFrames * static_cast<size_t>(m_audioStream.getChannels());
+            for (size_t i = 0; i < std::max<size_t>(readAhead, 1); ++i)
+            {
+                auto chunk = std::make_unique<StreamChunk>();
+                chunk->m_samples.resize(samples);
+                m_freeChunks.tryPush(std::move(chunk));
+            }
+        }
+
+        void StreamDecoder::decodeChunk(StreamChunk &chunk)
+        {
+            size_t channels = static_cast<size_t>(m_audioStream.getChannels());
+            size_t framesDecoded = 0;
+            bool rewound = false;
+            chunk.m_endOfStream = false;
+            while (framesDecoded < m_chunkFrames)
+            {
+                size_t frames = m_audioStream.readFrames(chunk.m_samples.data() + (framesDecoded * channels),
+                                                         m_chunkFrames - framesDecoded);
+                framesDecoded += frames;
+                if (frames > 0)
+                {
+                    rewound = false;
+                    continue;
+                }
+
+                // A second empty read right after a rewind means the file has no audio frames at all
+                if (!m_loop || rewound || !m_audioStream.rewind())
+                {
+                    chunk.m_endOfStream = true;
+                    break;
+                }
+                rewound = true;
+            }
+
+            chunk.m_frames = framesDecoded;
+        }
+
+        size_t StreamDecoder::decodeAhead()
+        {
+            size_t decoded = 0;
+            std::unique_ptr<StreamChunk> chunk;
+            while (!m_finished.load(std::memory_order_relaxed) && m_freeChunks.tryPop(chunk))
+            {
+                decodeChunk(*chunk);
+                if (chunk->m_endOfStream)
+                    m_finished.store(true, std::memory_order_release);
+
+                // Both queues are sized for every chunk, a push cannot fail
+                m_readyChunks.tryPush(std::move(chunk));
+                ++decoded;
+            }
+            return decoded;
+        }
+
+        std::unique_ptr<StreamChunk> StreamDecoder::popChunk()
+        {
+            std::unique_ptr<StreamChunk> chunk;
+            m_readyChunks.tryPop(chunk);
+            return chunk;
+        }
+
+        void StreamDecoder::recycleChunk(std::unique_ptr<StreamChunk> chunk)
+        {
+            if (chunk)
+                m_freeChunks.tryPush(std::move(chunk));
+        }
+
+        bool StreamDecoder::isFinished() const { return m_finished.load(std::memory_order_acquire); }
+
+        bool StreamDecoder::isLooping() const { return m_loop; }
+
+        size_t StreamDecoder::getReadyChunkCount() const { return m_readyChunks.size(); }
+
+        size_t StreamDecoder::getChunkFrames() const { return m_chunkFrames; }
+
+        size_t StreamDecoder::getReadAhead() const { return m_freeChunks.capacity(); }
+
+        const AudioStream &StreamDecoder::getAudioStream() const { return m_audioStream; }
+
+        SoundStream::SoundStream(const std::string &filename, bool loop, StreamWorker *worker, size_t readAhead,
+                                 size_t bufferCount, size_t bufferSize)
+            : m_decoder(std::make_shared<StreamDecoder>(filename, loop, bufferSize, readAhead)), m_worker(worker)
+        {
+            m_bufferSize = m_decoder->getChunkFrames() * static_cast<size_t>(m_decoder->getAudioStream().getFrameSize());
+
+            m_bufferIds.resize(std::max<size_t>(bufferCount, 2));
+            alGenBuffers(static_cast<ALsizei>(m_bufferIds.size()), m_bufferIds.data());
+            ErrorHandler::throwOnOpenALError("Generate Stream Buffers");
+        }
+
+        SoundStream::~SoundStream()
+        {
+            if (m_bufferIds.empty())
+                return;
+
+            alDeleteBuffers(static_cast<ALsizei>(m_bufferIds.size()), m_bufferIds.data());
+            if (ErrorHandler::checkOpenALError("Delete Stream Buffers"))
+                logcoe::warning("SoundStream::~SoundStream: Stream buffers were still queued on a source: \"" +
+                                m_decoder->getAudioStream().getFileName() + "\"");
+        }
+
+        std::unique_ptr<StreamChunk> SoundStream::nextChunk()
+        {
+            auto chunk = m_decoder->popChunk();
+            // Without a worker (or before handing the decoder to it) this thread is the only producer
+            if (!chunk && !m_backgroundDecode)
+            {
+                m_decoder->decodeAhead();
+                chunk = m_decoder->popChunk();
+            }
+            return chunk;
+        }
+
+        size_t SoundStream::fillBuffer(ALuint bufferId)
+        {
+            auto chunk = nextChunk();
+            if (!chunk)
+                return 0;
+
+            size_t frames = chunk->m_frames;
+            if (chunk->m_endOfStream)
+                m_endOfStream = true;
+
+            if (frames > 0)
+            {
+                const AudioStream &audioStream = m_decoder->getAudioStream();
+                ALsizei size = static_cast<ALsizei>(frames * static_cast<size_t>(audioStream.getFrameSize()));
+                alBufferData(bufferId, audioStream.getOpenALFormat(), chunk->m_samples.data(), size, audioStream.getSampleRate());
+                if (ErrorHandler::checkOpenALError("Stream Buffer Data"))
+                    frames = 0;
+            }
+
+            m_decoder->recycleChunk(std::move(chunk));
+            m_bufferFrames[bufferId] = frames;
+            return frames;
+        }
+
+        bool SoundStream::start(SoundSource &source)
+        {
+            try { source.detachBuffer(); }
+            catch (const std::exception &e)
+            {
+                logcoe::warning("SoundStream::start: Failed to detach previous Buffer: " + std::string(e.what()));
+                return false;
+            }
+
+            // Prime every buffer right away so playback can start, the worker takes over from here
+            size_t queued = 0;
+            for (ALuint bufferId : m_bufferIds)
+            {
+                if (m_endOfStream || fillBuffer(bufferId) == 0)
+                {
+                    m_idleBufferIds.push_back(bufferId);
+                    continue;
+                }
+                if (!source.queueBuffers(&bufferId, 1))
+                    return false;
+                ++queued;
+            }
+
+            if (queued == 0)
+            {
+                logcoe::warning("SoundStream::start: Nothing to stream from \"" + m_decoder->getAudioStream().getFileName() + "\"");
+                return false;
+            }
+
+            if (m_worker && m_worker->isRunning() && !m_endOfStream)
+            {
+                m_backgroundDecode = true;
+                m_worker->addDecoder(m_decoder);
+            }
+            return true;
+        }
+
+        size_t SoundStream::refill(SoundSource &source)
+        {
+            ALint processed = source.getBuffersProcessed();
+            for (ALint i = 0; i < processed; ++i)
+            {
+                ALuint bufferId = 0;
+                if (!source.unqueueBuffers(&bufferId, 1))
+                    break;
+
+                m_playedFrames += m_bufferFrames[bufferId];
+                m_bufferFrames[bufferId] = 0;
+                m_idleBufferIds.push_back(bufferId);
+            }
+
+            size_t requeued = 0;
+            while (!m_idleBufferIds.empty() && !m_endOfStream)
+            {
+                ALuint bufferId = m_idleBufferIds.back();
+                size_t frames = fillBuffer(bufferId);
+                if (frames == 0)
+                {
+                    // Nothing decoded yet, keep the buffer for the next update
+                    if (!m_endOfStream)
+                        break;
+                    continue;
+                }
+
+                if (!source.queueBuffers(&bufferId, 1))
+                    break;
+                m_idleBufferIds.pop_back();
+                ++requeued;
+            }
+
+            if (requeued > 0 && m_backgroundDecode)
+                m_worker->wakeUp();
+            return requeued;
+        }
+
+        bool SoundStream::isFinished() const { return m_endOfStream; }
+
+        bool SoundStream::isLooping() const { return m_decoder->isLooping(); }
+
+        float SoundStream::getPosition() const
+        {
+            const AudioStream &audioStream = m_decoder->getAudioStream();
+            uint64_t frames = m_playedFrames;
+            uint64_t totalFrames = audioStream.getTotalFrames();
+            if (isLooping() && totalFrames > 0)
+                frames %= totalFrames;
+            return static_cast<float>(frames) / static_cast<float>(audioStream.getSampleRate());
+        }
+
+        size_t SoundStream::getBufferSize() const { return m_bufferSize; }
+
+        size_t SoundStream::getBufferCount() const { return m_bufferIds.size(); }
+
+        size_t SoundStream::getReadAhead() const { return m_decoder->getReadAhead(); }
+
+        const AudioStream &SoundStream::getAudioStream() const { return m_decoder->getAudioStream(); }
+    } // namespace detail
+} // namespace soundcoe
\ No newline at end of file
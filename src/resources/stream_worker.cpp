@@ -0,0 +1,113 @@
+#include <soundcoe/resources/stream_worker.hpp>
+#include <logcoe.hpp>
+#include <algorithm>
+#include <exception>
+
+namespace soundcoe
+{
+    namespace detail
+    {
+        StreamWorker::StreamWorker() : m_thread(), m_mutex(), m_condition(), m_decoders(), m_running(false),
+                                       m_wakeUp(false), m_pollInterval(DEFAULT_POLL_INTERVAL) { }
+
+        StreamWorker::~StreamWorker() { stop(); }
+
+        void StreamWorker::start(std::chrono::milliseconds pollInterval)
+        {
+            if (m_running)
+                return;
+
+            m_pollInterval = pollInterval;
+            m_running = true;
+            m_thread = std::thread(&StreamWorker::run, this);
+            logcoe::debug("StreamWorker::start: Stream decode thread started");
+        }
+
+        void StreamWorker::stop()
+        {
+            if (!m_running)
+                return;
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_running = false;
+            }
+            m_condition.notify_one();
+
+            if (m_thread.joinable())
+                m_thread.join();
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_decoders.clear();
+            logcoe::debug("StreamWorker::stop: Stream decode thread stopped");
+        }
+
+        bool StreamWorker::isRunning() const { return m_running; }
+
+        void StreamWorker::addDecoder(const std::shared_ptr<StreamDecoder> &decoder)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_decoders.push_back(decoder);
+                m_wakeUp.store(true, std::memory_order_release);
+            }
+            m_condition.notify_one();
+        }
+
+        void StreamWorker::wakeUp()
+        {
+            m_wakeUp.store(true, std::memory_order_release);
+            m_condition.notify_one();
+        }
+
+        size_t StreamWorker::getDecoderCount()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_decoders.size();
+        }
+
+        void StreamWorker::run()
+        {
+            std::vector<std::shared_ptr<StreamDecoder>> decoders;
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    auto wakeCondition = [this]()
+                    { return !m_running || m_wakeUp.load(std::memory_order_acquire); };
+                    // Sleep until a stream is added when idle. While streaming, a wake up missed by the lock-free
+                    // wakeUp() only costs one poll interval, the chunks already queued cover it
+                    if (m_decoders.empty())
+                        m_condition.wait(lock, wakeCondition);
+                    else
+                        m_condition.wait_for(lock, m_pollInterval, wakeCondition);
+                    if (!m_running)
+                        break;
+                    m_wakeUp.store(false, std::memory_order_relaxed);
+
+                    // Streams that stopped playing released their decoder, forget them
+                    m_decoders.erase(std::remove_if(m_decoders.begin(), m_decoders.end(),
+                                                    [](const std::weak_ptr<StreamDecoder> &decoder)
+                                                    { return decoder.expired(); }),
+                                     m_decoders.end());
+
+                    decoders.clear();
+                    for (const auto &weakDecoder : m_decoders)
+                        if (auto decoder = weakDecoder.lock())
+                            decoders.push_back(std::move(decoder));
+                }
+
+                for (auto &decoder : decoders)
+                {
+                    try { decoder->decodeAhead(); }
+                    catch (const std::exception &e)
+                    {
+                        logcoe::error("StreamWorker::run: Failed to decode \"" + decoder->getAudioStream().getFileName() +
+                                      "\": " + std::string(e.what()));
+                    }
+                }
+                decoders.clear();
+            }
+        }
+    } // namespace detail
+} // namespace soundcoe
\ No newline at end of file
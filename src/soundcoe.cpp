@@ -37,6 +37,11 @@ namespace soundcoe
         return detail::getSoundManagerInstance().preloadScene(sceneName);
     }
 
+    PreloadTicket preloadSceneAsync(const std::string &sceneName)
+    {
+        return detail::getSoundManagerInstance().preloadSceneAsync(sceneName);
+    }
+
     bool unloadScene(const std::string &sceneName)
     {
         return detail::getSoundManagerInstance().unloadScene(sceneName);
@@ -47,6 +52,141 @@ namespace soundcoe
         return detail::getSoundManagerInstance().isSceneLoaded(sceneName);
     }
 
+    bool setStreamingPolicy(const StreamingPolicy &policy)
+    {
+        return detail::getSoundManagerInstance().setStreamingPolicy(policy);
+    }
+
+    bool setStreamingPolicy(const std::string &subdirectory, const StreamingPolicy &policy)
+    {
+        return detail::getSoundManagerInstance().setStreamingPolicy(subdirectory, policy);
+    }
+
+    StreamingPolicy getStreamingPolicy(const std::string &subdirectory)
+    {
+        return detail::getSoundManagerInstance().getStreamingPolicy(subdirectory);
+    }
+
+    bool setMonoDownmix(bool enabled)
+    {
+        return detail::getSoundManagerInstance().setMonoDownmix(enabled);
+    }
+
+    bool setMonoDownmix(const std::string &subdirectory, bool enabled)
+    {
+        return detail::getSoundManagerInstance().setMonoDownmix(subdirectory, enabled);
+    }
+
+    bool isMonoDownmixEnabled(const std::string &subdirectory)
+    {
+        return detail::getSoundManagerInstance().isMonoDownmixEnabled(subdirectory);
+    }
+
+    bool setResampleOnLoad(bool enabled)
+    {
+        return detail::getSoundManagerInstance().setResampleOnLoad(enabled);
+    }
+
+    bool isResampleOnLoadEnabled()
+    {
+        return detail::getSoundManagerInstance().isResampleOnLoadEnabled();
+    }
+
+    bool setBufferCompression(BufferCompression compression)
+    {
+        return detail::getSoundManagerInstance().setBufferCompression(compression);
+    }
+
+    bool setBufferCompression(const std::string &subdirectory, BufferCompression compression)
+    {
+        return detail::getSoundManagerInstance().setBufferCompression(subdirectory, compression);
+    }
+
+    BufferCompression getBufferCompression(const std::string &subdirectory)
+    {
+        return detail::getSoundManagerInstance().getBufferCompression(subdirectory);
+    }
+
+    bool setCompressedCaching(bool enabled)
+    {
+        return detail::getSoundManagerInstance().setCompressedCaching(enabled);
+    }
+
+    bool setCompressedCaching(const std::string &subdirectory, bool enabled)
+    {
+        return detail::getSoundManagerInstance().setCompressedCaching(subdirectory, enabled);
+    }
+
+    bool isCompressedCachingEnabled(const std::string &subdirectory)
+    {
+        return detail::getSoundManagerInstance().isCompressedCachingEnabled(subdirectory);
+    }
+
+    bool setCompressedCacheLimits(size_t compressedMB, size_t decodedMB)
+    {
+        return detail::getSoundManagerInstance().setCompressedCacheLimits(compressedMB, decodedMB);
+    }
+
+    bool setStreamReadAhead(size_t chunks)
+    {
+        return detail::getSoundManagerInstance().setStreamReadAhead(chunks);
+    }
+
+    size_t getStreamReadAhead()
+    {
+        return detail::getSoundManagerInstance().getStreamReadAhead();
+    }
+
+    size_t getStreamUnderrunCount()
+    {
+        return detail::getSoundManagerInstance().getStreamUnderrunCount();
+    }
+
+    bool setDecodeThreadCount(size_t threadCount)
+    {
+        return detail::getSoundManagerInstance().setDecodeThreadCount(threadCount);
+    }
+
+    size_t getDecodeThreadCount()
+    {
+        return detail::getSoundManagerInstance().getDecodeThreadCount();
+    }
+
+    bool setMaxVirtualVoices(size_t count)
+    {
+        return detail::getSoundManagerInstance().setMaxVirtualVoices(count);
+    }
+
+    size_t getMaxVirtualVoices()
+    {
+        return detail::getSoundManagerInstance().getMaxVirtualVoices();
+    }
+
+    size_t getVirtualVoiceCount()
+    {
+        return detail::getSoundManagerInstance().getVirtualVoiceCount();
+    }
+
+    bool setAudibilityThreshold(float gain)
+    {
+        return detail::getSoundManagerInstance().setAudibilityThreshold(gain);
+    }
+
+    float getAudibilityThreshold()
+    {
+        return detail::getSoundManagerInstance().getAudibilityThreshold();
+    }
+
+    bool setCommandQueueEnabled(bool enabled)
+    {
+        return detail::getSoundManagerInstance().setCommandQueueEnabled(enabled);
+    }
+
+    bool isCommandQueueEnabled()
+    {
+        return detail::getSoundManagerInstance().isCommandQueueEnabled();
+    }
+
     void update()
     {
         detail::getSoundManagerInstance().update();
@@ -60,9 +200,28 @@ namespace soundcoe
 
     SoundHandle playSound3D(const std::string &filename, const Vec3 &position, const Vec3 &velocity,
                             float volume, float pitch, bool loop,
-                            SoundPriority priority)
+                            SoundPriority priority, float maxDistance)
+    {
+        return detail::getSoundManagerInstance().playSound3D(filename, position, velocity, volume, pitch, loop, priority,
+                                                             maxDistance);
+    }
+
+    SoundId registerSound(const std::string &filename)
+    {
+        return detail::getSoundManagerInstance().registerSound(filename);
+    }
+
+    SoundHandle playSound(SoundId id, float volume, float pitch, bool loop, SoundPriority priority)
     {
-        return detail::getSoundManagerInstance().playSound3D(filename, position, velocity, volume, pitch, loop, priority);
+        return detail::getSoundManagerInstance().playSound(id, volume, pitch, loop, priority);
+    }
+
+    SoundHandle playSound3D(SoundId id, const Vec3 &position, const Vec3 &velocity,
+                            float volume, float pitch, bool loop,
+                            SoundPriority priority, float maxDistance)
+    {
+        return detail::getSoundManagerInstance().playSound3D(id, position, velocity, volume, pitch, loop, priority,
+                                                             maxDistance);
     }
 
     MusicHandle playMusic(const std::string &filename, float volume, float pitch, bool loop,
@@ -215,6 +374,21 @@ namespace soundcoe
         return detail::getSoundManagerInstance().isMusicStopped(handle);
     }
 
+    std::vector<SoundHandle> playSounds(const std::vector<PlayRequest> &requests)
+    {
+        return detail::getSoundManagerInstance().playSounds(requests);
+    }
+
+    bool setSoundPositions(const std::vector<std::pair<SoundHandle, Vec3>> &positions)
+    {
+        return detail::getSoundManagerInstance().setSoundPositions(positions);
+    }
+
+    std::vector<SoundState> getSoundStates(const std::vector<SoundHandle> &handles)
+    {
+        return detail::getSoundManagerInstance().getSoundStates(handles);
+    }
+
     size_t getActiveSoundsCount()
     {
         return detail::getSoundManagerInstance().getActiveSoundsCount();
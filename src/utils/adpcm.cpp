@@ -0,0 +1,310 @@
+#include <soundcoe/utils/adpcm.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+namespace soundcoe
+{
+    namespace detail
+    {
+        namespace adpcm
+        {
+            static constexpr int IMA_STEP_TABLE[89] = {
+                7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80,
+                88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598,
+                658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+                3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289,
+                16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767};
+            static constexpr int IMA_INDEX_TABLE[16] = {-1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8};
+
+            static constexpr int MSADPCM_COEFFICIENTS[7][2] = {
+                {256, 0}, {512, -256}, {0, 0}, {192, 64}, {240, 0}, {460, -208}, {392, -232}};
+            static constexpr int MSADPCM_ADAPTATION[16] = {
+                230, 230, 230, 230, 307, 409, 512, 614, 768, 614, 512, 409, 307, 230, 230, 230};
+            static constexpr size_t MSADPCM_HEADER_SIZE = 7;
+
+            static int clampSample(int value) { return std::min(std::max(value, -32768), 32767); }
+
+            static void writeS16(uint8_t *output, int value)
+            {
+                output[0] = static_cast<uint8_t>(value & 0xFF);
+                output[1] = static_cast<uint8_t>((value >> 8) & 0xFF);
+            }
+
+            static int readS16(const uint8_t *input) { return static_cast<int16_t>(input[0] | (input[1] << 8)); }
+
+            size_t getBlockCount(size_t frameCount, size_t framesPerBlock)
+            {
+                return std::max<size_t>(1, (frameCount + framesPerBlock - 1) / framesPerBlock);
+            }
+
+            // 4 header bytes and 32 bytes of nibbles for 64 frames after the one stored in the header
+            size_t getIma4BlockSize(size_t channels) { return 36 * channels; }
+
+            size_t getMsAdpcmBlockSize(size_t channels)
+            {
+                return (MSADPCM_HEADER_SIZE + (MSADPCM_FRAMES_PER_BLOCK - 2) / 2) * channels;
+            }
+
+            // Copies one block of frames, padding past the end of the input with silence
+            static void gatherBlock(const int16_t *input, size_t frameCount, size_t channels, size_t firstFrame,
+                                    size_t framesPerBlock, std::vector<int> &block)
+            {
+                block.assign(framesPerBlock * channels, 0);
+                size_t available = std::min(framesPerBlock, frameCount - std::min(frameCount, firstFrame));
+                for (size_t i = 0; i < available * channels; ++i)
+                    block[i] = input[firstFrame * channels + i];
+            }
+
+            static int decodeImaNibble(int nibble, int &predictor, int &index)
+            {
+                int step = IMA_STEP_TABLE[index];
+                int diff = step >> 3;
+                if (nibble & 4)
+                    diff += step;
+                if (nibble & 2)
+                    diff += step >> 1;
+                if (nibble & 1)
+                    diff += step >> 2;
+
+                predictor = clampSample(nibble & 8 ? predictor - diff : predictor + diff);
+                index = std::min(std::max(index + IMA_INDEX_TABLE[nibble], 0), 88);
+                return predictor;
+            }
+
+            static int encodeImaNibble(int sample, int &predictor, int &index)
+            {
+                int step = IMA_STEP_TABLE[index];
+                int diff = sample - predictor;
+                int nibble = 0;
+                if (diff < 0)
+                {
+                    nibble = 8;
+                    diff = -diff;
+                }
+                if (diff >= step)
+                {
+                    nibble |= 4;
+                    diff -= step;
+                }
+                step >>= 1;
+                if (diff >= step)
+                {
+                    nibble |= 2;
+                    diff -= step;
+                }
+                step >>= 1;
+                if (diff >= step)
+                    nibble |= 1;
+
+                // Track the decoder's reconstruction so rounding errors do not accumulate
+                decodeImaNibble(nibble, predictor, index);
+                return nibble;
+            }
+
+            void encodeIma4(const int16_t *input, uint8_t *output, size_t frameCount, size_t channels)
+            {
+                size_t blockCount = getBlockCount(frameCount, IMA4_FRAMES_PER_BLOCK);
+                size_t blockSize = getIma4BlockSize(channels);
+                std::vector<int> indices(channels, 0);
+                std::vector<int> block;
+                for (size_t b = 0; b < blockCount; ++b)
+                {
+                    gatherBlock(input, frameCount, channels, b * IMA4_FRAMES_PER_BLOCK, IMA4_FRAMES_PER_BLOCK, block);
+                    uint8_t *out = output + b * blockSize;
+                    for (size_t c = 0; c < channels; ++c)
+                    {
+                        // The header holds the first frame exactly, the step index carries over between blocks
+                        int predictor = block[c];
+                        int &index = indices[c];
+                        writeS16(out + c * 4, predictor);
+                        out[c * 4 + 2] = static_cast<uint8_t>(index);
+                        out[c * 4 + 3] = 0;
+
+                        // Groups of 8 frames, 4 bytes per channel, low nibble first
+                        for (size_t group = 0; group < 8; ++group)
+                        {
+                            uint8_t *bytes = out + channels * 4 + (group * channels + c) * 4;
+                            for (size_t k = 0; k < 4; ++k)
+                            {
+                                size_t frame = 1 + group * 8 + k * 2;
+                                int low = encodeImaNibble(block[frame * channels + c], predictor, index);
+                                int high = encodeImaNibble(block[(frame + 1) * channels + c], predictor, index);
+                                bytes[k] = static_cast<uint8_t>(low | (high << 4));
+                            }
+                        }
+                    }
+                }
+            }
+
+            void decodeIma4(const uint8_t *input, int16_t *output, size_t blockCount, size_t channels)
+            {
+                size_t blockSize = getIma4BlockSize(channels);
+                for (size_t b = 0; b < blockCount; ++b)
+                {
+                    const uint8_t *in = input + b * blockSize;
+                    int16_t *out = output + b * IMA4_FRAMES_PER_BLOCK * channels;
+                    for (size_t c = 0; c < channels; ++c)
+                    {
+                        int predictor = readS16(in + c * 4);
+                        int index = std::min<int>(in[c * 4 + 2], 88);
+                        out[c] = static_cast<int16_t>(predictor);
+
+                        for (size_t group = 0; group < 8; ++group)
+                        {
+                            const uint8_t *bytes = in + channels * 4 + (group * channels + c) * 4;
+                            for (size_t k = 0; k < 4; ++k)
+                            {
+                                size_t frame = 1 + group * 8 + k * 2;
+                                out[frame * channels + c] = static_cast<int16_t>(decodeImaNibble(bytes[k] & 0x0F, predictor, index));
+                                out[(frame + 1) * channels + c] = static_cast<int16_t>(decodeImaNibble(bytes[k] >> 4, predictor, index));
+                            }
+                        }
+                    }
+                }
+            }
+
+            struct MsAdpcmChannelState
+            {
+                int m_predictor = 0;
+                int m_delta = 16;
+                int m_sample1 = 0;
+                int m_sample2 = 0;
+            };
+
+            static int decodeMsAdpcmNibble(int nibble, MsAdpcmChannelState &state)
+            {
+                const int *coefficients = MSADPCM_COEFFICIENTS[state.m_predictor];
+                int signedNibble = nibble >= 8 ? nibble - 16 : nibble;
+                int predicted = (state.m_sample1 * coefficients[0] + state.m_sample2 * coefficients[1]) / 256;
+                int sample = clampSample(predicted + signedNibble * state.m_delta);
+
+                state.m_sample2 = state.m_sample1;
+                state.m_sample1 = sample;
+                state.m_delta = std::max(16, (MSADPCM_ADAPTATION[nibble] * state.m_delta) / 256);
+                return sample;
+            }
+
+            static int encodeMsAdpcmNibble(int sample, MsAdpcmChannelState &state)
+            {
+                const int *coefficients = MSADPCM_COEFFICIENTS[state.m_predictor];
+                int predicted = (state.m_sample1 * coefficients[0] + state.m_sample2 * coefficients[1]) / 256;
+                int error = sample - predicted;
+                int quantized = error >= 0 ? (error + state.m_delta / 2) / state.m_delta
+                                           : -((state.m_delta / 2 - error) / state.m_delta);
+                int nibble = std::min(std::max(quantized, -8), 7) & 0x0F;
+
+                decodeMsAdpcmNibble(nibble, state);
+                return nibble;
+            }
+
+            // Encodes one channel of a block with the given predictor, returning the squared error
+            static int64_t encodeMsAdpcmChannel(const std::vector<int> &block, size_t channels, size_t channel,
+                                                int predictor, MsAdpcmChannelState &header, uint8_t *nibbles)
+            {
+                const int *coefficients = MSADPCM_COEFFICIENTS[predictor];
+                int sample2 = block[channel];
+                int sample1 = block[channels + channel];
+
+                // Start the step size from the residuals of the first few frames so the block does not open with a
+                // burst of clipped nibbles
+                int64_t residual = 0;
+                for (size_t frame = 2; frame < 6; ++frame)
+                {
+                    int predicted = (block[(frame - 1) * channels + channel] * coefficients[0] +
+                                     block[(frame - 2) * channels + channel] * coefficients[1]) / 256;
+                    residual += std::abs(block[frame * channels + channel] - predicted);
+                }
+
+                header.m_predictor = predictor;
+                header.m_delta = static_cast<int>(std::min<int64_t>(std::max<int64_t>(residual / 8, 16), 32767));
+                header.m_sample1 = sample1;
+                header.m_sample2 = sample2;
+
+                MsAdpcmChannelState state = header;
+                int64_t squaredError = 0;
+                for (size_t frame = 2; frame < MSADPCM_FRAMES_PER_BLOCK; ++frame)
+                {
+                    int sample = block[frame * channels + channel];
+                    nibbles[frame - 2] = static_cast<uint8_t>(encodeMsAdpcmNibble(sample, state));
+                    int64_t error = sample - state.m_sample1;
+                    squaredError += error * error;
+                }
+                return squaredError;
+            }
+
+            void encodeMsAdpcm(const int16_t *input, uint8_t *output, size_t frameCount, size_t channels)
+            {
+                constexpr size_t nibbleCount = MSADPCM_FRAMES_PER_BLOCK - 2;
+                size_t blockCount = getBlockCount(frameCount, MSADPCM_FRAMES_PER_BLOCK);
+                size_t blockSize = getMsAdpcmBlockSize(channels);
+                std::vector<int> block;
+                std::vector<uint8_t> nibbles(nibbleCount * channels);
+                uint8_t trial[nibbleCount];
+                for (size_t b = 0; b < blockCount; ++b)
+                {
+                    gatherBlock(input, frameCount, channels, b * MSADPCM_FRAMES_PER_BLOCK, MSADPCM_FRAMES_PER_BLOCK, block);
+                    uint8_t *out = output + b * blockSize;
+                    for (size_t c = 0; c < channels; ++c)
+                    {
+                        // Every predictor is tried, the block keeps whichever reconstructs the channel best
+                        MsAdpcmChannelState best;
+                        int64_t bestError = std::numeric_limits<int64_t>::max();
+                        for (int predictor = 0; predictor < 7; ++predictor)
+                        {
+                            MsAdpcmChannelState header;
+                            int64_t error = encodeMsAdpcmChannel(block, channels, c, predictor, header, trial);
+                            if (error < bestError)
+                            {
+                                bestError = error;
+                                best = header;
+                                for (size_t i = 0; i < nibbleCount; ++i)
+                                    nibbles[i * channels + c] = trial[i];
+                            }
+                        }
+
+                        out[c] = static_cast<uint8_t>(best.m_predictor);
+                        writeS16(out + channels + c * 2, best.m_delta);
+                        writeS16(out + channels * 3 + c * 2, best.m_sample1);
+                        writeS16(out + channels * 5 + c * 2, best.m_sample2);
+                    }
+
+                    // Nibbles interleave across channels, high nibble first
+                    uint8_t *bytes = out + MSADPCM_HEADER_SIZE * channels;
+                    for (size_t i = 0; i < nibbles.size(); i += 2)
+                        bytes[i / 2] = static_cast<uint8_t>((nibbles[i] << 4) | nibbles[i + 1]);
+                }
+            }
+
+            void decodeMsAdpcm(const uint8_t *input, int16_t *output, size_t blockCount, size_t channels)
+            {
+                size_t blockSize = getMsAdpcmBlockSize(channels);
+                std::vector<MsAdpcmChannelState> states(channels);
+                for (size_t b = 0; b < blockCount; ++b)
+                {
+                    const uint8_t *in = input + b * blockSize;
+                    int16_t *out = output + b * MSADPCM_FRAMES_PER_BLOCK * channels;
+                    for (size_t c = 0; c < channels; ++c)
+                    {
+                        MsAdpcmChannelState &state = states[c];
+                        state.m_predictor = std::min<int>(in[c], 6);
+                        state.m_delta = readS16(in + channels + c * 2);
+                        state.m_sample1 = readS16(in + channels * 3 + c * 2);
+                        state.m_sample2 = readS16(in + channels * 5 + c * 2);
+                        out[c] = static_cast<int16_t>(state.m_sample2);
+                        out[channels + c] = static_cast<int16_t>(state.m_sample1);
+                    }
+
+                    const uint8_t *bytes = in + MSADPCM_HEADER_SIZE * channels;
+                    size_t nibbleCount = (MSADPCM_FRAMES_PER_BLOCK - 2) * channels;
+                    for (size_t i = 0; i < nibbleCount; ++i)
+                    {
+                        int nibble = i % 2 == 0 ? bytes[i / 2] >> 4 : bytes[i / 2] & 0x0F;
+                        out[2 * channels + i] = static_cast<int16_t>(decodeMsAdpcmNibble(nibble, states[i % channels]));
+                    }
+                }
+            }
+        } // namespace adpcm
+    } // namespace detail
+} // namespace soundcoe
\ No newline at end of file
@@ -0,0 +1,211 @@
+#include <soundcoe/utils/mapped_file.hpp>
+#include <logcoe.hpp>
+#include <fstream>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif !defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace soundcoe
+{
+    namespace detail
+    {
+        MappedFile::MappedFile(const std::string &filename) { open(filename); }
+
+        MappedFile::MappedFile(MappedFile &&other) noexcept : m_data(other.m_data), m_size(other.m_size), m_mapped(other.m_mapped),
+                                                              m_fallbackData(std::move(other.m_fallbackData)),
+                                                              m_filename(std::move(other.m_filename))
+        {
+#ifdef _WIN32
+            m_fileHandle = other.m_fileHandle;
+            m_mappingHandle = other.m_mappingHandle;
+            other.m_fileHandle = nullptr;
+            other.m_mappingHandle = nullptr;
+#endif
+            if (!m_mapped)
+                m_data = m_fallbackData.data();
+            other.m_data = nullptr;
+            other.m_size = 0;
+            other.m_mapped = false;
+        }
+
+        MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+        {
+            if (this == &other)
+                return *this;
+
+            close();
+
+            m_data = other.m_data;
+            m_size = other.m_size;
+            m_mapped = other.m_mapped;
+            m_fallbackData = std::move(other.m_fallbackData);
+            m_filename = std::move(other.m_filename);
+#ifdef _WIN32
+            m_fileHandle = other.m_fileHandle;
+            m_mappingHandle = other.m_mappingHandle;
+            other.m_fileHandle = nullptr;
+            other.m_mappingHandle = nullptr;
+#endif
+            if (!m_mapped)
+                m_data = m_fallbackData.data();
+            other.m_data = nullptr;
+            other.m_size = 0;
+            other.m_mapped = false;
+            return *this;
+        }
+
+        MappedFile::~MappedFile() { close(); }
+
+        bool MappedFile::map(const std::string &filename)
+        {
+#if defined(_WIN32)
+            HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                      FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+                return false;
+
+            LARGE_INTEGER fileSize;
+            if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+            {
+                CloseHandle(file);
+                return false;
+            }
+
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!mapping)
+            {
+                CloseHandle(file);
+                return false;
+            }
+
+            void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (!view)
+            {
+                CloseHandle(mapping);
+                CloseHandle(file);
+                return false;
+            }
+
+            m_fileHandle = file;
+            m_mappingHandle = mapping;
+            m_data = static_cast<const uint8_t *>(view);
+            m_size = static_cast<size_t>(fileSize.QuadPart);
+            m_mapped = true;
+            return true;
+#elif !defined(__EMSCRIPTEN__)
+            int fd = ::open(filename.c_str(), O_RDONLY);
+            if (fd < 0)
+                return false;
+
+            struct stat fileStat;
+            if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0)
+            {
+                ::close(fd);
+                return false;
+            }
+
+            size_t size = static_cast<size_t>(fileStat.st_size);
+            void *view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            // The mapping keeps its own reference to the file
+            ::close(fd);
+            if (view == MAP_FAILED)
+                return false;
+
+            // Audio files are decoded front to back
+            madvise(view, size, MADV_SEQUENTIAL);
+
+            m_data = static_cast<const uint8_t *>(view);
+            m_size = size;
+            m_mapped = true;
+            return true;
+#else
+            (void)filename;
+            return false;
+#endif
+        }
+
+        bool MappedFile::read(const std::string &filename)
+        {
+            std::ifstream file(filename, std::ios::binary | std::ios::ate);
+            if (!file)
+                return false;
+
+            std::streamsize size = file.tellg();
+            if (size <= 0)
+                return false;
+
+            m_fallbackData.resize(static_cast<size_t>(size));
+            file.seekg(0, std::ios::beg);
+            if (!file.read(reinterpret_cast<char *>(m_fallbackData.data()), size))
+            {
+                m_fallbackData.clear();
+                return false;
+            }
+
+            m_data = m_fallbackData.data();
+            m_size = m_fallbackData.size();
+            m_mapped = false;
+            return true;
+        }
+
+        bool MappedFile::open(const std::string &filename)
+        {
+            close();
+
+            if (!map(filename) && !read(filename))
+            {
+                logcoe::warning("MappedFile::open: Failed to open \"" + filename + "\"");
+                return false;
+            }
+
+            m_filename = filename;
+            return true;
+        }
+
+        void MappedFile::close()
+        {
+            if (m_mapped && m_data)
+            {
+#if defined(_WIN32)
+                UnmapViewOfFile(m_data);
+                CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+                CloseHandle(static_cast<HANDLE>(m_fileHandle));
+                m_mappingHandle = nullptr;
+                m_fileHandle = nullptr;
+#elif !defined(__EMSCRIPTEN__)
+                munmap(const_cast<uint8_t *>(m_data), m_size);
+#endif
+            }
+
+            m_fallbackData.clear();
+            m_fallbackData.shrink_to_fit();
+            m_data = nullptr;
+            m_size = 0;
+            m_mapped = false;
+            m_filename.clear();
+        }
+
+        bool MappedFile::isOpen() const { return m_data != nullptr; }
+
+        bool MappedFile::isMapped() const { return m_mapped; }
+
+        const uint8_t *MappedFile::data() const { return m_data; }
+
+        size_t MappedFile::size() const { return m_size; }
+
+        const std::string &MappedFile::getFileName() const { return m_filename; }
+    } // namespace detail
+} // namespace soundcoe
\ No newline at end of file
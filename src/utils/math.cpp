@@ -112,6 +112,14 @@ namespace soundcoe
             return powf(volumeRatio, rolloffFactor);
         }
 
+        float calculateInverseDistanceGain(float distance, float referenceDistance, float rolloffFactor)
+        {
+            // OpenAL's default AL_INVERSE_DISTANCE_CLAMPED model, without a maximum distance
+            if(referenceDistance <= 0.0f) return 1.0f;
+            distance = fmaxf(fabsf(distance), referenceDistance);
+            return referenceDistance / (referenceDistance + rolloffFactor * (distance - referenceDistance));
+        }
+
         float calculatePan(const Vec3 &listenerPosition, const Vec3 &sourcePosition, const Vec3 &listenerForward)
         {
             Vec3 direction = sourcePosition - listenerPosition;
@@ -0,0 +1,340 @@
+#include <soundcoe/utils/pcm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SOUNDCOE_PCM_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SOUNDCOE_PCM_NEON
+#include <arm_neon.h>
+#endif
+
+namespace soundcoe
+{
+    namespace detail
+    {
+        namespace pcm
+        {
+            void convertFloatToS16(const float *input, int16_t *output, size_t sampleCount)
+            {
+                // Samples are clamped before scaling: a converted value past the int32 range would come out of the
+                // vector paths as INT_MIN. NaN clamps to the negative limit on every path.
+                const float maxSample = 32767.0f / 32768.0f;
+                size_t i = 0;
+                // Every block is loaded before anything is stored, which keeps in place conversion safe
+#if defined(__AVX2__)
+                const __m256 scale256 = _mm256_set1_ps(32768.0f);
+                const __m256 min256 = _mm256_set1_ps(-1.0f);
+                const __m256 max256 = _mm256_set1_ps(maxSample);
+                for (; i + 16 <= sampleCount; i += 16)
+                {
+                    // max_ps returns its second operand for NaN
+                    __m256 lowSamples = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(input + i), min256), max256);
+                    __m256 highSamples = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(input + i + 8), min256), max256);
+                    __m256i low = _mm256_cvtps_epi32(_mm256_mul_ps(lowSamples, scale256));
+                    __m256i high = _mm256_cvtps_epi32(_mm256_mul_ps(highSamples, scale256));
+                    // packs works per 128-bit lane, put the quads back in order
+                    __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(low, high), 0xD8);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(output + i), packed);
+                }
+#endif
+#if defined(SOUNDCOE_PCM_SSE2)
+                const __m128 scale = _mm_set1_ps(32768.0f);
+                const __m128 minValue = _mm_set1_ps(-1.0f);
+                const __m128 maxValue = _mm_set1_ps(maxSample);
+                for (; i + 8 <= sampleCount; i += 8)
+                {
+                    __m128 lowSamples = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(input + i), minValue), maxValue);
+                    __m128 highSamples = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(input + i + 4), minValue), maxValue);
+                    __m128i low = _mm_cvtps_epi32(_mm_mul_ps(lowSamples, scale));
+                    __m128i high = _mm_cvtps_epi32(_mm_mul_ps(highSamples, scale));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(output + i), _mm_packs_epi32(low, high));
+                }
+#elif defined(SOUNDCOE_PCM_NEON) && defined(__aarch64__)
+                const float32x4_t minValue = vdupq_n_f32(-1.0f);
+                const float32x4_t maxValue = vdupq_n_f32(maxSample);
+                for (; i + 8 <= sampleCount; i += 8)
+                {
+                    // maxnm returns the number when the other operand is NaN
+                    float32x4_t lowSamples = vminq_f32(vmaxnmq_f32(vld1q_f32(input + i), minValue), maxValue);
+                    float32x4_t highSamples = vminq_f32(vmaxnmq_f32(vld1q_f32(input + i + 4), minValue), maxValue);
+                    int32x4_t low = vcvtnq_s32_f32(vmulq_n_f32(lowSamples, 32768.0f));
+                    int32x4_t high = vcvtnq_s32_f32(vmulq_n_f32(highSamples, 32768.0f));
+                    vst1q_s16(output + i, vcombine_s16(vqmovn_s32(low), vqmovn_s32(high)));
+                }
+#endif
+                for (; i < sampleCount; ++i)
+                {
+                    float sample = input[i] >= -1.0f ? std::min(input[i], maxSample) : -1.0f;
+                    output[i] = static_cast<int16_t>(std::nearbyint(sample * 32768.0f));
+                }
+            }
+
+            void convertS32ToS16(const int32_t *input, int16_t *output, size_t sampleCount)
+            {
+                size_t i = 0;
+#if defined(__AVX2__)
+                for (; i + 16 <= sampleCount; i += 16)
+                {
+                    __m256i low = _mm256_srai_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(input + i)), 16);
+                    __m256i high = _mm256_srai_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(input + i + 8)), 16);
+                    __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(low, high), 0xD8);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(output + i), packed);
+                }
+#endif
+#if defined(SOUNDCOE_PCM_SSE2)
+                for (; i + 8 <= sampleCount; i += 8)
+                {
+                    __m128i low = _mm_srai_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(input + i)), 16);
+                    __m128i high = _mm_srai_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(input + i + 4)), 16);
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(output + i), _mm_packs_epi32(low, high));
+                }
+#elif defined(SOUNDCOE_PCM_NEON)
+                for (; i + 8 <= sampleCount; i += 8)
+                {
+                    int16x4_t low = vshrn_n_s32(vld1q_s32(input + i), 16);
+                    int16x4_t high = vshrn_n_s32(vld1q_s32(input + i + 4), 16);
+                    vst1q_s16(output + i, vcombine_s16(low, high));
+                }
+#endif
+                for (; i < sampleCount; ++i)
+                    output[i] = static_cast<int16_t>(input[i] >> 16);
+            }
+
+            void downmixStereoToMono(const int16_t *input, int16_t *output, size_t frameCount)
+            {
+                size_t i = 0;
+#if defined(__AVX2__)
+                const __m256i ones256 = _mm256_set1_epi16(1);
+                for (; i + 16 <= frameCount; i += 16)
+                {
+                    // madd sums each left/right pair into one 32-bit lane
+                    __m256i low = _mm256_madd_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(input + 2 * i)), ones256);
+                    __m256i high = _mm256_madd_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(input + 2 * i + 16)), ones256);
+                    __m256i packed = _mm256_packs_epi32(_mm256_srai_epi32(low, 1), _mm256_srai_epi32(high, 1));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(output + i), _mm256_permute4x64_epi64(packed, 0xD8));
+                }
+#endif
+#if defined(SOUNDCOE_PCM_SSE2)
+                const __m128i ones = _mm_set1_epi16(1);
+                for (; i + 8 <= frameCount; i += 8)
+                {
+                    __m128i low = _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(input + 2 * i)), ones);
+                    __m128i high = _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(input + 2 * i + 8)), ones);
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(output + i),
+                                     _mm_packs_epi32(_mm_srai_epi32(low, 1), _mm_srai_epi32(high, 1)));
+                }
+#elif defined(SOUNDCOE_PCM_NEON)
+                for (; i + 8 <= frameCount; i += 8)
+                {
+                    int16x8x2_t frames = vld2q_s16(input + 2 * i);
+                    vst1q_s16(output + i, vhaddq_s16(frames.val[0], frames.val[1]));
+                }
+#endif
+                for (; i < frameCount; ++i)
+                    output[i] = static_cast<int16_t>((static_cast<int32_t>(input[2 * i]) + input[2 * i + 1]) >> 1);
+            }
+
+            void downmixStereoToMono(const float *input, float *output, size_t frameCount)
+            {
+                size_t i = 0;
+#if defined(__AVX2__)
+                const __m256 half256 = _mm256_set1_ps(0.5f);
+                for (; i + 8 <= frameCount; i += 8)
+                {
+                    __m256 first = _mm256_loadu_ps(input + 2 * i);
+                    __m256 second = _mm256_loadu_ps(input + 2 * i + 8);
+                    __m256 left = _mm256_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0));
+                    __m256 right = _mm256_shuffle_ps(first, second, _MM_SHUFFLE(3, 1, 3, 1));
+                    __m256 mono = _mm256_mul_ps(_mm256_add_ps(left, right), half256);
+                    // shuffle works per 128-bit lane, put the pairs back in order
+                    mono = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(mono), 0xD8));
+                    _mm256_storeu_ps(output + i, mono);
+                }
+#endif
+#if defined(SOUNDCOE_PCM_SSE2)
+                const __m128 half = _mm_set1_ps(0.5f);
+                for (; i + 4 <= frameCount; i += 4)
+                {
+                    __m128 first = _mm_loadu_ps(input + 2 * i);
+                    __m128 second = _mm_loadu_ps(input + 2 * i + 4);
+                    __m128 left = _mm_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0));
+                    __m128 right = _mm_shuffle_ps(first, second, _MM_SHUFFLE(3, 1, 3, 1));
+                    _mm_storeu_ps(output + i, _mm_mul_ps(_mm_add_ps(left, right), half));
+                }
+#elif defined(SOUNDCOE_PCM_NEON)
+                for (; i + 4 <= frameCount; i += 4)
+                {
+                    float32x4x2_t frames = vld2q_f32(input + 2 * i);
+                    vst1q_f32(output + i, vmulq_n_f32(vaddq_f32(frames.val[0], frames.val[1]), 0.5f));
+                }
+#endif
+                for (; i < frameCount; ++i)
+                    output[i] = (input[2 * i] + input[2 * i + 1]) * 0.5f;
+            }
+
+            // Coefficient table of a Kaiser windowed sinc low-pass, one row per fractional position
+            struct PolyphaseFilter
+            {
+                static constexpr size_t MAX_PHASES = 512;
+                static constexpr int ZERO_CROSSINGS = 16;
+                static constexpr double KAISER_BETA = 8.0;
+                static constexpr double PI = 3.14159265358979323846;
+
+                size_t m_upFactor = 1;   // output steps per common period
+                size_t m_downFactor = 1; // input steps per common period
+                size_t m_phaseCount = 1;
+                size_t m_halfTaps = 0;
+                size_t m_tapCount = 0;   // padded to a multiple of 8 for the vector loops
+                std::vector<float> m_coefficients;
+
+                PolyphaseFilter(int inputRate, int outputRate)
+                {
+                    size_t divisor = std::gcd(static_cast<size_t>(inputRate), static_cast<size_t>(outputRate));
+                    m_upFactor = static_cast<size_t>(outputRate) / divisor;
+                    m_downFactor = static_cast<size_t>(inputRate) / divisor;
+                    // Unusual rate pairs get the nearest of MAX_PHASES positions instead of an exact one
+                    m_phaseCount = std::min(m_upFactor, MAX_PHASES);
+
+                    // Downsampling lowers the cutoff below the output Nyquist and widens the filter to match
+                    double ratio = std::min(1.0, static_cast<double>(outputRate) / inputRate);
+                    double cutoff = 0.5 * ratio * 0.95;
+                    m_halfTaps = static_cast<size_t>(std::ceil(ZERO_CROSSINGS / ratio));
+                    m_tapCount = (2 * m_halfTaps + 7) & ~static_cast<size_t>(7);
+                    m_coefficients.assign(m_phaseCount * m_tapCount, 0.0f);
+
+                    double besselBeta = besselI0(KAISER_BETA);
+                    for (size_t phase = 0; phase < m_phaseCount; ++phase)
+                    {
+                        float *row = &m_coefficients[phase * m_tapCount];
+                        double fraction = static_cast<double>(phase) / m_phaseCount;
+                        double sum = 0.0;
+                        for (size_t tap = 0; tap < 2 * m_halfTaps; ++tap)
+                        {
+                            // Distance between this input sample and the output position
+                            double t = static_cast<double>(tap) - static_cast<double>(m_halfTaps - 1) - fraction;
+                            double window = t / m_halfTaps;
+                            if (window <= -1.0 || window >= 1.0)
+                                continue;
+
+                            double x = 2.0 * cutoff * t;
+                            double sinc = std::abs(x) < 1e-9 ? 1.0 : std::sin(PI * x) / (PI * x);
+                            double value = 2.0 * cutoff * sinc * besselI0(KAISER_BETA * std::sqrt(1.0 - window * window)) / besselBeta;
+                            row[tap] = static_cast<float>(value);
+                            sum += value;
+                        }
+
+                        // Unity gain at DC for every phase
+                        for (size_t tap = 0; tap < m_tapCount && sum != 0.0; ++tap)
+                            row[tap] = static_cast<float>(row[tap] / sum);
+                    }
+                }
+
+                static double besselI0(double x)
+                {
+                    double sum = 1.0, term = 1.0;
+                    for (int k = 1; k < 50 && term > 1e-12 * sum; ++k)
+                    {
+                        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+                        sum += term;
+                    }
+                    return sum;
+                }
+
+                static float dot(const float *samples, const float *coefficients, size_t count)
+                {
+                    size_t i = 0;
+                    float result = 0.0f;
+#if defined(__AVX2__)
+                    __m256 sum256 = _mm256_setzero_ps();
+                    for (; i + 8 <= count; i += 8)
+                        sum256 = _mm256_add_ps(sum256, _mm256_mul_ps(_mm256_loadu_ps(samples + i), _mm256_loadu_ps(coefficients + i)));
+                    __m128 folded = _mm_add_ps(_mm256_castps256_ps128(sum256), _mm256_extractf128_ps(sum256, 1));
+                    folded = _mm_add_ps(folded, _mm_movehl_ps(folded, folded));
+                    folded = _mm_add_ss(folded, _mm_shuffle_ps(folded, folded, 1));
+                    result = _mm_cvtss_f32(folded);
+#elif defined(SOUNDCOE_PCM_SSE2)
+                    __m128 sumLow = _mm_setzero_ps();
+                    __m128 sumHigh = _mm_setzero_ps();
+                    for (; i + 8 <= count; i += 8)
+                    {
+                        sumLow = _mm_add_ps(sumLow, _mm_mul_ps(_mm_loadu_ps(samples + i), _mm_loadu_ps(coefficients + i)));
+                        sumHigh = _mm_add_ps(sumHigh, _mm_mul_ps(_mm_loadu_ps(samples + i + 4), _mm_loadu_ps(coefficients + i + 4)));
+                    }
+                    __m128 folded = _mm_add_ps(sumLow, sumHigh);
+                    folded = _mm_add_ps(folded, _mm_movehl_ps(folded, folded));
+                    folded = _mm_add_ss(folded, _mm_shuffle_ps(folded, folded, 1));
+                    result = _mm_cvtss_f32(folded);
+#elif defined(SOUNDCOE_PCM_NEON)
+                    float32x4_t sum = vdupq_n_f32(0.0f);
+                    for (; i + 4 <= count; i += 4)
+                        sum = vmlaq_f32(sum, vld1q_f32(samples + i), vld1q_f32(coefficients + i));
+                    float32x2_t folded = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+                    result = vget_lane_f32(vpadd_f32(folded, folded), 0);
+#endif
+                    for (; i < count; ++i)
+                        result += samples[i] * coefficients[i];
+                    return result;
+                }
+
+                // Resamples one channel. The plane holds the channel's samples with m_halfTaps zeros in front and
+                // m_tapCount zeros behind, output is written with the given stride.
+                void run(const float *plane, float *output, size_t outputFrames, size_t stride) const
+                {
+                    for (size_t frame = 0; frame < outputFrames; ++frame)
+                    {
+                        size_t position = frame * m_downFactor;
+                        size_t inputFrame = position / m_upFactor;
+                        size_t phase = (position % m_upFactor) * m_phaseCount / m_upFactor;
+                        // plane[inputFrame + 1] is the first tap, m_halfTaps - 1 samples before inputFrame
+                        output[frame * stride] = dot(plane + inputFrame + 1, &m_coefficients[phase * m_tapCount], m_tapCount);
+                    }
+                }
+            };
+
+            size_t getResampledFrameCount(size_t frameCount, int inputRate, int outputRate)
+            {
+                if (inputRate <= 0 || outputRate <= 0)
+                    return 0;
+                size_t divisor = std::gcd(static_cast<size_t>(inputRate), static_cast<size_t>(outputRate));
+                size_t up = static_cast<size_t>(outputRate) / divisor;
+                size_t down = static_cast<size_t>(inputRate) / divisor;
+                return (frameCount * up + down - 1) / down;
+            }
+
+            template <typename Sample>
+            static void resampleImpl(const Sample *input, float *output, size_t frameCount, size_t channels,
+                                     int inputRate, int outputRate, float inputScale)
+            {
+                PolyphaseFilter filter(inputRate, outputRate);
+                size_t outputFrames = getResampledFrameCount(frameCount, inputRate, outputRate);
+                std::vector<float> plane(filter.m_halfTaps + frameCount + filter.m_tapCount, 0.0f);
+                for (size_t channel = 0; channel < channels; ++channel)
+                {
+                    for (size_t frame = 0; frame < frameCount; ++frame)
+                        plane[filter.m_halfTaps + frame] = static_cast<float>(input[frame * channels + channel]) * inputScale;
+                    filter.run(plane.data(), output + channel, outputFrames, channels);
+                }
+            }
+
+            void resample(const int16_t *input, int16_t *output, size_t frameCount, size_t channels, int inputRate, int outputRate)
+            {
+                size_t sampleCount = getResampledFrameCount(frameCount, inputRate, outputRate) * channels;
+                std::vector<float> resampled(sampleCount);
+                resampleImpl(input, resampled.data(), frameCount, channels, inputRate, outputRate, 1.0f / 32768.0f);
+                convertFloatToS16(resampled.data(), output, sampleCount);
+            }
+
+            void resample(const float *input, float *output, size_t frameCount, size_t channels, int inputRate, int outputRate)
+            {
+                resampleImpl(input, output, frameCount, channels, inputRate, outputRate, 1.0f);
+            }
+        } // namespace pcm
+    } // namespace detail
+} // namespace soundcoe
\ No newline at end of file
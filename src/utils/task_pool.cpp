@@ -0,0 +1,102 @@
+#include <soundcoe/utils/task_pool.hpp>
+#include <logcoe.hpp>
+#include <algorithm>
+#include <exception>
+#include <string>
+
+namespace soundcoe
+{
+    namespace detail
+    {
+        TaskPool::~TaskPool() { stop(); }
+
+        size_t TaskPool::defaultThreadCount()
+        {
+            // Leave one core to the game thread
+            unsigned int cores = std::thread::hardware_concurrency();
+            return cores > 1 ? static_cast<size_t>(cores - 1) : 1;
+        }
+
+        void TaskPool::start(size_t threadCount)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_running)
+                return;
+
+            m_running = true;
+            threadCount = std::max<size_t>(threadCount, 1);
+            for (size_t i = 0; i < threadCount; ++i)
+                m_threads.emplace_back(&TaskPool::run, this);
+            logcoe::debug("TaskPool::start: Started " + std::to_string(threadCount) + " worker threads");
+        }
+
+        void TaskPool::stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_running)
+                    return;
+
+                // Tasks that did not start yet are dropped, running ones are waited for below
+                m_running = false;
+                m_tasks.clear();
+            }
+            m_condition.notify_all();
+
+            for (auto &thread : m_threads)
+                if (thread.joinable())
+                    thread.join();
+            m_threads.clear();
+        }
+
+        bool TaskPool::isRunning()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_running;
+        }
+
+        size_t TaskPool::getThreadCount() const { return m_threads.size(); }
+
+        size_t TaskPool::getPendingTaskCount()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_tasks.size();
+        }
+
+        bool TaskPool::submit(std::function<void()> task)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_running)
+                    return false;
+                m_tasks.push_back(std::move(task));
+            }
+            m_condition.notify_one();
+            return true;
+        }
+
+        void TaskPool::run()
+        {
+            while (true)
+            {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_condition.wait(lock, [this]()
+                                     { return !m_running || !m_tasks.empty(); });
+                    if (!m_running)
+                        return;
+
+                    task = std::move(m_tasks.front());
+                    m_tasks.pop_front();
+                }
+
+                try { task(); }
+                catch (const std::exception &e)
+                {
+                    logcoe::error("TaskPool::run: Task threw an exception: " + std::string(e.what()));
+                }
+            }
+        }
+    } // namespace detail
+} // namespace soundcoe
\ No newline at end of file
@@ -55,6 +55,43 @@ TEST_F(AudioContextTests, MultipleShutdownCalls)
     EXPECT_FALSE(m_audioContext.isInitialized());
 }
 
+TEST_F(AudioContextTests, DeferredUpdates)
+{
+    EXPECT_EQ(m_audioContext.isDeferredUpdatesSupported(), alIsExtensionPresent("AL_SOFT_deferred_updates") == AL_TRUE);
+
+    ALuint source = 0;
+    alGenSources(1, &source);
+    ASSERT_EQ(alGetError(), AL_NO_ERROR);
+
+    // Nested windows only apply at the outermost processUpdates
+    m_audioContext.suspendUpdates();
+    m_audioContext.suspendUpdates();
+    alSourcef(source, AL_GAIN, 0.25f);
+    m_audioContext.processUpdates();
+    EXPECT_TRUE(m_audioContext.isUpdatesSuspended());
+    m_audioContext.processUpdates();
+    EXPECT_FALSE(m_audioContext.isUpdatesSuspended());
+
+    ALfloat gain = 0.0f;
+    alGetSourcef(source, AL_GAIN, &gain);
+    EXPECT_FLOAT_EQ(gain, 0.25f);
+
+    // An unbalanced processUpdates is ignored, the next window still opens and closes with one pair
+    m_audioContext.processUpdates();
+    EXPECT_FALSE(m_audioContext.isUpdatesSuspended());
+    m_audioContext.suspendUpdates();
+    EXPECT_TRUE(m_audioContext.isUpdatesSuspended());
+    m_audioContext.processUpdates();
+    EXPECT_FALSE(m_audioContext.isUpdatesSuspended());
+
+    alDeleteSources(1, &source);
+
+    // Without a context both calls do nothing
+    EXPECT_NO_THROW(m_audioContext.shutdown());
+    EXPECT_NO_THROW(m_audioContext.suspendUpdates());
+    EXPECT_NO_THROW(m_audioContext.processUpdates());
+}
+
 TEST_F(AudioContextTests, ThreadSafety)
 {
     const int numThreads = 4;
@@ -1,8 +1,16 @@
 #include <gtest/gtest.h>
 #include <soundcoe/utils/math.hpp>
+#include <soundcoe/utils/pcm.hpp>
+#include <soundcoe/utils/adpcm.hpp>
+#include <soundcoe/utils/spsc_queue.hpp>
+#include <soundcoe/utils/mpsc_queue.hpp>
+#include <soundcoe/utils/slot_map.hpp>
 #include <soundcoe/core/types.hpp>
 #include <cmath>
 #include <limits>
+#include <vector>
+#include <set>
+#include <thread>
 
 #define _USE_MATH_DEFINES
 #ifndef M_PI
@@ -230,6 +238,17 @@ TEST_F(MathTests, VolumeByDistance)
     expectNear(calculateVolumeByDistance(-50.0f, 100.0f, 1.0f), 0.5f);
 }
 
+TEST_F(MathTests, InverseDistanceGain)
+{
+    expectNear(calculateInverseDistanceGain(0.0f), 1.0f);
+    expectNear(calculateInverseDistanceGain(1.0f), 1.0f);
+    expectNear(calculateInverseDistanceGain(4.0f), 0.25f);
+    expectNear(calculateInverseDistanceGain(-4.0f), 0.25f);
+    expectNear(calculateInverseDistanceGain(20.0f, 10.0f), 0.5f);
+    expectNear(calculateInverseDistanceGain(3.0f, 1.0f, 2.0f), 0.2f);
+    expectNear(calculateInverseDistanceGain(50.0f, 0.0f), 1.0f);
+}
+
 TEST_F(MathTests, PanCalculation)
 {
     Vec3 listener(0.0f, 0.0f, 0.0f);
@@ -273,6 +292,192 @@ TEST_F(MathTests, RatioToSemitones)
     expectNear(ratioToSemitones(-1.0f), 0.0f);
 }
 
+//==============================================================================
+//                        PCM Sample Conversion
+//==============================================================================
+
+TEST_F(MathTests, FloatToS16Conversion)
+{
+    // Long enough for the vector loops plus a scalar tail
+    std::vector<float> input = {0.0f, 0.5f, -0.5f, 1.0f, -1.0f, 1.5f, -1.5f, 0.25f,
+                                0.1f, -0.1f, 0.75f, -0.75f, 0.0f, 2.0f, -2.0f, 0.125f,
+                                0.5f, -1.0f, 1.0f};
+    std::vector<int16_t> expected = {0, 16384, -16384, 32767, -32768, 32767, -32768, 8192,
+                                     3277, -3277, 24576, -24576, 0, 32767, -32768, 4096,
+                                     16384, -32768, 32767};
+
+    std::vector<int16_t> output(input.size());
+    detail::pcm::convertFloatToS16(input.data(), output.data(), input.size());
+    EXPECT_EQ(output, expected);
+
+    // In place, the way AudioData uses it
+    std::vector<float> buffer = input;
+    int16_t *inPlace = reinterpret_cast<int16_t *>(buffer.data());
+    detail::pcm::convertFloatToS16(buffer.data(), inPlace, buffer.size());
+    EXPECT_EQ(std::vector<int16_t>(inPlace, inPlace + buffer.size()), expected);
+
+    // Far out of range samples saturate instead of wrapping to a full scale negative click, in the vector loops
+    // and in the scalar tail alike
+    const float overRange[] = {65536.0f, -65536.0f, 1e10f, -1e10f, std::numeric_limits<float>::infinity(),
+                               -std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN()};
+    const int16_t saturated[] = {32767, -32768, 32767, -32768, 32767, -32768, -32768};
+    input.clear();
+    expected.clear();
+    for (int repeat = 0; repeat < 3; ++repeat)
+        for (size_t i = 0; i < 7; ++i)
+        {
+            input.push_back(overRange[i]);
+            expected.push_back(saturated[i]);
+        }
+
+    output.assign(input.size(), 0);
+    detail::pcm::convertFloatToS16(input.data(), output.data(), input.size());
+    EXPECT_EQ(output, expected);
+}
+
+TEST_F(MathTests, S32ToS16Conversion)
+{
+    std::vector<int32_t> input;
+    std::vector<int16_t> expected;
+    for (int i = 0; i < 21; ++i)
+    {
+        int16_t value = static_cast<int16_t>(i * 3000 - 30000);
+        input.push_back(static_cast<int32_t>(value) * 65536 + 0x7FFF);
+        expected.push_back(value);
+    }
+    input.push_back(std::numeric_limits<int32_t>::max());
+    expected.push_back(32767);
+    input.push_back(std::numeric_limits<int32_t>::min());
+    expected.push_back(-32768);
+
+    std::vector<int16_t> output(input.size());
+    detail::pcm::convertS32ToS16(input.data(), output.data(), input.size());
+    EXPECT_EQ(output, expected);
+}
+
+TEST_F(MathTests, StereoDownmix)
+{
+    std::vector<int16_t> stereo;
+    std::vector<int16_t> expected;
+    for (int i = 0; i < 19; ++i)
+    {
+        int16_t left = static_cast<int16_t>(i * 1700 - 16000);
+        int16_t right = static_cast<int16_t>(12000 - i * 900);
+        stereo.push_back(left);
+        stereo.push_back(right);
+        expected.push_back(static_cast<int16_t>((left + right) >> 1));
+    }
+    stereo.push_back(32767);
+    stereo.push_back(32767);
+    expected.push_back(32767);
+
+    std::vector<int16_t> mono(expected.size());
+    detail::pcm::downmixStereoToMono(stereo.data(), mono.data(), mono.size());
+    EXPECT_EQ(mono, expected);
+
+    std::vector<float> stereoFloat;
+    for (int i = 0; i < 11; ++i)
+    {
+        stereoFloat.push_back(i * 0.1f);
+        stereoFloat.push_back(-i * 0.05f);
+    }
+    // In place, the way AudioData uses it
+    detail::pcm::downmixStereoToMono(stereoFloat.data(), stereoFloat.data(), 11);
+    for (int i = 0; i < 11; ++i)
+        expectNear(stereoFloat[i], i * 0.025f);
+}
+
+TEST_F(MathTests, Resampling)
+{
+    EXPECT_EQ(detail::pcm::getResampledFrameCount(44100, 44100, 48000), 48000);
+    EXPECT_EQ(detail::pcm::getResampledFrameCount(22050, 22050, 48000), 48000);
+    EXPECT_EQ(detail::pcm::getResampledFrameCount(1, 48000, 22050), 1);
+    EXPECT_EQ(detail::pcm::getResampledFrameCount(100, 0, 48000), 0);
+
+    // 1kHz stereo tone from 44.1kHz to 48kHz keeps its shape away from the edges
+    const int inputRate = 44100, outputRate = 48000;
+    std::vector<int16_t> input(inputRate / 10 * 2);
+    for (size_t i = 0; i < input.size() / 2; ++i)
+    {
+        input[2 * i] = static_cast<int16_t>(16000.0 * std::sin(2.0 * M_PI * 1000.0 * i / inputRate));
+        input[2 * i + 1] = static_cast<int16_t>(-input[2 * i]);
+    }
+
+    size_t outputFrames = detail::pcm::getResampledFrameCount(input.size() / 2, inputRate, outputRate);
+    std::vector<int16_t> output(outputFrames * 2);
+    detail::pcm::resample(input.data(), output.data(), input.size() / 2, 2, inputRate, outputRate);
+    for (size_t i = 100; i < outputFrames - 100; ++i)
+    {
+        double expected = 16000.0 * std::sin(2.0 * M_PI * 1000.0 * i / outputRate);
+        EXPECT_NEAR(output[2 * i], expected, 8.0);
+        EXPECT_NEAR(output[2 * i + 1], -expected, 8.0);
+    }
+
+    // Constant input stays constant
+    std::vector<float> dc(4800, 0.5f);
+    std::vector<float> dcOutput(detail::pcm::getResampledFrameCount(dc.size(), 48000, 22050));
+    detail::pcm::resample(dc.data(), dcOutput.data(), dc.size(), 1, 48000, 22050);
+    for (size_t i = 50; i < dcOutput.size() - 50; ++i)
+        expectNear(dcOutput[i], 0.5f, 0.001f);
+}
+
+TEST_F(MathTests, AdpcmRoundTrip)
+{
+    EXPECT_EQ(detail::adpcm::getIma4BlockSize(2), 72);
+    EXPECT_EQ(detail::adpcm::getMsAdpcmBlockSize(1), 38);
+    EXPECT_EQ(detail::adpcm::getBlockCount(130, 65), 2);
+    EXPECT_EQ(detail::adpcm::getBlockCount(131, 65), 3);
+    EXPECT_EQ(detail::adpcm::getBlockCount(0, 64), 1);
+
+    // Stereo 440Hz/660Hz tones, a length that leaves a padded last block
+    const size_t frameCount = 4410 + 7;
+    std::vector<int16_t> input(frameCount * 2);
+    for (size_t i = 0; i < frameCount; ++i)
+    {
+        input[2 * i] = static_cast<int16_t>(12000.0 * std::sin(2.0 * M_PI * 440.0 * i / 44100.0));
+        input[2 * i + 1] = static_cast<int16_t>(12000.0 * std::sin(2.0 * M_PI * 660.0 * i / 44100.0));
+    }
+
+    auto signalToNoise = [&input](const std::vector<int16_t> &decoded)
+    {
+        double signal = 0.0, noise = 0.0;
+        for (size_t i = 0; i < input.size(); ++i)
+        {
+            signal += static_cast<double>(input[i]) * input[i];
+            noise += (static_cast<double>(input[i]) - decoded[i]) * (static_cast<double>(input[i]) - decoded[i]);
+        }
+        return 10.0 * std::log10(signal / noise);
+    };
+
+    size_t imaBlocks = detail::adpcm::getBlockCount(frameCount, detail::adpcm::IMA4_FRAMES_PER_BLOCK);
+    std::vector<uint8_t> ima(imaBlocks * detail::adpcm::getIma4BlockSize(2));
+    std::vector<int16_t> imaDecoded(imaBlocks * detail::adpcm::IMA4_FRAMES_PER_BLOCK * 2);
+    detail::adpcm::encodeIma4(input.data(), ima.data(), frameCount, 2);
+    detail::adpcm::decodeIma4(ima.data(), imaDecoded.data(), imaBlocks, 2);
+    EXPECT_EQ(imaDecoded[0], input[0]); // block headers hold the first frame exactly
+    EXPECT_GT(signalToNoise(imaDecoded), 30.0);
+    EXPECT_LT(ima.size() * 3, input.size() * sizeof(int16_t));
+
+    size_t msBlocks = detail::adpcm::getBlockCount(frameCount, detail::adpcm::MSADPCM_FRAMES_PER_BLOCK);
+    std::vector<uint8_t> ms(msBlocks * detail::adpcm::getMsAdpcmBlockSize(2));
+    std::vector<int16_t> msDecoded(msBlocks * detail::adpcm::MSADPCM_FRAMES_PER_BLOCK * 2);
+    detail::adpcm::encodeMsAdpcm(input.data(), ms.data(), frameCount, 2);
+    detail::adpcm::decodeMsAdpcm(ms.data(), msDecoded.data(), msBlocks, 2);
+    EXPECT_EQ(msDecoded[1], input[1]);
+    EXPECT_EQ(msDecoded[3], input[3]);
+    EXPECT_GT(signalToNoise(msDecoded), 40.0);
+    EXPECT_LT(ms.size() * 3, input.size() * sizeof(int16_t));
+
+    // Silence encodes to silence
+    std::vector<int16_t> silence(200, 0);
+    std::vector<uint8_t> silentBlocks(4 * detail::adpcm::getMsAdpcmBlockSize(1));
+    std::vector<int16_t> silentDecoded(4 * detail::adpcm::MSADPCM_FRAMES_PER_BLOCK);
+    detail::adpcm::encodeMsAdpcm(silence.data(), silentBlocks.data(), silence.size(), 1);
+    detail::adpcm::decodeMsAdpcm(silentBlocks.data(), silentDecoded.data(), 4, 1);
+    for (int16_t sample : silentDecoded)
+        EXPECT_EQ(sample, 0);
+}
+
 //==============================================================================
 //                        Edge Cases and Error Conditions
 //==============================================================================
@@ -285,4 +490,161 @@ TEST_F(MathTests, EdgeCases)
     Vec3 veryFar(1000000.0f, 1000000.0f, 1000000.0f);
     Vec3 origin = Vec3::zero();
     EXPECT_GT(distance(origin, veryFar), 1000000.0f);
+}
+
+//==============================================================================
+//          ContainerTests - Lock-free queues and handle containers
+//==============================================================================
+
+class ContainerTests : public ::testing::Test
+{
+};
+
+TEST_F(ContainerTests, SpscQueueOrdering)
+{
+    detail::SpscQueue<int> queue(3);
+    EXPECT_EQ(queue.capacity(), 4);
+    EXPECT_TRUE(queue.empty());
+
+    for (int i = 0; i < 4; ++i)
+        EXPECT_TRUE(queue.tryPush(int(i)));
+    EXPECT_FALSE(queue.tryPush(4));
+
+    int value = -1;
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.tryPop(value));
+
+    std::thread producer([&queue]()
+                         {
+        for (int i = 0; i < 10000; ++i)
+            while (!queue.tryPush(int(i))) std::this_thread::yield(); });
+
+    int expected = 0;
+    while (expected < 10000)
+    {
+        if (queue.tryPop(value))
+            EXPECT_EQ(value, expected++);
+    }
+    producer.join();
+}
+
+TEST_F(ContainerTests, MpscQueueOrdering)
+{
+    detail::MpscQueue<int> queue(3);
+    EXPECT_EQ(queue.capacity(), 4);
+
+    for (int i = 0; i < 4; ++i)
+        EXPECT_TRUE(queue.tryPush(int(i)));
+    EXPECT_FALSE(queue.tryPush(4));
+
+    int value = -1;
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.tryPop(value));
+
+    // Values are producer * 10000 + sequence, each producer's values must come out in the order it pushed them
+    const int producerCount = 4;
+    const int perProducer = 10000;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producerCount; ++p)
+        producers.emplace_back([&queue, p, perProducer]()
+                               {
+            for (int i = 0; i < perProducer; ++i)
+                while (!queue.tryPush(p * perProducer + i)) std::this_thread::yield(); });
+
+    std::vector<int> next(producerCount, 0);
+    int received = 0;
+    while (received < producerCount * perProducer)
+    {
+        if (!queue.tryPop(value))
+            continue;
+        int producer = value / perProducer;
+        ASSERT_LT(producer, producerCount);
+        EXPECT_EQ(value % perProducer, next[producer]++);
+        ++received;
+    }
+    for (auto &producer : producers)
+        producer.join();
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+TEST_F(ContainerTests, SlotMapHandles)
+{
+    detail::SlotMap<int> map;
+    size_t first = map.insert(1);
+    size_t second = map.insert(2);
+    size_t third = map.insert(3);
+    EXPECT_NE(first, 0);
+    EXPECT_EQ(map.size(), 3);
+    EXPECT_EQ(map.find(second)->second, 2);
+
+    // Erasing while iterating visits every value once
+    int sum = 0;
+    for (auto it = map.begin(); it != map.end();)
+    {
+        sum += it->second;
+        if (it->first == first)
+            it = map.erase(it);
+        else
+            ++it;
+    }
+    EXPECT_EQ(sum, 6);
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_EQ(map.find(third)->second, 3);
+
+    // The freed slot is reused under a new generation, the old handle stays stale
+    size_t fourth = map.insert(4);
+    EXPECT_NE(fourth, first);
+    EXPECT_FALSE(map.contains(first));
+    EXPECT_EQ(map.find(fourth)->second, 4);
+    EXPECT_EQ(map.erase(first), 0);
+
+    size_t reserved = map.reserve(false);
+    ASSERT_NE(reserved, 0);
+    EXPECT_TRUE(map.isReserved(reserved));
+    EXPECT_FALSE(map.contains(reserved));
+    EXPECT_TRUE(map.insert(reserved, 5));
+    EXPECT_EQ(map.find(reserved)->second, 5);
+    EXPECT_FALSE(map.insert(reserved, 6));
+
+    size_t cancelled = map.reserve(true);
+    map.cancel(cancelled);
+    EXPECT_FALSE(map.insert(cancelled, 7));
+
+    // Other threads reserve while the owner inserts and erases, no slot is handed out twice
+    map.reserveCapacity(256);
+    EXPECT_GE(map.capacity(), 256);
+    std::vector<std::vector<size_t>> reservations(4);
+    std::vector<std::thread> producers;
+    for (auto &handles : reservations)
+        producers.emplace_back([&map, &handles]()
+                               {
+            for (int i = 0; i < 50; ++i)
+                handles.push_back(map.reserve(false)); });
+    for (int i = 0; i < 50; ++i)
+        map.erase(map.insert(int(i)));
+    for (auto &producer : producers)
+        producer.join();
+
+    std::set<size_t> unique;
+    for (const auto &handles : reservations)
+        for (size_t handle : handles)
+        {
+            EXPECT_TRUE(map.isReserved(handle));
+            unique.insert(handle);
+        }
+    EXPECT_EQ(unique.size(), 200);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.contains(second));
+    EXPECT_FALSE(map.contains(reserved));
+    EXPECT_FALSE(map.isReserved(reservations[0][0]));
 }
\ No newline at end of file
@@ -100,6 +100,49 @@ TEST_F(SoundManagerTests, PlayMusicBasic)
     EXPECT_EQ(m_soundManager.getActiveMusicCount(), 1);
 }
 
+TEST_F(SoundManagerTests, StreamedMusicOnFreshPool)
+{
+    std::filesystem::path root = std::filesystem::temp_directory_path() / "soundcoe_stream_test";
+    TestAudioFiles::createStreamedWavFile(root / "general" / "music" / "long.wav");
+    ASSERT_TRUE(m_soundManager.initialize(root.string(), 8, 32));
+
+    // The first play lands on a pool source that has never been used
+    auto handle = m_soundManager.playMusic("long.wav");
+    ASSERT_NE(handle, INVALID_MUSIC_HANDLE);
+
+    m_soundManager.update();
+    EXPECT_TRUE(m_soundManager.isMusicPlaying(handle));
+    EXPECT_TRUE(m_soundManager.stopMusic(handle));
+
+    m_soundManager.shutdown();
+    std::error_code ec;
+    std::filesystem::remove_all(root, ec);
+}
+
+TEST_F(SoundManagerTests, StreamedMusic)
+{
+    EXPECT_TRUE(m_soundManager.setStreamingPolicy("music", StreamingPolicy::always()));
+    EXPECT_FALSE(m_soundManager.setStreamReadAhead(0));
+    EXPECT_TRUE(m_soundManager.setStreamReadAhead(2));
+    EXPECT_EQ(m_soundManager.getStreamReadAhead(), 2);
+    initializeSoundManager();
+
+    auto handle = m_soundManager.playMusic("background.wav", 1.0f, 1.0f, true);
+    ASSERT_NE(handle, INVALID_MUSIC_HANDLE);
+
+    for (int i = 0; i < 20; ++i)
+    {
+        m_soundManager.update();
+        std::this_thread::sleep_for(std::chrono::milliseconds(16));
+    }
+
+    EXPECT_TRUE(m_soundManager.isMusicPlaying(handle));
+    EXPECT_TRUE(m_soundManager.stopMusic(handle));
+
+    m_soundManager.shutdown();
+    EXPECT_EQ(m_soundManager.getStreamUnderrunCount(), 0);
+}
+
 TEST_F(SoundManagerTests, PlaySound3D)
 {
     initializeSoundManager();
@@ -114,6 +157,30 @@ TEST_F(SoundManagerTests, PlaySound3D)
     EXPECT_TRUE(m_soundManager.isSoundPlaying(handle));
 }
 
+TEST_F(SoundManagerTests, PlaySoundById)
+{
+    EXPECT_FALSE(m_soundManager.registerSound("beep.wav").isValid());
+    initializeSoundManager();
+
+    SoundId beep = m_soundManager.registerSound("./beep.wav");
+    EXPECT_EQ(beep, makeSoundId("beep.wav"));
+    EXPECT_EQ(m_soundManager.registerSound("beep.wav"), beep);
+
+    auto handle = m_soundManager.playSound(beep);
+    EXPECT_NE(handle, INVALID_SOUND_HANDLE);
+    auto handle3D = m_soundManager.playSound3D(beep, Vec3(1.0f, 0.0f, 0.0f));
+    EXPECT_NE(handle3D, INVALID_SOUND_HANDLE);
+
+    m_soundManager.update();
+    EXPECT_TRUE(m_soundManager.isSoundPlaying(handle));
+    EXPECT_TRUE(m_soundManager.stopSound(handle));
+    EXPECT_TRUE(m_soundManager.stopSound(handle3D));
+
+    // Registered but not in a loaded directory, and never registered
+    EXPECT_EQ(m_soundManager.playSound(m_soundManager.registerSound("missing.wav")), INVALID_SOUND_HANDLE);
+    EXPECT_EQ(m_soundManager.playSound(makeSoundId("unregistered.wav")), INVALID_SOUND_HANDLE);
+}
+
 TEST_F(SoundManagerTests, InvalidFileHandling)
 {
     initializeSoundManager();
@@ -321,6 +388,50 @@ TEST_F(SoundManagerTests, FadeToVolume)
     EXPECT_TRUE(m_soundManager.isMusicPlaying(musicHandle));
 }
 
+TEST_F(SoundManagerTests, FadeTable)
+{
+    FadeTable fades;
+    size_t fadeIn = fades.add(1);
+    size_t fadeOut = fades.add(2);
+    fades.restart(fadeIn, 0.0f, 1.0f, 1.0f);
+    fades.restart(fadeOut, 0.8f, 0.0f, 0.5f);
+
+    fades.advance(0.25f, 0.5f);
+    EXPECT_FLOAT_EQ(fades.m_volume[fadeIn], 0.25f);
+    EXPECT_FLOAT_EQ(fades.m_gain[fadeIn], 0.125f);
+    EXPECT_FLOAT_EQ(fades.m_volume[fadeOut], 0.4f);
+    EXPECT_FALSE(fades.m_finished[fadeOut]);
+
+    fades.advance(0.5f, 0.0f);
+    EXPECT_FLOAT_EQ(fades.m_volume[fadeOut], 0.0f);
+    EXPECT_FLOAT_EQ(fades.m_gain[fadeIn], 0.0f);
+    EXPECT_TRUE(fades.m_finished[fadeOut]);
+    EXPECT_FALSE(fades.m_finished[fadeIn]);
+
+    // The last entry moves into the removed one and its handle is returned
+    EXPECT_EQ(fades.remove(fadeIn), 2);
+    EXPECT_EQ(fades.size(), 1);
+    EXPECT_EQ(fades.m_handles[0], 2);
+    EXPECT_EQ(fades.remove(0), 0);
+
+    // Several voices fading at once, one stopped mid-fade
+    initializeSoundManager();
+    m_soundManager.update();
+    std::vector<SoundHandle> handles;
+    for (int i = 0; i < 4; ++i)
+    {
+        handles.push_back(m_soundManager.playSound("beep.wav"));
+        ASSERT_NE(handles.back(), INVALID_SOUND_HANDLE);
+        EXPECT_TRUE(m_soundManager.fadeOutSound(handles.back(), 0.1f + 0.05f * i));
+    }
+    m_soundManager.update();
+    EXPECT_TRUE(m_soundManager.stopSound(handles[1]));
+    EXPECT_TRUE(m_soundManager.setSoundVolume(handles[2], 0.5f));
+
+    waitForFade(0.3f);
+    EXPECT_EQ(m_soundManager.getActiveSoundsCount(), 0);
+}
+
 TEST_F(SoundManagerTests, SceneManagement)
 {
     initializeSoundManager();
@@ -337,6 +448,32 @@ TEST_F(SoundManagerTests, SceneManagement)
     EXPECT_FALSE(m_soundManager.isSceneLoaded("scene1"));
 }
 
+TEST_F(SoundManagerTests, AsyncSceneManagement)
+{
+    initializeSoundManager();
+
+    auto music = m_soundManager.playMusic("background.wav");
+    EXPECT_NE(music, INVALID_MUSIC_HANDLE);
+
+    PreloadTicket ticket = m_soundManager.preloadSceneAsync("scene1");
+    EXPECT_FALSE(m_soundManager.isSceneLoaded("scene1"));
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!ticket.isDone() && std::chrono::steady_clock::now() < deadline)
+    {
+        m_soundManager.update();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    EXPECT_TRUE(ticket.succeeded());
+    EXPECT_EQ(ticket.getFilesDone(), ticket.getFilesTotal());
+    EXPECT_TRUE(m_soundManager.isSceneLoaded("scene1"));
+
+    auto sound = m_soundManager.playSound("explosion.wav");
+    EXPECT_NE(sound, INVALID_SOUND_HANDLE);
+    EXPECT_TRUE(m_soundManager.unloadScene("scene1"));
+}
+
 TEST_F(SoundManagerTests, InvalidSceneOperations)
 {
     initializeSoundManager();
@@ -388,6 +525,230 @@ TEST_F(SoundManagerTests, MultipleSoundsAndMusic)
     EXPECT_EQ(m_soundManager.getActiveMusicCount(), 0);
 }
 
+TEST_F(SoundManagerTests, VirtualVoices)
+{
+    initializeSoundManager();
+    m_soundManager.update(); // The first update only starts the clock
+
+    std::vector<SoundHandle> handles;
+    for (int i = 0; i < 8; ++i)
+        handles.push_back(m_soundManager.playSound("beep.wav", 1.0f, 1.0f, true));
+
+    // No source to steal from a lower priority, the sound starts virtual
+    auto low = m_soundManager.playSound("beep.wav", 1.0f, 1.0f, true, SoundPriority::Low);
+    ASSERT_NE(low, INVALID_SOUND_HANDLE);
+    EXPECT_EQ(m_soundManager.getVirtualVoiceCount(), 1);
+    EXPECT_TRUE(m_soundManager.isSoundPlaying(low));
+    EXPECT_TRUE(m_soundManager.pauseSound(low));
+    EXPECT_TRUE(m_soundManager.isSoundPaused(low));
+    EXPECT_TRUE(m_soundManager.resumeSound(low));
+
+    // A stolen voice becomes virtual instead of disappearing
+    auto high = m_soundManager.playSound("beep.wav", 1.0f, 1.0f, true, SoundPriority::High);
+    ASSERT_NE(high, INVALID_SOUND_HANDLE);
+    m_soundManager.update();
+    EXPECT_EQ(m_soundManager.getVirtualVoiceCount(), 2);
+    EXPECT_EQ(m_soundManager.getActiveSoundsCount(), 10);
+
+    // Freed sources go to the most important virtual voices first
+    EXPECT_TRUE(m_soundManager.stopSound(handles.back()));
+    m_soundManager.update();
+    EXPECT_EQ(m_soundManager.getVirtualVoiceCount(), 1);
+    EXPECT_TRUE(m_soundManager.isSoundPlaying(low));
+
+    EXPECT_TRUE(m_soundManager.setMaxVirtualVoices(1));
+    EXPECT_EQ(m_soundManager.playSound("beep.wav", 1.0f, 1.0f, false, SoundPriority::Low), INVALID_SOUND_HANDLE);
+
+    EXPECT_TRUE(m_soundManager.stopAllSounds());
+    EXPECT_EQ(m_soundManager.getVirtualVoiceCount(), 0);
+    EXPECT_EQ(m_soundManager.getActiveSoundsCount(), 0);
+}
+
+TEST_F(SoundManagerTests, AudibilityCulling)
+{
+    initializeSoundManager();
+    m_soundManager.update();
+    m_soundManager.setListenerPosition(Vec3(0.0f, 0.0f, 0.0f));
+
+    // Far beyond -60dB, or past the sound's own range: one-shots are dropped before loading anything
+    EXPECT_EQ(m_soundManager.playSound3D("beep.wav", Vec3(5000.0f, 0.0f, 0.0f)), INVALID_SOUND_HANDLE);
+    EXPECT_EQ(m_soundManager.playSound3D("beep.wav", Vec3(30.0f, 0.0f, 0.0f), Vec3::zero(), 1.0f, 1.0f, false,
+                                         SoundPriority::Medium, 20.0f), INVALID_SOUND_HANDLE);
+    EXPECT_EQ(m_soundManager.getActiveSoundsCount(), 0);
+
+    // Loops wait as virtual voices until they come into range
+    auto loop = m_soundManager.playSound3D("beep.wav", Vec3(30.0f, 0.0f, 0.0f), Vec3::zero(), 1.0f, 1.0f, true,
+                                           SoundPriority::Medium, 20.0f);
+    ASSERT_NE(loop, INVALID_SOUND_HANDLE);
+    EXPECT_EQ(m_soundManager.getVirtualVoiceCount(), 1);
+    m_soundManager.update();
+    EXPECT_EQ(m_soundManager.getVirtualVoiceCount(), 1);
+
+    EXPECT_TRUE(m_soundManager.setSoundPosition(loop, Vec3(10.0f, 0.0f, 0.0f)));
+    m_soundManager.update();
+    EXPECT_EQ(m_soundManager.getVirtualVoiceCount(), 0);
+    EXPECT_TRUE(m_soundManager.isSoundPlaying(loop));
+
+    // A playing loop that moves past its range gives its source back, the same as if it had started there
+    EXPECT_TRUE(m_soundManager.setSoundPosition(loop, Vec3(30.0f, 0.0f, 0.0f)));
+    m_soundManager.update();
+    EXPECT_EQ(m_soundManager.getVirtualVoiceCount(), 1);
+    EXPECT_TRUE(m_soundManager.isSoundPlaying(loop));
+
+    EXPECT_TRUE(m_soundManager.setSoundPosition(loop, Vec3(10.0f, 0.0f, 0.0f)));
+    m_soundManager.update();
+    EXPECT_EQ(m_soundManager.getVirtualVoiceCount(), 0);
+    EXPECT_TRUE(m_soundManager.isSoundPlaying(loop));
+
+    EXPECT_TRUE(m_soundManager.setAudibilityThreshold(0.0f));
+    auto far = m_soundManager.playSound3D("beep.wav", Vec3(5000.0f, 0.0f, 0.0f));
+    EXPECT_NE(far, INVALID_SOUND_HANDLE);
+    EXPECT_FALSE(m_soundManager.setAudibilityThreshold(-1.0f));
+}
+
+TEST_F(SoundManagerTests, CommandQueue)
+{
+    EXPECT_FALSE(m_soundManager.setCommandQueueEnabled(true));
+    EXPECT_EQ(m_soundManager.playSound("beep.wav"), INVALID_SOUND_HANDLE);
+
+    initializeSoundManager();
+    m_soundManager.update();
+    EXPECT_FALSE(m_soundManager.isCommandQueueEnabled());
+    EXPECT_TRUE(m_soundManager.setCommandQueueEnabled(true));
+    EXPECT_TRUE(m_soundManager.isCommandQueueEnabled());
+
+    // Plays return reserved handles at once and only start at the next update
+    std::vector<SoundHandle> handles(4, INVALID_SOUND_HANDLE);
+    std::vector<std::thread> producers;
+    for (size_t i = 0; i < handles.size(); ++i)
+        producers.emplace_back([this, &handles, i]()
+                               {
+            handles[i] = m_soundManager.playSound("beep.wav", 1.0f, 1.0f, true);
+            m_soundManager.setSoundVolume(handles[i], 0.5f); });
+    for (auto &producer : producers)
+        producer.join();
+
+    for (auto handle : handles)
+        ASSERT_NE(handle, INVALID_SOUND_HANDLE);
+    EXPECT_EQ(m_soundManager.getActiveSoundsCount(), 0);
+
+    m_soundManager.update();
+    EXPECT_EQ(m_soundManager.getActiveSoundsCount(), handles.size());
+    for (auto handle : handles)
+        EXPECT_TRUE(m_soundManager.isSoundPlaying(handle));
+
+    // Disabling applies what is still queued
+    EXPECT_TRUE(m_soundManager.stopSound(handles[0]));
+    EXPECT_TRUE(m_soundManager.setCommandQueueEnabled(false));
+    EXPECT_EQ(m_soundManager.getActiveSoundsCount(), handles.size() - 1);
+    EXPECT_FALSE(m_soundManager.stopSound(handles[0]));
+}
+
+TEST_F(SoundManagerTests, CommandQueueShutdownRace)
+{
+    initializeSoundManager();
+    m_soundManager.update();
+    EXPECT_TRUE(m_soundManager.setCommandQueueEnabled(true));
+
+    // A producer that saw the queue enabled finishes its push before shutdown() drains it, later calls take the
+    // locked path and find the manager shut down
+    std::vector<std::thread> producers;
+    for (int i = 0; i < 4; ++i)
+        producers.emplace_back([this]()
+                               {
+            while (m_soundManager.isCommandQueueEnabled())
+                m_soundManager.playSound("beep.wav"); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    m_soundManager.shutdown();
+    for (auto &producer : producers)
+        producer.join();
+
+    EXPECT_EQ(m_soundManager.getActiveSoundsCount(), 0);
+    initializeSoundManager();
+    m_soundManager.update();
+    EXPECT_EQ(m_soundManager.getActiveSoundsCount(), 0);
+}
+
+TEST_F(SoundManagerTests, CommandQueueOrdering)
+{
+    initializeSoundManager();
+    m_soundManager.update();
+    EXPECT_TRUE(m_soundManager.setCommandQueueEnabled(true));
+
+    // Calls that lock apply what was queued before them first
+    auto looping = m_soundManager.playSound("beep.wav", 1.0f, 1.0f, true);
+    ASSERT_NE(looping, INVALID_SOUND_HANDLE);
+    EXPECT_TRUE(m_soundManager.stopAllSounds());
+    m_soundManager.update();
+    EXPECT_EQ(m_soundManager.getActiveSoundsCount(), 0);
+
+    auto fading = m_soundManager.playSound("beep.wav");
+    ASSERT_NE(fading, INVALID_SOUND_HANDLE);
+    EXPECT_TRUE(m_soundManager.fadeOutSound(fading, 1.0f));
+
+    auto music = m_soundManager.playMusic("background.wav");
+    ASSERT_NE(music, INVALID_MUSIC_HANDLE);
+    EXPECT_TRUE(m_soundManager.pauseAllMusic());
+    EXPECT_TRUE(m_soundManager.isMusicPaused(music));
+
+    // And queued calls made after them go after them
+    EXPECT_TRUE(m_soundManager.resumeMusic(music));
+    EXPECT_TRUE(m_soundManager.isMusicPaused(music));
+    m_soundManager.update();
+    EXPECT_TRUE(m_soundManager.isMusicPlaying(music));
+}
+
+TEST_F(SoundManagerTests, StaleHandles)
+{
+    initializeSoundManager();
+    m_soundManager.update();
+
+    auto first = m_soundManager.playSound("beep.wav", 1.0f, 1.0f, true);
+    ASSERT_NE(first, INVALID_SOUND_HANDLE);
+    EXPECT_TRUE(m_soundManager.stopSound(first));
+
+    // The next sound reuses the slot, the stopped handle must not reach it
+    auto second = m_soundManager.playSound("beep.wav", 1.0f, 1.0f, true);
+    ASSERT_NE(second, INVALID_SOUND_HANDLE);
+    EXPECT_NE(first, second);
+    EXPECT_FALSE(m_soundManager.stopSound(first));
+    EXPECT_FALSE(m_soundManager.setSoundVolume(first, 0.0f));
+    EXPECT_TRUE(m_soundManager.isSoundPlaying(second));
+    EXPECT_EQ(m_soundManager.getActiveSoundsCount(), 1);
+}
+
+TEST_F(SoundManagerTests, BatchedCalls)
+{
+    initializeSoundManager();
+    m_soundManager.update();
+
+    std::vector<PlayRequest> requests(3);
+    requests[0].filename = "beep.wav";
+    requests[1].filename = "missing.wav";
+    requests[2].filename = "beep.wav";
+    requests[2].is3D = true;
+    requests[2].position = Vec3(1.0f, 0.0f, 0.0f);
+    requests[2].loop = true;
+
+    auto handles = m_soundManager.playSounds(requests);
+    ASSERT_EQ(handles.size(), requests.size());
+    EXPECT_NE(handles[0], INVALID_SOUND_HANDLE);
+    EXPECT_EQ(handles[1], INVALID_SOUND_HANDLE);
+    EXPECT_NE(handles[2], INVALID_SOUND_HANDLE);
+    EXPECT_EQ(m_soundManager.getActiveSoundsCount(), 2);
+
+    EXPECT_TRUE(m_soundManager.setSoundPositions({{handles[0], Vec3(2.0f, 0.0f, 0.0f)},
+                                                  {handles[2], Vec3(3.0f, 0.0f, 0.0f)}}));
+    EXPECT_FALSE(m_soundManager.setSoundPositions({{handles[1], Vec3::zero()}, {handles[2], Vec3::zero()}}));
+
+    EXPECT_TRUE(m_soundManager.pauseSound(handles[2]));
+    auto states = m_soundManager.getSoundStates({handles[0], handles[1], handles[2]});
+    ASSERT_EQ(states.size(), 3);
+    EXPECT_EQ(states[0], SoundState::Playing);
+    EXPECT_EQ(states[1], SoundState::Stopped);
+    EXPECT_EQ(states[2], SoundState::Paused);
+}
+
 TEST_F(SoundManagerTests, ErrorHandling)
 {
     initializeSoundManager();
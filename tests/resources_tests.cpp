@@ -1,12 +1,18 @@
 #include <gtest/gtest.h>
 #include <soundcoe/core/audio_context.hpp>
 #include <soundcoe/resources/resource_manager.hpp>
+#include <soundcoe/resources/sound_stream.hpp>
+#include <soundcoe/resources/stream_worker.hpp>
+#include <soundcoe/utils/mapped_file.hpp>
+#include <soundcoe/resources/sound_bank.hpp>
 #include <soundcoe/core/types.hpp>
+#include <AL/alext.h>
 #include "utils/test_audio_files.hpp"
 #include <thread>
 #include <chrono>
 #include <vector>
 #include <future>
+#include <cstring>
 
 using namespace soundcoe;
 using namespace soundcoe::detail;
@@ -57,6 +63,23 @@ TEST_F(ResourceManagerTests, MultipleShutdown)
     EXPECT_FALSE(m_resourceManager.isInitialized());
 }
 
+TEST_F(ResourceManagerTests, DeferredUpdatesScope)
+{
+    {
+        DeferredUpdates outer(m_resourceManager);
+        DeferredUpdates inner(m_resourceManager);
+        EXPECT_TRUE(m_resourceManager.isUpdatesSuspended());
+    }
+    EXPECT_FALSE(m_resourceManager.isUpdatesSuspended());
+
+    // Leaving by an exception still ends the window
+    EXPECT_THROW({
+        DeferredUpdates deferred(m_resourceManager);
+        throw std::length_error("SlotMap::insert: Every slot index is in use");
+    }, std::length_error);
+    EXPECT_FALSE(m_resourceManager.isUpdatesSuspended());
+}
+
 TEST_F(ResourceManagerTests, SourceAcquisitionAndRelease)
 {
     size_t poolIndex;
@@ -121,6 +144,26 @@ TEST_F(ResourceManagerTests, PriorityReplacement)
         m_resourceManager.releaseSource(source);
 }
 
+TEST_F(ResourceManagerTests, StealOrder)
+{
+    const SoundPriority priorities[] = {SoundPriority::Medium, SoundPriority::Low, SoundPriority::High, SoundPriority::Low};
+    size_t indices[4];
+    for (int i = 0; i < 4; ++i)
+        ASSERT_TRUE(m_resourceManager.acquireSource(indices[i], priorities[i]).has_value());
+
+    // Lowest priority first, the oldest of equal priorities first
+    size_t stolen;
+    ASSERT_TRUE(m_resourceManager.acquireSource(stolen, SoundPriority::Medium).has_value());
+    EXPECT_EQ(stolen, indices[1]);
+    ASSERT_TRUE(m_resourceManager.acquireSource(stolen, SoundPriority::Medium).has_value());
+    EXPECT_EQ(stolen, indices[3]);
+    ASSERT_TRUE(m_resourceManager.acquireSource(stolen, SoundPriority::Medium).has_value());
+    EXPECT_EQ(stolen, indices[0]);
+
+    EXPECT_FALSE(m_resourceManager.acquireSource(stolen, SoundPriority::Low).has_value());
+    EXPECT_EQ(m_resourceManager.getActiveSourceCount(), 4);
+}
+
 TEST_F(ResourceManagerTests, BufferLoadingAndCaching)
 {
     // First preload the directory to make files available
@@ -230,6 +273,30 @@ TEST_F(ResourceManagerTests, FileLoadingThroughDirectory)
     EXPECT_FALSE(bufferAfterUnload.has_value());
 }
 
+TEST_F(ResourceManagerTests, FileIndex)
+{
+    ASSERT_TRUE(m_resourceManager.preloadDirectory("sounds"));
+
+    auto buffer = m_resourceManager.getBuffer("./test1.wav");
+    ASSERT_TRUE(buffer.has_value());
+    m_resourceManager.releaseBuffer(buffer.value());
+
+    // Names are indexed at preload, a file added afterwards needs the directory to be reloaded
+    std::filesystem::path lateFile = TestAudioFiles::s_testSubDir1 / "late.wav";
+    std::filesystem::copy_file(TestAudioFiles::s_testSubDir1 / "test1.wav", lateFile);
+    EXPECT_FALSE(m_resourceManager.getBuffer("late.wav").has_value());
+
+    EXPECT_TRUE(m_resourceManager.unloadDirectory("sounds"));
+    EXPECT_TRUE(m_resourceManager.preloadDirectory("sounds"));
+    buffer = m_resourceManager.getBuffer("late.wav");
+    EXPECT_TRUE(buffer.has_value());
+    if (buffer.has_value())
+        m_resourceManager.releaseBuffer(buffer.value());
+
+    EXPECT_TRUE(m_resourceManager.unloadDirectory("sounds"));
+    std::filesystem::remove(lateFile);
+}
+
 TEST_F(ResourceManagerTests, ConcurrentSourceAccess)
 {
     const int numThreads = 3;
@@ -349,6 +416,256 @@ TEST_F(ResourceManagerTests, ErrorConditions)
     std::filesystem::remove(corruptFile);
 }
 
+TEST_F(ResourceManagerTests, ParallelDirectoryPreload)
+{
+    EXPECT_TRUE(m_resourceManager.setDecodeThreadCount(4));
+    EXPECT_EQ(m_resourceManager.getDecodeThreadCount(), 4);
+    EXPECT_TRUE(m_resourceManager.preloadDirectory("sounds"));
+    EXPECT_TRUE(m_resourceManager.preloadDirectory("music"));
+    EXPECT_EQ(m_resourceManager.getCachedBufferCount(), 3);
+
+    auto buffer = m_resourceManager.getBuffer("test2.wav");
+    ASSERT_TRUE(buffer.has_value());
+    EXPECT_NE(buffer.value().get().getBufferId(), 0);
+    EXPECT_TRUE(m_resourceManager.releaseBuffer("test2.wav"));
+
+    EXPECT_TRUE(m_resourceManager.setDecodeThreadCount(1));
+    EXPECT_TRUE(m_resourceManager.unloadDirectory("sounds"));
+    EXPECT_TRUE(m_resourceManager.preloadDirectory("sounds"));
+    EXPECT_EQ(m_resourceManager.getCachedBufferCount(), 3);
+
+    PreloadTicket ticket = m_resourceManager.preloadDirectoryAsync("general");
+    EXPECT_TRUE(ticket.isValid());
+    EXPECT_FALSE(m_resourceManager.setDecodeThreadCount(2));
+    EXPECT_TRUE(m_resourceManager.unloadDirectory("general"));
+    EXPECT_TRUE(m_resourceManager.setDecodeThreadCount(0));
+}
+
+TEST_F(ResourceManagerTests, AsyncDirectoryPreload)
+{
+    // readme.txt is scanned like any other file and reported as failed by its decode task
+    PreloadTicket ticket = m_resourceManager.preloadDirectoryAsync("sounds");
+    ASSERT_TRUE(ticket.isValid());
+    EXPECT_EQ(ticket.getFilesTotal(), 3);
+    EXPECT_GT(ticket.getBytesTotal(), 0);
+    EXPECT_TRUE(m_resourceManager.isDirectoryLoading("sounds"));
+
+    PreloadTicket sameTicket = m_resourceManager.preloadDirectoryAsync("sounds");
+    EXPECT_EQ(sameTicket.getFilesTotal(), 3);
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!ticket.isDone() && std::chrono::steady_clock::now() < deadline)
+    {
+        m_resourceManager.processAsyncLoads();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    EXPECT_TRUE(ticket.succeeded());
+    EXPECT_TRUE(sameTicket.isDone());
+    EXPECT_EQ(ticket.getFilesDone(), 2);
+    EXPECT_EQ(ticket.getFilesFailed(), 1);
+    EXPECT_EQ(ticket.getBytesDone(), ticket.getBytesTotal());
+    EXPECT_FLOAT_EQ(ticket.getProgress(), 1.0f);
+    EXPECT_FALSE(m_resourceManager.isDirectoryLoading("sounds"));
+    EXPECT_TRUE(m_resourceManager.isDirectoryLoaded("sounds"));
+    EXPECT_EQ(m_resourceManager.getCachedBufferCount(), 2);
+}
+
+TEST_F(ResourceManagerTests, AsyncDirectoryPreloadCancel)
+{
+    PreloadTicket ticket = m_resourceManager.preloadDirectoryAsync("sounds");
+    ASSERT_FALSE(ticket.isDone());
+
+    EXPECT_TRUE(m_resourceManager.unloadDirectory("sounds"));
+    EXPECT_TRUE(ticket.isDone());
+    EXPECT_TRUE(ticket.isCancelled());
+    EXPECT_FALSE(ticket.succeeded());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    m_resourceManager.processAsyncLoads();
+    EXPECT_FALSE(m_resourceManager.isDirectoryLoaded("sounds"));
+    EXPECT_EQ(m_resourceManager.getCachedBufferCount(), 0);
+
+    PreloadTicket invalid = m_resourceManager.preloadDirectoryAsync("nonexistent");
+    EXPECT_TRUE(invalid.isDone());
+    EXPECT_FALSE(invalid.succeeded());
+}
+
+TEST_F(ResourceManagerTests, StreamingPolicy)
+{
+    EXPECT_EQ(m_resourceManager.getStreamingPolicy(), StreamingPolicy());
+    EXPECT_FALSE(m_resourceManager.setStreamingPolicy("", StreamingPolicy::always()));
+    EXPECT_TRUE(m_resourceManager.setStreamingPolicy("music/", StreamingPolicy::always()));
+    EXPECT_EQ(m_resourceManager.getStreamingPolicy("music"), StreamingPolicy::always());
+
+    EXPECT_TRUE(m_resourceManager.preloadDirectory("sounds"));
+    EXPECT_TRUE(m_resourceManager.preloadDirectory("music"));
+
+    auto sound = m_resourceManager.getBuffer("test1.wav");
+    auto music = m_resourceManager.getBuffer("music1.wav");
+    ASSERT_TRUE(sound.has_value());
+    ASSERT_TRUE(music.has_value());
+    EXPECT_FALSE(sound.value().get().isStreaming());
+    EXPECT_TRUE(music.value().get().isStreaming());
+    EXPECT_EQ(music.value().get().getSize(), 0);
+    EXPECT_GT(music.value().get().getDuration(), 0.0f);
+
+    EXPECT_TRUE(m_resourceManager.releaseBuffer("test1.wav"));
+    EXPECT_TRUE(m_resourceManager.releaseBuffer("music1.wav"));
+    EXPECT_TRUE(m_resourceManager.clearStreamingPolicy("music"));
+    EXPECT_FALSE(m_resourceManager.clearStreamingPolicy("music"));
+    EXPECT_EQ(m_resourceManager.getStreamingPolicy("music"), StreamingPolicy());
+}
+
+TEST_F(ResourceManagerTests, StreamingPolicyByDuration)
+{
+    m_resourceManager.setStreamingPolicy(StreamingPolicy::byDuration(0.01f));
+    EXPECT_TRUE(m_resourceManager.preloadDirectory("sounds"));
+
+    auto sound = m_resourceManager.getBuffer("test1.wav");
+    ASSERT_TRUE(sound.has_value());
+    EXPECT_TRUE(sound.value().get().isStreaming());
+    EXPECT_EQ(m_resourceManager.getCacheSizeBytes(), 0);
+    EXPECT_TRUE(m_resourceManager.releaseBuffer("test1.wav"));
+}
+
+TEST_F(ResourceManagerTests, MonoDownmix)
+{
+    EXPECT_FALSE(m_resourceManager.isMonoDownmixEnabled());
+    EXPECT_FALSE(m_resourceManager.setMonoDownmix("", true));
+    EXPECT_TRUE(m_resourceManager.setMonoDownmix("stereo", true));
+    EXPECT_TRUE(m_resourceManager.isMonoDownmixEnabled("stereo"));
+    EXPECT_FALSE(m_resourceManager.isMonoDownmixEnabled("sounds"));
+
+    ASSERT_TRUE(m_resourceManager.preloadDirectory("stereo"));
+    auto buffer = m_resourceManager.getBuffer("sfx/wide.wav");
+    ASSERT_TRUE(buffer.has_value());
+    EXPECT_EQ(buffer->get().getFormat(), AL_FORMAT_MONO16);
+    EXPECT_EQ(buffer->get().getSize(), 88200); // half of the stereo data
+    EXPECT_NEAR(buffer->get().getDuration(), 1.0f, 0.01f);
+    m_resourceManager.releaseBuffer(buffer.value());
+    EXPECT_TRUE(m_resourceManager.unloadDirectory("stereo"));
+
+    // The more specific override keeps the file stereo
+    EXPECT_TRUE(m_resourceManager.setMonoDownmix("stereo/sfx", false));
+    ASSERT_TRUE(m_resourceManager.preloadDirectory("stereo"));
+    buffer = m_resourceManager.getBuffer("sfx/wide.wav");
+    ASSERT_TRUE(buffer.has_value());
+    EXPECT_EQ(buffer->get().getFormat(), AL_FORMAT_STEREO16);
+    m_resourceManager.releaseBuffer(buffer.value());
+
+    EXPECT_TRUE(m_resourceManager.clearMonoDownmix("stereo/sfx"));
+    EXPECT_FALSE(m_resourceManager.clearMonoDownmix("stereo/sfx"));
+}
+
+TEST_F(ResourceManagerTests, ResampleOnLoad)
+{
+    EXPECT_FALSE(m_resourceManager.isResampleOnLoadEnabled());
+    ALCint deviceFrequency = m_resourceManager.getDeviceFrequency();
+    ASSERT_GT(deviceFrequency, 0);
+
+    m_resourceManager.setResampleOnLoad(true);
+    EXPECT_TRUE(m_resourceManager.isResampleOnLoadEnabled());
+    ASSERT_TRUE(m_resourceManager.preloadDirectory("sounds"));
+
+    auto buffer = m_resourceManager.getBuffer("test1.wav");
+    ASSERT_TRUE(buffer.has_value());
+    EXPECT_EQ(buffer->get().getSampleRate(), deviceFrequency);
+    EXPECT_NEAR(buffer->get().getDuration(), 1.0f, 0.01f);
+    m_resourceManager.releaseBuffer(buffer.value());
+}
+
+TEST_F(ResourceManagerTests, BufferCompression)
+{
+    EXPECT_EQ(m_resourceManager.getBufferCompression(), BufferCompression::None);
+    EXPECT_FALSE(m_resourceManager.setBufferCompression("", BufferCompression::Ima4));
+    EXPECT_TRUE(m_resourceManager.setBufferCompression("sounds", BufferCompression::Ima4));
+    EXPECT_EQ(m_resourceManager.getBufferCompression("sounds"), BufferCompression::Ima4);
+    EXPECT_EQ(m_resourceManager.getBufferCompression("music"), BufferCompression::None);
+
+    ASSERT_TRUE(m_resourceManager.preloadDirectory("sounds"));
+    ASSERT_TRUE(m_resourceManager.preloadDirectory("music"));
+    auto compressed = m_resourceManager.getBuffer("test1.wav");
+    auto pcm = m_resourceManager.getBuffer("music1.wav");
+    ASSERT_TRUE(compressed.has_value());
+    ASSERT_TRUE(pcm.has_value());
+    EXPECT_NEAR(compressed->get().getDuration(), 1.0f, 0.01f);
+
+    // Devices without AL_EXT_IMA4 keep PCM
+    if (alIsExtensionPresent("AL_EXT_IMA4") == AL_TRUE)
+    {
+        EXPECT_EQ(compressed->get().getFormat(), AL_FORMAT_MONO_IMA4);
+        EXPECT_LT(compressed->get().getSize() * 3, pcm->get().getSize());
+    }
+    EXPECT_EQ(pcm->get().getFormat(), AL_FORMAT_MONO16);
+
+    m_resourceManager.releaseBuffer(compressed.value());
+    m_resourceManager.releaseBuffer(pcm.value());
+    EXPECT_TRUE(m_resourceManager.clearBufferCompression("sounds"));
+    EXPECT_FALSE(m_resourceManager.clearBufferCompression("sounds"));
+}
+
+TEST_F(ResourceManagerTests, CompressedCache)
+{
+    EXPECT_FALSE(m_resourceManager.isCompressedCachingEnabled());
+    EXPECT_FALSE(m_resourceManager.setCompressedCaching("", true));
+    EXPECT_TRUE(m_resourceManager.setCompressedCaching("sounds", true));
+    EXPECT_TRUE(m_resourceManager.isCompressedCachingEnabled("sounds"));
+    EXPECT_FALSE(m_resourceManager.isCompressedCachingEnabled("music"));
+
+    // WAV files are never kept compressed, they load as regular buffers
+    ASSERT_TRUE(m_resourceManager.preloadDirectory("sounds"));
+    EXPECT_EQ(m_resourceManager.getCompressedCacheSizeBytes(), 0u);
+    EXPECT_EQ(m_resourceManager.getDecodedCacheSizeBytes(), 0u);
+    auto buffer = m_resourceManager.getBuffer("test1.wav");
+    ASSERT_TRUE(buffer.has_value());
+    EXPECT_TRUE(buffer->get().isLoaded());
+    m_resourceManager.releaseBuffer(buffer.value());
+
+    m_resourceManager.setCompressedCacheLimits(0, 0);
+    EXPECT_EQ(m_resourceManager.getCachedBufferCount(), 2);
+    EXPECT_TRUE(m_resourceManager.clearCompressedCaching("sounds"));
+    EXPECT_FALSE(m_resourceManager.clearCompressedCaching("sounds"));
+}
+
+TEST_F(ResourceManagerTests, PackedSoundBank)
+{
+    std::filesystem::path bankFile = TestAudioFiles::s_testRootDir / "packed.scbank";
+    ASSERT_TRUE(SoundBank::pack(TestAudioFiles::s_testSubDir1.string(), bankFile.string()));
+
+    SoundBank bank;
+    ASSERT_TRUE(bank.open(bankFile.string()));
+    EXPECT_EQ(bank.getEntryCount(), 2u); // readme.txt is skipped
+    size_t index = 0;
+    ASSERT_TRUE(bank.find("test1.wav", index));
+    EXPECT_EQ(bank.getName(index), "test1.wav");
+    EXPECT_EQ(bank.getOpenALFormat(index), AL_FORMAT_MONO16);
+    EXPECT_FALSE(bank.find("missing.wav", index));
+    bank.close();
+
+    // There is no "packed" directory, only the bank next to where it would be
+    EXPECT_TRUE(m_resourceManager.preloadDirectory("packed"));
+    EXPECT_TRUE(m_resourceManager.isDirectoryLoaded("packed"));
+    EXPECT_EQ(m_resourceManager.getCachedBufferCount(), 2);
+
+    auto buffer = m_resourceManager.getBuffer("test2.wav");
+    ASSERT_TRUE(buffer.has_value());
+    EXPECT_TRUE(buffer->get().isLoaded());
+    EXPECT_NEAR(buffer->get().getDuration(), 1.0f, 0.01f);
+    m_resourceManager.releaseBuffer(buffer.value());
+
+    EXPECT_TRUE(m_resourceManager.unloadDirectory("packed"));
+    EXPECT_EQ(m_resourceManager.getCachedBufferCount(), 0);
+    EXPECT_FALSE(m_resourceManager.getBuffer("test2.wav").has_value());
+
+    PreloadTicket ticket = m_resourceManager.preloadDirectoryAsync("packed");
+    EXPECT_TRUE(ticket.succeeded());
+    EXPECT_EQ(ticket.getFilesDone(), 2u);
+    EXPECT_TRUE(m_resourceManager.unloadDirectory("packed"));
+
+    std::filesystem::remove(bankFile);
+}
+
 TEST_F(ResourceManagerTests, CacheLimits)
 {
     m_resourceManager.shutdown();
@@ -370,6 +687,70 @@ TEST_F(ResourceManagerTests, CacheLimits)
     EXPECT_LE(m_resourceManager.getCacheSizeBytes(), 1 * 1024 * 1024);
 }
 
+TEST_F(ResourceManagerTests, EvictionOrder)
+{
+    m_resourceManager.shutdown();
+    m_resourceManager.initialize(TestAudioFiles::s_testRootDir.string(), 4, 1);
+
+    // 16 files of ~88KB do not fit in a 1MB cache
+    std::filesystem::path manyDir = TestAudioFiles::s_testRootDir / "many";
+    std::filesystem::create_directories(manyDir);
+    for (int i = 0; i < 16; ++i)
+        std::filesystem::copy_file(TestAudioFiles::s_testSubDir1 / "test1.wav", manyDir / ("copy" + std::to_string(i) + ".wav"));
+    ASSERT_TRUE(m_resourceManager.preloadDirectory("many"));
+    EXPECT_LE(m_resourceManager.getCacheSizeBytes(), 1 * 1024 * 1024);
+
+    // Referenced buffers go after every unreferenced one, whatever their age
+    auto critical = m_resourceManager.getBuffer("copy0.wav", SoundPriority::Critical);
+    auto low = m_resourceManager.getBuffer("copy1.wav", SoundPriority::Low);
+    ASSERT_TRUE(critical.has_value());
+    ASSERT_TRUE(low.has_value());
+    for (int round = 0; round < 2; ++round)
+    {
+        for (int i = 2; i < 16; ++i)
+        {
+            std::string file = "copy" + std::to_string(i) + ".wav";
+            auto buffer = m_resourceManager.getBuffer(file);
+            ASSERT_TRUE(buffer.has_value());
+            m_resourceManager.releaseBuffer(file);
+        }
+    }
+
+    EXPECT_LE(m_resourceManager.getCacheSizeBytes(), 1 * 1024 * 1024);
+    EXPECT_TRUE(critical->get().isLoaded());
+    EXPECT_TRUE(low->get().isLoaded());
+    EXPECT_TRUE(m_resourceManager.releaseBuffer("copy0.wav", SoundPriority::Critical));
+    EXPECT_TRUE(m_resourceManager.releaseBuffer("copy1.wav", SoundPriority::Low));
+    EXPECT_GT(m_resourceManager.cleanupUnusedBuffers(), 0u);
+    EXPECT_EQ(m_resourceManager.getCachedBufferCount(), 0);
+}
+
+TEST_F(ResourceManagerTests, SourceAttachmentTracking)
+{
+    ASSERT_TRUE(m_resourceManager.preloadDirectory("sounds"));
+    auto buffer = m_resourceManager.getBuffer("test1.wav");
+    ASSERT_TRUE(buffer.has_value());
+
+    size_t firstIndex, secondIndex, otherIndex;
+    auto first = m_resourceManager.acquireSource(firstIndex, SoundPriority::Medium);
+    auto second = m_resourceManager.acquireSource(secondIndex, SoundPriority::Medium);
+    auto other = m_resourceManager.acquireSource(otherIndex, SoundPriority::Medium);
+    ASSERT_TRUE(first.has_value() && second.has_value() && other.has_value());
+    EXPECT_NO_THROW(m_resourceManager.attachBuffer(firstIndex, buffer.value()));
+    EXPECT_NO_THROW(m_resourceManager.attachBuffer(secondIndex, buffer.value()));
+    EXPECT_EQ(m_resourceManager.getActiveSourceCount(), 3);
+
+    // Unloading frees exactly the sources the buffer is attached to
+    EXPECT_TRUE(m_resourceManager.unloadDirectory("sounds"));
+    EXPECT_EQ(m_resourceManager.getActiveSourceCount(), 1);
+    EXPECT_EQ(first->get().getBufferId(), 0u);
+    EXPECT_THROW(m_resourceManager.attachBuffer(firstIndex, buffer.value()), std::runtime_error);
+
+    EXPECT_TRUE(m_resourceManager.releaseSource(other.value()));
+    EXPECT_TRUE(m_resourceManager.releaseSource(first.value()));
+    EXPECT_EQ(m_resourceManager.getActiveSourceCount(), 0);
+}
+
 TEST_F(ResourceManagerTests, ProperShutdown)
 {
     m_resourceManager.preloadDirectory("sounds");
@@ -465,6 +846,131 @@ TEST_F(SoundBufferTests, InvalidFileHandling)
     EXPECT_FALSE(buffer.isLoaded());
 }
 
+TEST_F(SoundBufferTests, StreamingBuffer)
+{
+    std::string filename = (TestAudioFiles::s_testSubDir1 / "test1.wav").string();
+    SoundBuffer buffer(filename, true);
+
+    EXPECT_TRUE(buffer.isLoaded());
+    EXPECT_TRUE(buffer.isStreaming());
+    EXPECT_EQ(buffer.getBufferId(), 0);
+    EXPECT_EQ(buffer.getSize(), 0);
+    EXPECT_GT(buffer.getDuration(), 0.0f);
+
+    buffer.unload();
+    EXPECT_FALSE(buffer.isLoaded());
+    EXPECT_FALSE(buffer.isStreaming());
+}
+
+TEST_F(SoundBufferTests, SoundStreamQueueing)
+{
+    std::string filename = (TestAudioFiles::s_testSubDir1 / "test1.wav").string();
+    SoundStream stream(filename, false, nullptr, 2, 3, 4096);
+    SoundSource source; // Not created yet, like a pool source that never played
+
+    EXPECT_TRUE(stream.start(source));
+    EXPECT_GT(source.getBuffersQueued(), 0);
+    EXPECT_LE(source.getBuffersQueued(), 3);
+    EXPECT_FALSE(stream.isLooping());
+
+    source.stop();
+    stream.refill(source);
+    source.detachBuffer();
+}
+
+TEST_F(SoundBufferTests, SoundStreamBackgroundDecode)
+{
+    std::string filename = (TestAudioFiles::s_testSubDir1 / "test1.wav").string();
+    StreamWorker worker;
+    worker.start();
+    EXPECT_TRUE(worker.isRunning());
+
+    {
+        SoundStream stream(filename, true, &worker, 3, 2, 4096);
+        SoundSource source;
+        source.create();
+
+        EXPECT_EQ(stream.getReadAhead(), 4); // rounded up to a power of two
+        EXPECT_TRUE(stream.start(source));
+        EXPECT_EQ(source.getBuffersQueued(), 2);
+        EXPECT_EQ(worker.getDecoderCount(), 1);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        source.detachBuffer();
+    }
+
+    worker.stop();
+    EXPECT_FALSE(worker.isRunning());
+    EXPECT_EQ(worker.getDecoderCount(), 0);
+}
+
+TEST_F(SoundBufferTests, MemoryDecodeAndFormatSniffing)
+{
+    std::string filename = (TestAudioFiles::s_testSubDir1 / "test1.wav").string();
+    MappedFile file(filename);
+    ASSERT_TRUE(file.isOpen());
+    EXPECT_GT(file.size(), 44);
+
+    EXPECT_EQ(AudioData::detectFormat(file.data(), file.size()), AudioFormat::Wav);
+    EXPECT_EQ(AudioData::detectFormat(filename), AudioFormat::Wav);
+    EXPECT_EQ(AudioData::detectFormat("OggS\0\x02", 6), AudioFormat::Ogg);
+    EXPECT_EQ(AudioData::detectFormat("ID3\x04", 4), AudioFormat::Mp3);
+    EXPECT_EQ(AudioData::detectFormat("\xFF\xFB\x90\x00", 4), AudioFormat::Mp3);
+    EXPECT_EQ(AudioData::detectFormat("text", 4), AudioFormat::Unsupported);
+    EXPECT_EQ(AudioData::detectFormat((TestAudioFiles::s_testSubDir1 / "readme.txt").string()), AudioFormat::Unsupported);
+
+    AudioData data = AudioData::loadFromMemory(file.data(), file.size(), filename);
+    EXPECT_TRUE(data.isValid());
+    EXPECT_EQ(data.getOpenALFormat(), AL_FORMAT_MONO16);
+    EXPECT_EQ(data.getSourceFormat(), AudioFormat::Wav);
+    EXPECT_EQ(data.getSampleRate(), 44100);
+
+    SoundBuffer buffer(std::move(data), filename);
+    EXPECT_TRUE(buffer.isLoaded());
+    EXPECT_NE(buffer.getBufferId(), 0);
+
+    // A stream opened from the mapping decodes from it and keeps it alive after a move
+    AudioStream probe;
+    probe.open(file.data(), file.size(), filename);
+    EXPECT_FLOAT_EQ(probe.getDuration(), 1.0f);
+
+    AudioStream stream;
+    stream.open(std::move(file));
+    EXPECT_FALSE(file.isOpen());
+    AudioStream moved = std::move(stream);
+    std::vector<int16_t> frames(1024);
+    EXPECT_EQ(moved.readFrames(frames.data(), frames.size()), frames.size());
+    EXPECT_EQ(moved.getFileName(), filename);
+    EXPECT_THROW(probe.open("text", 4, "text"), std::runtime_error);
+}
+
+TEST_F(SoundBufferTests, MappedPcm16Wav)
+{
+    std::string filename = (TestAudioFiles::s_testSubDir1 / "test1.wav").string();
+    AudioData decoded;
+    {
+        MappedFile file(filename);
+        ASSERT_TRUE(file.isOpen());
+        decoded = AudioData::loadFromMemory(file.data(), file.size(), filename);
+    }
+
+    AudioData mapped = AudioData::loadFromFile(filename);
+    EXPECT_TRUE(mapped.isValid());
+    EXPECT_TRUE(mapped.isMapped());
+    EXPECT_FALSE(decoded.isMapped());
+    EXPECT_EQ(mapped.getOpenALFormat(), AL_FORMAT_MONO16);
+    ASSERT_EQ(mapped.getPcmDataSize(), decoded.getPcmDataSize());
+    EXPECT_EQ(std::memcmp(mapped.getPcmData(), decoded.getPcmData(), mapped.getPcmDataSize()), 0);
+
+    AudioData moved = std::move(mapped);
+    EXPECT_TRUE(moved.isMapped());
+    EXPECT_FALSE(mapped.isValid());
+
+    SoundBuffer buffer(std::move(moved), filename);
+    EXPECT_TRUE(buffer.isLoaded());
+    EXPECT_FLOAT_EQ(buffer.getDuration(), 1.0f);
+}
+
 class SoundSourceTests : public ::testing::Test
 {
 private:
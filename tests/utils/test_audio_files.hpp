@@ -17,6 +17,7 @@ public:
     inline static std::filesystem::path s_testSubDir2;
     inline static std::filesystem::path s_generalDir;
     inline static std::filesystem::path s_scene1Dir;
+    inline static std::filesystem::path s_stereoDir;
     inline static bool s_filesCreated = false;
 
     static void createTestFiles()
@@ -36,6 +37,7 @@ public:
         
         std::filesystem::path generalMusicDir = s_testRootDir / "general" / "music";
         std::filesystem::path scene1MusicDir = s_testRootDir / "scene1" / "music";
+        s_stereoDir = s_testRootDir / "stereo" / "sfx";
 
         std::filesystem::create_directories(s_testSubDir1);
         std::filesystem::create_directories(s_testSubDir2);
@@ -43,6 +45,7 @@ public:
         std::filesystem::create_directories(s_scene1Dir);
         std::filesystem::create_directories(generalMusicDir);
         std::filesystem::create_directories(scene1MusicDir);
+        std::filesystem::create_directories(s_stereoDir);
 
         // Files for resources_tests.cpp
         createWavFile(s_testSubDir1 / "test1.wav");
@@ -57,6 +60,9 @@ public:
         createWavFile(generalMusicDir / "background.wav");
         createWavFile(scene1MusicDir / "battle.wav");
 
+        // Stereo file for downmix tests
+        createWavFile(s_stereoDir / "wide.wav", 2);
+
         s_filesCreated = true;
     }
 
@@ -69,14 +75,22 @@ public:
         s_filesCreated = false;
     }
 
+    // ~2.1MB, over the size from which files are streamed instead of decoded into one buffer
+    static void createStreamedWavFile(const std::filesystem::path& filePath)
+    {
+        std::filesystem::create_directories(filePath.parent_path());
+        createWavFile(filePath, 1, 24);
+    }
+
 private:
-    static void createWavFile(const std::filesystem::path& filePath)
+    static void createWavFile(const std::filesystem::path& filePath, uint16_t numChannels = 1, uint32_t seconds = 1)
     {
         std::ofstream file(filePath, std::ios::binary);
+        uint32_t dataSize = 88200 * numChannels * seconds; // 44100 Hz, 16-bit
         
         // WAV header (44 bytes)
         file.write("RIFF", 4);
-        uint32_t fileSize = 36 + 88200; // Header + data
+        uint32_t fileSize = 36 + dataSize; // Header + data
         file.write(reinterpret_cast<const char*>(&fileSize), 4);
         file.write("WAVE", 4);
         
@@ -86,7 +100,6 @@ private:
         file.write(reinterpret_cast<const char*>(&fmtSize), 4);
         uint16_t audioFormat = 1; // PCM
         file.write(reinterpret_cast<const char*>(&audioFormat), 2);
-        uint16_t numChannels = 1;
         file.write(reinterpret_cast<const char*>(&numChannels), 2);
         uint32_t sampleRate = 44100;
         file.write(reinterpret_cast<const char*>(&sampleRate), 4);
@@ -99,7 +112,6 @@ private:
         
         // Data chunk
         file.write("data", 4);
-        uint32_t dataSize = 88200; // ~1 second at 44100 Hz, 16-bit, mono
         file.write(reinterpret_cast<const char*>(&dataSize), 4);
         
         // Simple sine wave data
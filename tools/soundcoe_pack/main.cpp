@@ -0,0 +1,77 @@
+#include <soundcoe/resources/sound_bank.hpp>
+#include <logcoe.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+int printUsage()
+{
+    std::cout << "Usage: soundcoe_pack <directory> <output.scbank> [options]" << std::endl;
+    std::cout << "Packs every audio file under <directory> into one sound bank." << std::endl;
+    std::cout << "Name the bank after the directory and place it next to it (sfx/ -> sfx.scbank)" << std::endl;
+    std::cout << "so preloadDirectory(\"sfx\") loads the bank instead of the loose files." << std::endl;
+    std::cout << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "  --help           Display this help message" << std::endl;
+    std::cout << "  --mono           Downmix stereo files to mono" << std::endl;
+    std::cout << "  --rate=HZ        Resample every file to HZ (usually the target device mixing rate)" << std::endl;
+    std::cout << "  --ima4           Store IMA4 ADPCM blocks (AL_EXT_IMA4), about 4x smaller" << std::endl;
+    std::cout << "  --msadpcm        Store MS-ADPCM blocks (AL_SOFT_MSADPCM), about 4x smaller" << std::endl;
+    std::cout << "  --verbose        Log every packed file" << std::endl;
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    std::string directory;
+    std::string bankFile;
+    soundcoe::detail::DecodeOptions options;
+    logcoe::LogLevel level = logcoe::LogLevel::WARNING;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+
+        if (arg == "--help")
+            return printUsage();
+        else if (arg == "--mono")
+            options.downmixToMono = true;
+        else if (arg.substr(0, 7) == "--rate=")
+            options.targetSampleRate = static_cast<ALsizei>(std::atoi(arg.substr(7).c_str()));
+        else if (arg == "--ima4")
+            options.compression = soundcoe::BufferCompression::Ima4;
+        else if (arg == "--msadpcm")
+            options.compression = soundcoe::BufferCompression::MsAdpcm;
+        else if (arg == "--verbose")
+            level = logcoe::LogLevel::INFO;
+        else if (directory.empty())
+            directory = arg;
+        else if (bankFile.empty())
+            bankFile = arg;
+        else
+        {
+            std::cerr << "soundcoe_pack: Unexpected argument \"" << arg << "\"" << std::endl;
+            return 1;
+        }
+    }
+
+    if (directory.empty() || bankFile.empty() || options.targetSampleRate < 0)
+    {
+        printUsage();
+        return 1;
+    }
+
+    logcoe::initialize(level, "soundcoe_pack");
+    bool packed = soundcoe::detail::SoundBank::pack(directory, bankFile, options);
+    logcoe::shutdown();
+
+    if (!packed)
+    {
+        std::cerr << "soundcoe_pack: Failed to pack \"" << directory << "\"" << std::endl;
+        return 1;
+    }
+
+    std::cout << "soundcoe_pack: Wrote \"" << bankFile << "\"" << std::endl;
+    return 0;
+}
\ No newline at end of file